@@ -0,0 +1,50 @@
+#!/bin/bash
+set -e
+set -o pipefail
+thisfolder=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd ) # https://stackoverflow.com/questions/59895/how-do-i-get-the-directory-where-a-bash-script-is-located-from-within-the-script
+cd $thisfolder
+
+# executable's absolute paths/commands (make sure they work!)
+efglocate=$thisfolder/../../tools/efg-locate/efg-locate
+seqtk=$thisfolder/../../tools/seqtk/seqtk
+usrbintime=/usr/bin/time
+
+# params
+inputgraph=$thisfolder/input/chr22_iEFG.gfa
+inputreads=$thisfolder/input/ERR1025645_sample05_1.fq.gz
+threadnums="32 64 128"
+
+# 0. setup
+mkdir output-numa
+echo -n > output-numa/runnuma_log.txt
+$seqtk seq -A $inputreads > output-numa/reads.fasta
+
+# 1. match with the unpinned layout, with pinned threads, and with per-node index replicas
+for threads in $threadnums
+do
+	for layout in unpinned numa-pin numa-replicate
+	do
+		layoutflag=""
+		if [[ "$layout" != "unpinned" ]] ; then
+			layoutflag="--$layout"
+		fi
+		echo "# $threads threads, $layout" >> output-numa/runnuma_log.txt
+		$usrbintime --format "%e %M" --output output-numa/time_${threads}_${layout}.txt $efglocate \
+			--reverse-complement \
+			--threads $threads \
+			$layoutflag \
+			$inputgraph \
+			output-numa/reads.fasta \
+			output-numa/matches_${threads}_${layout}.gaf \
+			>> output-numa/runnuma_log.txt 2>> output-numa/runnuma_log.txt
+		rm output-numa/matches_${threads}_${layout}.gaf
+	done
+done
+
+# 2. report
+echo "# scaling report (wall-clock seconds, max RSS KB)" >> output-numa/runnuma_log.txt
+echo -e "threads\tunpinned\tnuma-pin\tnuma-replicate" >> output-numa/runnuma_log.txt
+for threads in $threadnums
+do
+	echo -e "$threads\t$(cat output-numa/time_${threads}_unpinned.txt)\t$(cat output-numa/time_${threads}_numa-pin.txt)\t$(cat output-numa/time_${threads}_numa-replicate.txt)" >> output-numa/runnuma_log.txt
+done
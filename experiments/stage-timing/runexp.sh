@@ -0,0 +1,170 @@
+#!/bin/bash
+set -e
+set -o pipefail
+thisfolder=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd ) # https://stackoverflow.com/questions/59895/how-do-i-get-the-directory-where-a-bash-script-is-located-from-within-the-script
+cd $thisfolder
+
+# executable's absolute paths/commands (make sure they work!)
+efglocate=$thisfolder/../../tools/efg-locate/efg-locate
+chainxblockgraph=$thisfolder/../../tools/ChainX-block-graph/chainx-block-graph
+graphaligner=$thisfolder/../../tools/GraphAligner/bin/GraphAligner # optional, stage skipped if missing
+efggenerate=$thisfolder/../../tools/efg-generate/efg-generate
+usrbintime=/usr/bin/time
+
+# params
+inputgraph=$thisfolder/input/graph.gfa # generated with efg-generate if missing
+inputreads=$thisfolder/input/reads.fastq
+threadnums="4 8 16 32"
+locatesplits="25 50 75" # % of the threads given to efg-locate in the piped runs (SRFChainer uses 50)
+
+# same options as SRFChainer
+locateoptions="--approximate --split-output-matches --reverse-complement --rename-reverse-complement --overwrite --approximate-edge-match-min-count 0 --approximate-edge-match-longest 0"
+chainoptions="--semi-global --split-output-matches-graphaligner --overwrite --initial-guess-coverage=0.5 --ramp-up-factor=1.5 --alternative-chains 0"
+extendoptions="--max-cluster-extend 5 -b 10"
+
+# 0. setup
+mkdir output
+echo -n > output/runexp_log.txt
+if [[ ! -f $inputgraph ]] ; then
+	$efggenerate --blocks 40000 --reads 4000 --read-type long $inputgraph $inputreads output/truth.gaf \
+		2>> output/runexp_log.txt
+fi
+awk 'NR % 4 == 1 || NR % 4 == 2' $inputreads | sed 's/^@/>/g' | cut -d' ' -f1 > output/reads.fasta
+readnum=$(grep -c '^>' output/reads.fasta)
+basenum=$(grep -v '^>' output/reads.fasta | tr -d '\n' | wc -c)
+runaligner=false
+if [[ -x $graphaligner ]] ; then
+	runaligner=true
+fi
+
+timeformat="%e %U %S %M" # wall s, user s, system s, max RSS KB
+echo -e "stage\tmode\tthreads\twall_s\tcpu_s\tcpu_util\tmax_rss_mb\treads_per_s\tmbases_per_s" > output/summary.tsv
+
+# record stage mode threads timefile [wall]: append a row to the summary,
+# the optional wall time replaces the one of the time file
+record()
+{
+	tail -n 1 $4 | awk -v stage=$1 -v mode=$2 -v threads=$3 -v wall=$5 -v reads=$readnum -v bases=$basenum \
+		'BEGIN {OFS = "\t"} {
+			if (wall == "") wall = $1
+			cpu = $2 + $3
+			if (wall <= 0) wall = 0.01
+			printf "%s\t%s\t%d\t%.2f\t%.2f\t%.2f\t%.1f\t%.1f\t%.3f\n", stage, mode, threads, wall, cpu, cpu / wall, $4 / 1024, reads / wall, bases / wall / 1e6
+		}' >> output/summary.tsv
+}
+
+# 1. each stage in isolation, with completion-order and ordered output
+for threads in $threadnums
+do
+	for order in unordered ordered
+	do
+		orderflag=""
+		if [[ "$order" == "ordered" ]] ; then
+			orderflag="--ordered-output"
+		fi
+		echo "# isolated, $threads threads, $order" >> output/runexp_log.txt
+		$usrbintime --format "$timeformat" --output output/time_locate.txt $efglocate $locateoptions $orderflag \
+			--threads $threads \
+			$inputgraph \
+			output/reads.fasta \
+			output/seeds.gaf \
+			>> output/runexp_log.txt 2>> output/runexp_log.txt
+		record efg-locate isolated-$order $threads output/time_locate.txt
+
+		$usrbintime --format "$timeformat" --output output/time_chain.txt $chainxblockgraph $chainoptions $orderflag \
+			--threads $threads \
+			$inputgraph \
+			output/seeds.gaf \
+			output/chains.gaf \
+			>> output/runexp_log.txt 2>> output/runexp_log.txt
+		record chainx-block-graph isolated-$order $threads output/time_chain.txt
+
+		if [[ "$runaligner" = true ]] && [[ "$order" == "unordered" ]] ; then
+			$usrbintime --format "$timeformat" --output output/time_extend.txt $graphaligner $extendoptions \
+				-t $threads \
+				-g $inputgraph \
+				-f $inputreads \
+				--realign output/chains.gaf \
+				-a output/alignments.gaf \
+				>> output/runexp_log.txt 2>> output/runexp_log.txt
+			record GraphAligner isolated $threads output/time_extend.txt
+			rm output/alignments.gaf
+		fi
+		rm output/seeds.gaf output/chains.gaf
+	done
+done
+
+# 2. the SRFChainer pipe, splitting the threads between efg-locate and chainx-block-graph
+for threads in $threadnums
+do
+	for split in $locatesplits
+	do
+		locatethreads=$(( $threads * $split / 100 ))
+		locatethreads=$(( $locatethreads < 1 ? 1 : $locatethreads ))
+		chainthreads=$(( $threads - $locatethreads < 1 ? 1 : $threads - $locatethreads ))
+		echo "# piped, $threads threads, $locatethreads for locate, $chainthreads for chaining" >> output/runexp_log.txt
+		start=$(date +%s.%N)
+		if [[ "$runaligner" = true ]] ; then
+			$usrbintime --format "$timeformat" --output output/time_locate.txt $efglocate $locateoptions \
+				--threads $locatethreads \
+				$inputgraph \
+				output/reads.fasta \
+				/dev/stdout 2>> output/runexp_log.txt | \
+			$usrbintime --format "$timeformat" --output output/time_chain.txt $chainxblockgraph $chainoptions \
+				--threads $chainthreads \
+				$inputgraph \
+				/dev/stdin \
+				/dev/stdout 2>> output/runexp_log.txt | \
+			$usrbintime --format "$timeformat" --output output/time_extend.txt $graphaligner $extendoptions \
+				-t $threads \
+				-g $inputgraph \
+				-f $inputreads \
+				--realign /dev/stdin \
+				-a output/alignments.gaf \
+				>> output/runexp_log.txt 2>> output/runexp_log.txt
+		else
+			$usrbintime --format "$timeformat" --output output/time_locate.txt $efglocate $locateoptions \
+				--threads $locatethreads \
+				$inputgraph \
+				output/reads.fasta \
+				/dev/stdout 2>> output/runexp_log.txt | \
+			$usrbintime --format "$timeformat" --output output/time_chain.txt $chainxblockgraph $chainoptions \
+				--threads $chainthreads \
+				$inputgraph \
+				/dev/stdin \
+				output/chains.gaf \
+				>> output/runexp_log.txt 2>> output/runexp_log.txt
+		fi
+		end=$(date +%s.%N)
+		record efg-locate piped-$split% $locatethreads output/time_locate.txt
+		record chainx-block-graph piped-$split% $chainthreads output/time_chain.txt
+		stagetimes="output/time_locate.txt output/time_chain.txt"
+		if [[ "$runaligner" = true ]] ; then
+			record GraphAligner piped-$split% $threads output/time_extend.txt
+			stagetimes="$stagetimes output/time_extend.txt"
+		fi
+		# whole pipe: CPU time and RSS of the stages summed, as they run concurrently
+		for f in $stagetimes ; do tail -n 1 $f ; done | \
+			awk '{u += $2; s += $3; m += $4} END {print 0, u, s, m}' > output/time_pipe.txt
+		record pipe piped-$split% $threads output/time_pipe.txt $(awk -v s=$start -v e=$end 'BEGIN {print e - s}')
+		rm -f output/chains.gaf output/alignments.gaf
+	done
+done
+
+# 3. report
+awk -F'\t' '{printf "%-20s %-20s %8s %10s %10s %9s %11s %12s %13s\n", $1, $2, $3, $4, $5, $6, $7, $8, $9}' output/summary.tsv > output/summary.txt
+echo "# ordered output cost (wall time of --ordered-output over completion order)" >> output/summary.txt
+awk -F'\t' 'NR > 1 && $2 ~ /^isolated-/ {
+		split($2, m, "-")
+		wall[$1 "\t" $3 "\t" m[2]] = $4
+		if (m[2] == "unordered") keys[++n] = $1 "\t" $3
+	}
+	END {
+		printf "%-20s %8s %12s %12s %10s\n", "stage", "threads", "unordered_s", "ordered_s", "overhead"
+		for (i = 1; i <= n; i++) {
+			split(keys[i], k, "\t")
+			u = wall[keys[i] "\tunordered"]; o = wall[keys[i] "\tordered"]
+			printf "%-20s %8d %12.2f %12.2f %+9.1f%%\n", k[1], k[2], u, o, (u > 0) ? (o / u - 1) * 100 : 0
+		}
+	}' output/summary.tsv >> output/summary.txt
+cat output/summary.txt >> output/runexp_log.txt
@@ -0,0 +1,151 @@
+#ifndef ANCHOR_ARRAYS_HPP
+#define ANCHOR_ARRAYS_HPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "efg.hpp"
+
+/*
+ * anchors of a read as plain integer arrays, for the inner loop of the
+ * chaining DP. A pair of anchors where the first ends in a block before the
+ * one where the second starts costs
+ *   costs[i] + max(edsstart[j] - edsend[i], max(0, qstart[j] - qend[i]))
+ *            + max(0, qend[i] - qstart[j])
+ * if colinear (see eds_start and eds_end), which far_costs computes without
+ * branches over a window of predecessors, so that the compiler vectorises it
+ * (-march=native). The other pairs, on the same or overlapping nodes, are
+ * computed with are_colinear_eds, max_gap_eds and overlap_eds. The window
+ * of costs is given by the caller, one per thread (window is that of the
+ * calling thread). With --chain-on-graph the gaps are not those of the EDS,
+ * so no pair is far and all of them are computed with max_gap_eds.
+ */
+namespace chainx_block_graph {
+
+// anchors per bucket of predecessors with a common lower bound, see bucket_lower_bound
+const int PRUNE_BUCKET = 128;
+
+struct AnchorArrays {
+	vector<int> qstart, qend;
+	vector<int> firstblock, lastblock;
+	vector<int> edsstart, edsend;
+	vector<int> window; // costs of a window of predecessors, see far_costs
+	vector<long> bucketbound; // see bucket_lower_bound
+	bool ongraph; // graph.on_graph(), no far pairs
+
+	AnchorArrays(vector<GAFHit> &anchors, const Elasticfoundergraph &graph)
+	{
+		const int n = anchors.size();
+		qstart.resize(n);
+		qend.resize(n);
+		firstblock.resize(n);
+		lastblock.resize(n);
+		edsstart.resize(n);
+		edsend.resize(n);
+		window.resize(n);
+		bucketbound.assign((n + PRUNE_BUCKET - 1) / PRUNE_BUCKET, std::numeric_limits<long>::max());
+		ongraph = graph.on_graph();
+		for (int i = 0; i < n; i++) {
+			qstart[i] = anchors[i].get_query_start();
+			qend[i] = anchors[i].get_query_end();
+			firstblock[i] = graph.get_block(anchors[i].get_first_node());
+			lastblock[i] = graph.get_block(anchors[i].get_last_node());
+			edsstart[i] = eds_start(anchors[i], graph);
+			edsend[i] = eds_end(anchors[i], graph);
+		}
+	}
+
+	bool is_far(const int i, const int j) const
+	{
+		return !ongraph and lastblock[i] < firstblock[j];
+	}
+
+	/*
+	 * cost of chaining far anchor i before anchor j, INT_MAX if unreachable
+	 * or not colinear; with lastdummy, the gap in the query is free as for the
+	 * last dummy anchor in semiglobal mode
+	 */
+	int far_cost(const vector<int> &costs, const int i, const int j, const bool lastdummy) const
+	{
+		const int qgap = qstart[j] - qend[i];
+		const int g = (lastdummy) ? qgap : std::max(edsstart[j] - edsend[i], std::max(0, qgap));
+		const int o = std::max(0, -qgap);
+		const bool colinear = qstart[i] < qstart[j] and qend[i] < qend[j] and costs[i] != std::numeric_limits<int>::max();
+		return (colinear) ? costs[i] + g + o : std::numeric_limits<int>::max();
+	}
+
+	/*
+	 * lower bound on the cost of chaining anchor i before anchor j: the gap
+	 * is at least the one in the query and the overlap cost is non-negative
+	 */
+	long lower_bound_cost(const vector<int> &costs, const int i, const int j) const
+	{
+		return (long)costs[i] + std::max(0, qstart[j] - qend[i]);
+	}
+
+	/*
+	 * lower bound on the costs of chaining the anchors of a bucket (anchors
+	 * [bucket * PRUNE_BUCKET..(bucket + 1) * PRUNE_BUCKET)) before anchor j,
+	 * from the minimum of costs[i] - qend[i] over the bucket. The costs only
+	 * decrease from one pass of the DP to the next, so update_bound keeps it
+	 * a lower bound as the costs are set
+	 */
+	long bucket_lower_bound(const int bucket, const int j) const
+	{
+		return (bucketbound[bucket] == std::numeric_limits<long>::max()) ? bucketbound[bucket] : bucketbound[bucket] + qstart[j];
+	}
+
+	void update_bound(const vector<int> &costs, const int i)
+	{
+		if (costs[i] != std::numeric_limits<int>::max())
+			bucketbound[i / PRUNE_BUCKET] = std::min(bucketbound[i / PRUNE_BUCKET], (long)costs[i] - qend[i]);
+	}
+
+	/*
+	 * w[i - from] = far_cost(i, j) for i in [from..to), INT_MAX for the
+	 * anchors that are not far from j; returns whether there are any
+	 */
+	bool far_costs(const vector<int> &costs, const int j, const int from, const int to, const bool lastdummy, int *w) const
+	{
+		const int *qs = qstart.data() + from, *qe = qend.data() + from;
+		const int *lb = lastblock.data() + from, *ee = edsend.data() + from;
+		const int *c = costs.data() + from;
+		const int qsj = qstart[j], qej = qend[j], fbj = firstblock[j], esj = edsstart[j];
+		const int infinity = std::numeric_limits<int>::max();
+		if (ongraph) {
+			std::fill(w, w + (to - from), infinity);
+			return true;
+		}
+		int near = 0;
+		if (lastdummy) {
+			for (int k = 0; k < to - from; k++) {
+				const int qgap = qsj - qe[k];
+				const bool ok = qs[k] < qsj and qe[k] < qej and lb[k] < fbj and c[k] != infinity;
+				w[k] = (ok) ? c[k] + qgap + std::max(0, -qgap) : infinity;
+				near |= (lb[k] >= fbj);
+			}
+		} else {
+			for (int k = 0; k < to - from; k++) {
+				const int qgap = qsj - qe[k];
+				const bool ok = qs[k] < qsj and qe[k] < qej and lb[k] < fbj and c[k] != infinity;
+				w[k] = (ok) ? c[k] + std::max(esj - ee[k], std::max(0, qgap)) + std::max(0, -qgap) : infinity;
+				near |= (lb[k] >= fbj);
+			}
+		}
+		return near;
+	}
+
+	// minimum of w[0..size)
+	static int window_min(const int *w, const int size)
+	{
+		int m = std::numeric_limits<int>::max();
+		for (int k = 0; k < size; k++)
+			m = std::min(m, w[k]);
+		return m;
+	}
+};
+
+} // Namespace chainx_block_graph
+
+#endif
@@ -0,0 +1,152 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../chainx-block-graph.hpp"
+#include "../efg.hpp"
+#include "../chaining.hpp"
+#include "../chaining-rmq.hpp"
+#include "../../common/microbench.hpp"
+
+/*
+ * microbenchmarks of the chaining kernels of chainx-block-graph on a fixed
+ * random graph (make bench), see microbench.hpp for the arguments
+ */
+
+using namespace chainx_block_graph;
+using microbench::do_not_optimize;
+
+/*
+ * anchors of a read spelled by a random path: one anchor per node of the
+ * path, and decoys on random nodes of nearby blocks, sorted by query start
+ * and with the dummy anchors at both ends as in chain_worker
+ */
+vector<GAFHit> read_anchors(const microbench::SyntheticEfg &synthetic, const Elasticfoundergraph &graph, std::mt19937 &rng, int startblock, long length)
+{
+	const vector<int> path = synthetic.random_path(rng, startblock, length);
+	const int qlength = synthetic.spell(path).size();
+	vector<GAFHit> anchors;
+	for (int i = 0, qstart = 0; i < path.size(); i++) {
+		const int len = synthetic.labels[path[i]].size();
+		anchors.push_back(GAFHit(qlength, qstart, qstart + len, vector<int>({path[i]}), len, 0, len));
+		if (rng() % 2 == 0) {
+			const int b = std::min<int>(synthetic.blocks.size() - 1, startblock + i + rng() % 3);
+			const int v = synthetic.blocks[b][rng() % synthetic.blocks[b].size()];
+			const int vlen = synthetic.labels[v].size();
+			const int vqstart = std::max(0, std::min(qlength - vlen, qstart + (int)(rng() % 60) - 30));
+			anchors.push_back(GAFHit(qlength, vqstart, vqstart + vlen, vector<int>({v}), vlen, 0, vlen));
+		}
+		qstart += len;
+	}
+	std::sort(anchors.begin(), anchors.end(), [](const GAFHit &a1, const GAFHit &a2)
+			{
+			return (a1.get_query_start() < a2.get_query_start());
+			});
+	anchors.insert(anchors.begin(), dummy_start(anchors.at(0), graph));
+	anchors.push_back(dummy_end(anchors.at(0), graph));
+	return anchors;
+}
+
+int main(int argc, char *argv[])
+{
+	microbench::Args args(argc, argv);
+	microbench::Suite suite(args.filter);
+
+	const microbench::SyntheticEfg synthetic(20000, 4, 12, 40, 42);
+	std::istringstream graphss(synthetic.to_xgfa());
+	Elasticfoundergraph graph(graphss);
+	graph.init_eds_support();
+
+	std::mt19937 rng(7);
+	vector<vector<GAFHit>> reads;
+	for (int i = 0; i < 50; i++)
+		reads.push_back(read_anchors(synthetic, graph, rng, rng() % (synthetic.blocks.size() - 1000), 10000));
+
+	// colinear pairs of nearby anchors, excluding the dummy anchors
+	vector<std::pair<const GAFHit*,const GAFHit*>> pairs;
+	for (const vector<GAFHit> &anchors : reads) {
+		for (int i = 1; i + 1 < anchors.size(); i++) {
+			for (int j = i + 1; j < std::min<int>(i + 8, anchors.size() - 1); j++) {
+				if (are_colinear_eds(anchors[i], anchors[j], graph))
+					pairs.push_back({&anchors[i], &anchors[j]});
+			}
+		}
+	}
+	long nanchors = 0;
+	for (const vector<GAFHit> &anchors : reads)
+		nanchors += anchors.size();
+	std::cout << "graph with " << synthetic.labels.size() << " nodes, " << reads.size() << " reads, ";
+	std::cout << nanchors << " anchors, " << pairs.size() << " colinear pairs" << std::endl << std::endl;
+
+	suite.run("are_colinear_eds", [&]() {
+		for (const auto &p : pairs)
+			do_not_optimize(are_colinear_eds(*p.first, *p.second, graph));
+		return (long)pairs.size();
+	});
+
+	suite.run("max_gap_eds", [&]() {
+		for (const auto &p : pairs)
+			do_not_optimize(max_gap_eds(*p.first, *p.second, graph));
+		return (long)pairs.size();
+	});
+
+	suite.run("overlap_eds", [&]() {
+		for (const auto &p : pairs)
+			do_not_optimize(overlap_eds(*p.first, *p.second, graph));
+		return (long)pairs.size();
+	});
+
+	suite.run("chain_semiglobal_eds (per anchor)", [&]() {
+		Stats stats;
+		for (vector<GAFHit> &anchors : reads)
+			do_not_optimize(chain_semiglobal_eds(anchors, graph, 100, 4.0, stats).size());
+		return nanchors;
+	});
+
+	suite.run("chain_global_eds (per anchor)", [&]() {
+		Stats stats;
+		for (vector<GAFHit> &anchors : reads)
+			do_not_optimize(chain_global_eds(anchors, graph, 100, 4.0, stats).size());
+		return nanchors;
+	});
+
+	suite.run("chain_semiglobal_rmq (per anchor)", [&]() {
+		Stats stats;
+		for (vector<GAFHit> &anchors : reads)
+			do_not_optimize(chain_semiglobal_rmq(anchors, graph, stats).size());
+		return nanchors;
+	});
+
+	suite.run("chain_global_rmq (per anchor)", [&]() {
+		Stats stats;
+		for (vector<GAFHit> &anchors : reads)
+			do_not_optimize(chain_global_rmq(anchors, graph, stats).size());
+		return nanchors;
+	});
+
+	// --alternative-chains 3, chaining again without the used anchors or backtracking from one DP
+	suite.run("chain_global_eds -a 3 (per anchor)", [&]() {
+		Stats stats;
+		for (const vector<GAFHit> &read : reads) {
+			vector<GAFHit> anchors = read;
+			for (int i = 0; i < 3; i++)
+				do_not_optimize(chain_global_eds(anchors, graph, 100, 4.0, stats, true).size());
+			do_not_optimize(chain_global_eds(anchors, graph, 100, 4.0, stats).size());
+		}
+		return nanchors;
+	});
+
+	suite.run("chain_global_eds -a 3 single pass (per anchor)", [&]() {
+		Stats stats;
+		for (const vector<GAFHit> &read : reads) {
+			vector<GAFHit> anchors = read;
+			do_not_optimize(chain_global_eds(anchors, graph, 100, 4.0, stats, false, nullptr, 3).size());
+		}
+		return nanchors;
+	});
+
+	return args.finish(suite);
+}
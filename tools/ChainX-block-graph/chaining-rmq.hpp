@@ -0,0 +1,243 @@
+#ifndef CHAINING_RMQ_HPP
+#define CHAINING_RMQ_HPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "efg.hpp"
+#include "chaining.hpp"
+
+/*
+ * subquadratic chaining engine (--chaining-engine rmq), computing the same
+ * chains as chain_global_eds and chain_semiglobal_eds.
+ *
+ * The costs of the DP are non-negative and a pair of anchors with query gap g
+ * costs at least g, so the ramp-up of the DP ends with the optimal chain over
+ * all the pairs of anchors: this engine computes it in a single pass without
+ * the window of the guess. Breaking ties towards the predecessor of largest
+ * index (and towards the first dummy anchor in semiglobal mode), as the DP
+ * does, also gives the same chains.
+ *
+ * The predecessors i of anchor j are split into:
+ * - far predecessors, ending in a block before the one where j starts and
+ *   ending in the query before j starts: the cost is
+ *   costs[i] + max(eds_start(j) - eds_end(i), qstart(j) - qend(i)), which is
+ *   the first term iff the diagonal eds_end(i) - qend(i) is at most
+ *   eds_start(j) - qstart(j). They are kept in a Fenwick tree over the end
+ *   blocks whose nodes are Fenwick trees over the diagonals, with prefix
+ *   minima of costs[i] - eds_end(i) and suffix minima of costs[i] - qend(i);
+ *   an anchor is inserted when the query start of j passes its end;
+ * - predecessors overlapping j in the query, and predecessors ending in a
+ *   node of the path of j (a colinear predecessor ending in a later block
+ *   would end after j), which are tested with the functions of the DP.
+ * This takes O(n log^2 n) time plus the pairs of the second kind, whose
+ * number is bounded by the coverage depth of the anchors in the query and in
+ * the nodes; these are visited after the far predecessors, and skipped when
+ * costs[i] plus the gap in the query exceeds the best cost so far.
+ */
+namespace chainx_block_graph {
+
+class RmqChainer {
+	private:
+		typedef std::pair<long,int> Candidate; // (cost, -index), so that ties go to the largest index
+		const Candidate none = Candidate(std::numeric_limits<long>::max(), 0);
+
+		vector<int> endblocks; // sorted distinct end blocks of the predecessors
+		vector<int> offset; // of the diagonals of each node of the outer tree
+		vector<long> diagonals; // sorted, by node of the outer tree
+		vector<Candidate> graphmin, querymin; // inner trees, prefix and suffix minima
+
+		vector<int> eds_starts, eds_ends;
+
+		int outer_rank(int block) const
+		{
+			return std::lower_bound(endblocks.begin(), endblocks.end(), block) - endblocks.begin();
+		}
+
+		void build(vector<GAFHit> &anchors, const Elasticfoundergraph &graph)
+		{
+			const int n = anchors.size();
+			eds_starts.assign(n, 0);
+			eds_ends.assign(n - 1, 0);
+			endblocks.clear();
+			for (int i = 0; i < n; i++) {
+				eds_starts[i] = eds_start(anchors[i], graph);
+				if (i < n - 1) {
+					eds_ends[i] = eds_end(anchors[i], graph);
+					endblocks.push_back(graph.get_block(anchors[i].get_last_node()));
+				}
+			}
+			std::sort(endblocks.begin(), endblocks.end());
+			endblocks.erase(std::unique(endblocks.begin(), endblocks.end()), endblocks.end());
+
+			const int m = endblocks.size();
+			offset.assign(m + 2, 0);
+			for (int i = 0; i < n - 1; i++) {
+				for (int k = outer_rank(graph.get_block(anchors[i].get_last_node())) + 1; k <= m; k += k & -k)
+					offset[k + 1]++;
+			}
+			for (int k = 1; k <= m + 1; k++)
+				offset[k] += offset[k - 1];
+			diagonals.assign(offset[m + 1], 0);
+			vector<int> fill(offset.begin(), offset.end() - 1);
+			for (int i = 0; i < n - 1; i++) {
+				for (int k = outer_rank(graph.get_block(anchors[i].get_last_node())) + 1; k <= m; k += k & -k)
+					diagonals[fill[k]++] = diagonal(anchors, i);
+			}
+			for (int k = 1; k <= m; k++)
+				std::sort(diagonals.begin() + offset[k], diagonals.begin() + offset[k + 1]);
+			graphmin.assign(diagonals.size(), none);
+			querymin.assign(diagonals.size(), none);
+		}
+
+		long diagonal(vector<GAFHit> &anchors, int i) const
+		{
+			return (long)eds_ends[i] - anchors[i].get_query_end();
+		}
+
+		// far predecessor i, once the query start of the current anchor is past its end
+		void insert(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const vector<int> &costs, int i)
+		{
+			const Candidate g((long)costs[i] - eds_ends[i], -i);
+			const Candidate q((long)costs[i] - anchors[i].get_query_end(), -i);
+			const long d = diagonal(anchors, i);
+			for (int k = outer_rank(graph.get_block(anchors[i].get_last_node())) + 1; k < offset.size() - 1; k += k & -k) {
+				const int size = offset[k + 1] - offset[k];
+				const int pos = std::lower_bound(diagonals.begin() + offset[k], diagonals.begin() + offset[k + 1], d) - diagonals.begin() - offset[k];
+				for (int p = pos + 1; p <= size; p += p & -p)
+					graphmin[offset[k] + p - 1] = std::min(graphmin[offset[k] + p - 1], g);
+				for (int p = size - pos; p <= size; p += p & -p)
+					querymin[offset[k] + p - 1] = std::min(querymin[offset[k] + p - 1], q);
+			}
+		}
+
+		// best far predecessor of anchor j
+		Candidate query(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, int j) const
+		{
+			Candidate best = none;
+			const long d = (long)eds_starts[j] - anchors[j].get_query_start();
+			for (int k = outer_rank(graph.get_block(anchors[j].get_first_node())); k > 0; k -= k & -k) {
+				const int size = offset[k + 1] - offset[k];
+				const int pos = std::upper_bound(diagonals.begin() + offset[k], diagonals.begin() + offset[k + 1], d) - diagonals.begin() - offset[k];
+				for (int p = pos; p > 0; p -= p & -p) {
+					const Candidate &c = graphmin[offset[k] + p - 1];
+					if (c.first != none.first)
+						best = std::min(best, Candidate(c.first + eds_starts[j], c.second));
+				}
+				for (int p = size - pos; p > 0; p -= p & -p) {
+					const Candidate &c = querymin[offset[k] + p - 1];
+					if (c.first != none.first)
+						best = std::min(best, Candidate(c.first + anchors[j].get_query_start(), c.second));
+				}
+			}
+			return best;
+		}
+
+	public:
+		/*
+		 * fill costs and backtrack as the DP of chain_global_eds
+		 * (chain_semiglobal_eds if semiglobal) after its last revision
+		 */
+		void chain(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const bool semiglobal, vector<int> &costs, vector<int> &backtrack, Stats &stats)
+		{
+			const int n = anchors.size();
+			costs.assign(n, 0);
+			backtrack.assign(n, 0);
+			build(anchors, graph);
+
+			vector<int> overlapping; // predecessors not inserted yet
+			std::unordered_map<int,vector<int>> bylastnode;
+			auto consider = [&](int i, int j, Candidate &best) {
+				stats.anchorpairs++;
+				// the gap is at least the one in the query, skip i if surely worse
+				if (costs[i] < std::numeric_limits<int>::max() and (long)costs[i] + std::max(0, anchors[j].get_query_start() - anchors[i].get_query_end()) > best.first) {
+					stats.prunedpairs++;
+					return;
+				}
+				if (costs[i] < std::numeric_limits<int>::max() and are_colinear_eds(anchors[i], anchors[j], graph)) {
+					const long cost = (long)costs[i] + max_gap_eds(anchors[i], anchors[j], graph) + overlap_eds(anchors[i], anchors[j], graph);
+					best = std::min(best, Candidate(cost, -i));
+				}
+			};
+
+			overlapping.push_back(0);
+			bylastnode[anchors[0].get_last_node()].push_back(0);
+			for (int j = 1; j < n; j++) {
+				Candidate best = none;
+				if (semiglobal and j == n - 1) {
+					// as in the DP, free gap to the last dummy anchor from all anchors
+					for (int i = j - 1; i >= 0; i--) {
+						if (costs[i] < std::numeric_limits<int>::max() and are_colinear_eds(anchors[i], anchors[j], graph)) {
+							const long cost = (long)costs[i] + GAFHit::gap_query(anchors[i], anchors[j]) + overlap_eds(anchors[i], anchors[j], graph);
+							best = std::min(best, Candidate(cost, -i));
+						}
+					}
+				} else {
+					int kept = 0;
+					for (int i : overlapping) {
+						if (anchors[i].get_query_end() <= anchors[j].get_query_start())
+							insert(anchors, graph, costs, i);
+						else
+							overlapping[kept++] = i;
+					}
+					overlapping.resize(kept);
+					best = query(anchors, graph, j);
+					for (int i : overlapping)
+						consider(i, j, best);
+					for (int node : anchors[j].get_path()) {
+						auto it = bylastnode.find(node);
+						if (it != bylastnode.end()) {
+							for (int i : it->second)
+								consider(i, j, best);
+						}
+					}
+				}
+
+				if (semiglobal) {
+					// the first dummy anchor wins ties, as in the DP
+					const long dummycost = (long)costs[0] + GAFHit::gap_query(anchors[0], anchors[j]);
+					if (dummycost <= best.first)
+						best = Candidate(dummycost, 0);
+				}
+				if (best.first == none.first) {
+					costs[j] = std::numeric_limits<int>::max();
+					backtrack[j] = std::numeric_limits<int>::max();
+				} else {
+					costs[j] = best.first;
+					backtrack[j] = -best.second;
+					overlapping.push_back(j);
+					bylastnode[anchors[j].get_last_node()].push_back(j);
+				}
+			}
+		}
+};
+
+/**
+ * See chain_global_eds, computed with RmqChainer
+ **/
+vector<GAFHit> chain_global_rmq(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, Stats &stats, const bool removesol = false, const int alternatives = 0)
+{
+	vector<int> costs, backtrack;
+	RmqChainer().chain(anchors, graph, false, costs, backtrack, stats);
+	if (alternatives > 0)
+		return backtrack_alternative_chains(anchors, graph, costs, backtrack, alternatives, false, 0, stats);
+	return backtrack_chain(anchors, graph, costs, backtrack, false, 0, stats, removesol);
+}
+
+/**
+ * See chain_semiglobal_eds, computed with RmqChainer
+ **/
+vector<GAFHit> chain_semiglobal_rmq(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, Stats &stats, const bool removesol = false, const int alternatives = 0)
+{
+	vector<int> costs, backtrack;
+	RmqChainer().chain(anchors, graph, true, costs, backtrack, stats);
+	if (alternatives > 0)
+		return backtrack_alternative_chains(anchors, graph, costs, backtrack, alternatives, true, 0, stats);
+	return backtrack_chain(anchors, graph, costs, backtrack, true, 0, stats, removesol);
+}
+
+} // Namespace chainx_block_graph
+
+#endif
@@ -6,92 +6,385 @@
 #define CHAIN_HPP
 
 #include "efg.hpp"
+#include "anchor-arrays.hpp"
+
+#include <queue>
+#include <thread>
+#include <barrier>
 
 //#define CHAIN_HPP_DEBUG
 
 using std::vector, std::swap;
 
 namespace chainx_block_graph {
-/**
- * Compute optimal chain based on anchor-restricted edit distance using
- * strong precedence criteria optimized to run faster using engineering
- * trick(s), comparison mode: global.
- * We assume the anchors are sorted by the starting positions in the
- * linear text and that there are two dummy anchors marking the
- * beginning and end of the references.
- * graph.init_eds_support() must have been called before this function
- **/
-vector<GAFHit> chain_global_eds(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const int initial_guess, const double ramp_up_factor, Stats &stats, const bool removesol = false)
+/*
+ * number of anchor pairs examined by a pass of the chaining DP that allows
+ * gaps of at most bound_redit, with the same sliding window as the DP (an
+ * upper bound for a pass reusing the previous one, see dp_pass)
+ */
+long dp_anchor_pairs(vector<GAFHit> &anchors, const int bound_redit, const bool semiglobal)
 {
-	//graph.init_eds_support();
-
-	int n = anchors.size();
-	vector<int> costs(n, 0);
-	vector<int> backtrack(n, 0);
-
-	int bound_redit = initial_guess; //distance assumed to be <= initial_guess
-	int revisions = 0;
-	//with this assumption on upper bound of distance, a gap of >bound_redit will not be allowed between adjacent anchors
-
-	while (true) {
-		int inner_loop_start = 0;
+	const int n = anchors.size();
+	long pairs = 0;
+	int inner_loop_start = 0;
+	for (int j = 1; j < n; j++) {
+		while (anchors[inner_loop_start].gap_query(anchors[j]) > bound_redit)
+			inner_loop_start++;
+		pairs += (semiglobal and j == n-1) ? j : j - inner_loop_start;
+	}
+	return pairs;
+}
 
-		for(int j=1; j<n; j++) {
-			//compute cost[j] here
-			int find_min_cost = std::numeric_limits<int>::max();
-			int backtrack_min_cost = std::numeric_limits<int>::max();
+/*
+ * bound of the next pass of the chaining DP within the budget, following a
+ * pass with bound lastbound (-1 before the first pass): bound_redit if the
+ * pass fits in the remaining anchor pairs, otherwise the largest bound in
+ * [lastbound+1..bound_redit) that fits. Returns -1 and records the reason in
+ * budget.exceeded if no further pass is allowed; the first pass is always
+ * allowed, so that there is a chain to fall back to
+ */
+int budget_bound(vector<GAFHit> &anchors, const int lastbound, const int bound_redit, const int revisions, const bool semiglobal, ChainBudget &budget)
+{
+	if (lastbound >= 0) {
+		if (budget.exceeded != BUDGET_OK)
+			return -1;
+		if (budget.maxrevisions > 0 and revisions > budget.maxrevisions) {
+			budget.exceeded = BUDGET_REVISIONS;
+			return -1;
+		}
+		if (budget.hasdeadline and std::chrono::steady_clock::now() >= budget.deadline) {
+			budget.exceeded = BUDGET_TIME;
+			return -1;
+		}
+	}
+	if (budget.maxpairs == 0)
+		return bound_redit;
+
+	const long remaining = budget.maxpairs - budget.pairs;
+	if (dp_anchor_pairs(anchors, bound_redit, semiglobal) <= remaining)
+		return bound_redit;
+	int lo = lastbound + 1, hi = bound_redit - 1, fit = -1;
+	while (lo <= hi) {
+		const int mid = lo + (hi - lo) / 2;
+		if (dp_anchor_pairs(anchors, mid, semiglobal) <= remaining) {
+			fit = mid;
+			lo = mid + 1;
+		} else {
+			hi = mid - 1;
+		}
+	}
+	if (fit == -1) {
+		budget.exceeded = BUDGET_PAIRS;
+		return (lastbound >= 0) ? -1 : std::min(bound_redit, 0);
+	}
+	return fit;
+}
 
-			// anchor i < anchor j 
+/*
+ * guess for the chaining cost after bound_redit, grown by at least 1 so that
+ * the ramp-up ends also from a guess of 0 or when the product is truncated
+ */
+int next_guess(const int bound_redit, const double ramp_up_factor)
+{
+	return std::min((long)std::numeric_limits<int>::max(), std::max((long)bound_redit + 1, (long)(bound_redit * ramp_up_factor)));
+}
 
-			while (anchors[inner_loop_start].gap_query(anchors[j]) > bound_redit)
-				inner_loop_start++;
+/*
+ * anchors per tile of a pass of the chaining DP with several threads, see
+ * dp_pass
+ */
+const int PARALLEL_DP_TILE = 256;
+
+/*
+ * pass of the chaining DP allowing gaps of at most bound_redit between
+ * adjacent anchors, following a pass with bound lastbound (-1 for the first
+ * pass) whose results are in costs and backtrack. A larger bound only widens
+ * the window of predecessors of each anchor, so the costs can only decrease:
+ * if the cost of the previous best predecessor of anchor j did not change,
+ * the new best predecessor is the previous one, one whose cost changed in
+ * this pass, or one in the new part of the window, and only these are
+ * examined; otherwise the window is examined as in the first pass. Ties are
+ * broken as in the first pass (towards the predecessor of largest index, and
+ * towards the first dummy anchor in semiglobal mode), so the result is the
+ * same as a pass from scratch. The window is examined over the arrays of
+ * the anchors (see AnchorArrays) in buckets of PRUNE_BUCKET anchors, from
+ * the closest one: a bucket is skipped if its lower bound on the costs of
+ * the pairs (see AnchorArrays::bucket_lower_bound) exceeds the best cost so
+ * far, and so is a predecessor whose own lower bound does (see
+ * AnchorArrays::lower_bound_cost) before computing its cost with the
+ * functions of efg.hpp, i.e. if not far or if changed. The skipped pairs are
+ * counted in stats.prunedpairs, the skipped buckets in stats.prunedbuckets.
+ *
+ * With threads > 1, the anchors are processed in tiles of PARALLEL_DP_TILE:
+ * the threads examine the predecessors of the anchors of a tile that lie in
+ * the previous tiles, whose costs are final, then the calling thread
+ * examines the predecessors in the tile. Where the previous best predecessor
+ * is in the tile, the threads assume that its cost did not change, and the
+ * calling thread examines again the previous tiles otherwise. Returns the
+ * number of anchor pairs examined
+ */
+long dp_pass(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, AnchorArrays &arrays, vector<int> &costs, vector<int> &backtrack, const int lastbound, const int bound_redit, const bool semiglobal, Stats &stats, const int threads = 1)
+{
+	const int n = anchors.size();
+	const int infinity = std::numeric_limits<int>::max();
+	vector<bool> changed(n, false);
+	vector<int> changedlist; // increasing
+
+	// window of this pass [from[j]..j-1], and of the previous pass [lastfrom[j]..j-1]
+	vector<int> from(n, 0), lastfrom(n, 0);
+	int inner_loop_start = 0, last_loop_start = 0;
+	for(int j=1; j<n; j++) {
+		// anchor i < anchor j
+		while (arrays.qstart[j] - arrays.qend[inner_loop_start] > bound_redit)
+			inner_loop_start++;
+		if (lastbound >= 0) {
+			while (arrays.qstart[j] - arrays.qend[last_loop_start] > lastbound)
+				last_loop_start++;
+		}
+		from[j] = inner_loop_start;
+		lastfrom[j] = (lastbound >= 0) ? last_loop_start : j;
+		//process all anchors in array for the final last dummy anchor
+		if (semiglobal and j == n-1) {
+			from[j] = 0;
+			lastfrom[j] = (lastbound >= 0) ? 0 : j;
+		}
+	}
 
-			for(int i=j-1; i>=inner_loop_start; i--) {
-				if (costs[i] < std::numeric_limits<int>::max() and are_colinear_eds(anchors[i], anchors[j], graph)) {
-					int g = max_gap_eds(anchors[i], anchors[j], graph);
-					int o = overlap_eds(anchors[i], anchors[j], graph);
+	auto cost = [&](int i, int j) {
+		const bool lastdummy = semiglobal and j == n-1;
+		if (arrays.is_far(i, j))
+			return arrays.far_cost(costs, i, j, lastdummy);
+		if (costs[i] == infinity or !are_colinear_eds(anchors[i], anchors[j], graph))
+			return infinity;
+		//modified cost for the last dummy anchor to allow free gaps
+		const int g = (lastdummy) ? GAFHit::gap_query(anchors[i], anchors[j]) : max_gap_eds(anchors[i], anchors[j], graph);
+		const int o = overlap_eds(anchors[i], anchors[j], graph);
 #ifdef CHAIN_HPP_DEBUG
-					std::cerr << "anchors[" << i << "] -> anchors[" << j << "]: g = " << g << ", o = " << o << std::endl;
+		std::cerr << "anchors[" << i << "] -> anchors[" << j << "]: g = " << g << ", o = " << o << std::endl;
 #endif
-					if (costs[i] + g + o < find_min_cost) {
-						find_min_cost = costs[i] + g + o;
-						backtrack_min_cost = i;
+		return costs[i] + g + o;
+	};
+
+	// predecessor i of cost c replaces the best one so far
+	auto improve = [&](int c, int i, int &mincost, int &argmin) {
+		if (c < mincost or (c != infinity and c == mincost and !(semiglobal and argmin == 0) and (i > argmin or (semiglobal and i == 0)))) {
+			mincost = c;
+			argmin = i;
+		}
+	};
+
+	// examine the predecessors of j in [lo..hi), only the changed ones and the new part of the window if reuse
+	// whether the predecessor i of j surely costs more than bound
+	auto prune = [&](int i, int j, int bound) {
+		return costs[i] != infinity and arrays.lower_bound_cost(costs, i, j) > bound;
+	};
+
+	auto examine = [&](int j, int lo, int hi, bool reuse, int *window, long &pairs, long &pruned, long &buckets, int &mincost, int &argmin) {
+		const bool lastdummy = semiglobal and j == n-1;
+		int scanto = hi; // the predecessors [scanfrom..scanto-1] are examined in the window
+		if (reuse) {
+			// predecessors of the previous window whose cost changed
+			for (int k = changedlist.size() - 1; k >= 0 and changedlist[k] >= std::max(lastfrom[j], lo); k--) {
+				pairs++;
+				if (prune(changedlist[k], j, mincost)) {
+					pruned++;
+					continue;
+				}
+				improve(cost(changedlist[k], j), changedlist[k], mincost, argmin);
+			}
+			scanto = std::min(hi, lastfrom[j]);
+		}
+		const int scanfrom = std::max(from[j], lo);
+		if (scanto > scanfrom) {
+			// by bucket from the closest one, skipping the buckets whose lower bound exceeds the best cost so far
+			int c = infinity, i = -1;
+			for (int bucketend = scanto; bucketend > scanfrom; ) {
+				const int bucket = (bucketend - 1) / PRUNE_BUCKET;
+				const int bucketstart = std::max(scanfrom, bucket * PRUNE_BUCKET);
+				if (arrays.bucket_lower_bound(bucket, j) > std::min(mincost, c)) {
+					pruned += bucketend - bucketstart;
+					buckets++;
+				} else {
+					if (arrays.far_costs(costs, j, bucketstart, bucketend, lastdummy, window)) {
+						// the other predecessors, skipped if their own lower bound exceeds the best cost so far
+						int bound = std::min(std::min(mincost, c), AnchorArrays::window_min(window, bucketend - bucketstart));
+						for (int k = bucketend - 1; k >= bucketstart; k--) {
+							if (arrays.is_far(k, j))
+								continue;
+							if (prune(k, j, bound)) {
+								pruned++;
+								continue;
+							}
+							window[k - bucketstart] = cost(k, j);
+							bound = std::min(bound, window[k - bucketstart]);
+						}
+					}
+					// the last predecessor of minimum cost
+					const int bucketmin = AnchorArrays::window_min(window, bucketend - bucketstart);
+					if (bucketmin < c) {
+						c = bucketmin;
+						for (i = bucketend - 1; window[i - bucketstart] != c; i--);
 					}
 				}
+				bucketend = bucketstart;
 			}
-			//save optimal cost at offset j
-			costs[j] = find_min_cost;
-			backtrack[j] = backtrack_min_cost;
+			if (c != infinity)
+				improve(c, i, mincost, argmin);
+			pairs += scanto - scanfrom;
 		}
-
-		if (costs[n-1] > bound_redit) {
-			bound_redit = bound_redit * ramp_up_factor;
-			revisions++;
-		} else {
-			break;
+	};
+
+	auto reusable = [&](int j) {
+		return lastbound >= 0 and (backtrack[j] == infinity or !changed[backtrack[j]]);
+	};
+
+	arrays.update_bound(costs, 0);
+	const int tile = (threads > 1) ? PARALLEL_DP_TILE : n;
+	vector<int> tilecosts(std::min(tile, n)), tileargmins(std::min(tile, n)); // best predecessors before the tile
+	vector<long> threadpairs(threads, 0), threadpruned(threads, 0), threadbuckets(threads, 0);
+	std::barrier sync(threads);
+
+	auto worker = [&](const int t) {
+		vector<int> threadwindow((t == 0) ? 0 : n);
+		int *window = (t == 0) ? arrays.window.data() : threadwindow.data();
+		long pairs = 0, pruned = 0, buckets = 0;
+		for (int tilestart = 1; tilestart < n; tilestart += tile) {
+			const int tileend = std::min(n, tilestart + tile);
+			for (int j = tilestart + t; j < tileend; j += threads) {
+				tilecosts[j - tilestart] = infinity;
+				tileargmins[j - tilestart] = infinity;
+				const bool reuse = (backtrack[j] != infinity and backtrack[j] >= tilestart) ? lastbound >= 0 : reusable(j);
+				examine(j, 0, tilestart, reuse, window, pairs, pruned, buckets, tilecosts[j - tilestart], tileargmins[j - tilestart]);
+			}
+			sync.arrive_and_wait();
+			if (t == 0) {
+				for (int j = tilestart; j < tileend; j++) {
+					int find_min_cost = infinity;
+					int backtrack_min_cost = infinity;
+					if (semiglobal) {
+						//always consider the first dummy anchor
+						//connection to first dummy anchor is done with modified cost to allow free gaps
+						find_min_cost = costs[0] + GAFHit::gap_query(anchors[0], anchors[j]);
+						backtrack_min_cost = 0;
+					}
+					const bool reuse = reusable(j);
+					if (reuse) {
+						find_min_cost = costs[j];
+						backtrack_min_cost = backtrack[j];
+					}
+					improve(tilecosts[j - tilestart], tileargmins[j - tilestart], find_min_cost, backtrack_min_cost);
+					if (!reuse and lastbound >= 0 and backtrack[j] != infinity and backtrack[j] >= tilestart)
+						examine(j, 0, tilestart, false, window, pairs, pruned, buckets, find_min_cost, backtrack_min_cost);
+					examine(j, tilestart, j, reuse, window, pairs, pruned, buckets, find_min_cost, backtrack_min_cost);
+
+					if (lastbound >= 0 and find_min_cost != costs[j]) {
+						changed[j] = true;
+						changedlist.push_back(j);
+					}
+					//save optimal cost at offset j
+					costs[j] = find_min_cost;
+					backtrack[j] = backtrack_min_cost;
+					arrays.update_bound(costs, j);
+				}
+			}
+			sync.arrive_and_wait();
 		}
+		threadpairs[t] = pairs;
+		threadpruned[t] = pruned;
+		threadbuckets[t] = buckets;
+	};
+
+	vector<std::thread> helpers;
+	for (int t = 1; t < threads; t++)
+		helpers.emplace_back(worker, t);
+	worker(0);
+	for (std::thread &h : helpers)
+		h.join();
+
+	long pairs = 0;
+	for (int t = 0; t < threads; t++) {
+		pairs += threadpairs[t];
+		stats.prunedpairs += threadpruned[t];
+		stats.prunedbuckets += threadbuckets[t];
 	}
+	stats.anchorpairs += pairs;
+	return pairs;
+}
 
-#ifdef CHAIN_HPP_DEBUG
-		std::cerr << "Cost DP array = ";
-		for (auto c : costs)
-			std::cerr << c << " ";
-		std::cerr << std::endl;
-		std::cerr << "Backtrack array = ";
-		for (auto b : backtrack)
-			std::cerr << b << " ";
-		std::cerr << std::endl;
-		std::cerr << "Chaining cost computed " << revisions + 1 << " times" << "\n";
-#endif
+void chain_stats(Stats &stats, const int revisions, const int cost, const int querylength)
+{
+	stats.maxiterations = std::max(stats.maxiterations, revisions);
+	stats.miniterations = std::min(stats.miniterations, revisions);
+	stats.totaliterations += revisions;
+	stats.maxcost = std::max(stats.maxcost, cost);
+	stats.mincost = std::min(stats.mincost, cost);
+	stats.totalcost += cost;
+	const double relativecost = (double)cost / querylength;
+	stats.maxrelativecost = std::max(stats.maxrelativecost, relativecost);
+	stats.minrelativecost = std::min(stats.minrelativecost, relativecost);
+	stats.totalrelativecost += relativecost;
+}
 
-	//TODO: consider freeing here the space of costs array
-	// backtrack optimal solution
-	vector<GAFHit> solution;
-	for (int j = backtrack[n - 1]; j > 0; j = backtrack[j])
-	{
-		solution.push_back(anchors[j]);
+// cost of a chain starting with anchor s, from the first dummy anchor
+int chain_start_cost(vector<GAFHit> &anchors, const int s, const Elasticfoundergraph &graph, const bool semiglobal)
+{
+	return (semiglobal) ? GAFHit::gap_query(anchors[0], anchors[s]) : max_gap_eds(anchors[0], anchors[s], graph) + overlap_eds(anchors[0], anchors[s], graph);
+}
+
+// cost of closing with the last dummy anchor a chain ending with anchor j, infinity if they are not colinear
+int chain_end_cost(vector<GAFHit> &anchors, const int j, const Elasticfoundergraph &graph, const bool semiglobal)
+{
+	const int n = anchors.size();
+	if (!are_colinear_eds(anchors[j], anchors[n-1], graph))
+		return std::numeric_limits<int>::max();
+	const int g = (semiglobal) ? GAFHit::gap_query(anchors[j], anchors[n-1]) : max_gap_eds(anchors[j], anchors[n-1], graph);
+	return g + overlap_eds(anchors[j], anchors[n-1], graph);
+}
+
+/*
+ * backtrack the chain ending in the last dummy anchor from the DP arrays
+ * (without the dummy anchors), update the stats and, if removesol, remove the
+ * anchors of the chain from anchors. If the budget stopped the ramp-up of a
+ * global chaining before the last dummy anchor was reachable, the chain is
+ * the best partial one instead: that of the anchor j minimizing the cost of
+ * its best chain (or of j alone, if the first dummy anchor is too far from
+ * it for the last guess) closed by the gap to the last dummy anchor
+ */
+vector<GAFHit> backtrack_chain(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const vector<int> &costs, const vector<int> &backtrack, const bool semiglobal, const int revisions, Stats &stats, const bool removesol)
+{
+	const int n = anchors.size();
+	const int infinity = std::numeric_limits<int>::max();
+	vector<int> chain; // from the last anchor
+	long cost = costs[n-1];
+	if (costs[n-1] < infinity) {
+		for (int j = backtrack[n-1]; j > 0; j = backtrack[j])
+			chain.push_back(j);
+	} else {
+		int last = -1;
+		bool alone = false;
+		for (int j = 1; j < n-1; j++) {
+			const int e = chain_end_cost(anchors, j, graph, semiglobal);
+			if (e == infinity)
+				continue;
+			if (costs[j] < infinity and (long)costs[j] + e < cost) {
+				cost = (long)costs[j] + e;
+				last = j;
+				alone = false;
+			}
+			if ((long)chain_start_cost(anchors, j, graph, semiglobal) + e < cost) {
+				cost = (long)chain_start_cost(anchors, j, graph, semiglobal) + e;
+				last = j;
+				alone = true;
+			}
+		}
+		if (last > 0)
+			chain.push_back(last);
+		for (int j = (last > 0 and !alone) ? backtrack[last] : 0; j > 0; j = backtrack[j])
+			chain.push_back(j);
 	}
-	std::reverse(solution.begin(), solution.end());
+	vector<GAFHit> solution;
+	for (int i = chain.size() - 1; i >= 0; i--)
+		solution.push_back(anchors[chain[i]]);
 	if (removesol)
 	{
 		vector<GAFHit> newanchors;
@@ -108,27 +401,100 @@ vector<GAFHit> chain_global_eds(vector<GAFHit> &anchors, const Elasticfoundergra
 		swap(anchors, newanchors);
 	}
 
-	//std::cout << "distance = " << costs[n-1] << std::endl;
-	if (solution.size() > 0) {
-		stats.maxiterations = std::max(stats.maxiterations, revisions);
-		stats.miniterations = std::min(stats.miniterations, revisions);
-		stats.totaliterations += revisions;
-		stats.maxcost = std::max(stats.maxcost, costs[n-1]);
-		stats.mincost = std::min(stats.mincost, costs[n-1]);
-		stats.totalcost += costs[n-1];
-		const double relativecost = (double)costs[n-1] / solution.at(0).get_query_length();
-		stats.maxrelativecost = std::max(stats.maxrelativecost, relativecost);
-		stats.minrelativecost = std::min(stats.minrelativecost, relativecost);
-		stats.totalrelativecost += relativecost;
+	//std::cout << "distance = " << cost << std::endl;
+	if (solution.size() > 0)
+		chain_stats(stats, revisions, std::min<long>(cost, infinity), solution.at(0).get_query_length());
+
+	return solution;
+}
+
+/*
+ * the chain ending in the last dummy anchor followed by up to alternatives
+ * anchor-disjoint chains, all backtracked from the same DP arrays
+ * (--single-pass-alternatives): the anchors are taken by increasing cost of
+ * their best chain closed by the last dummy anchor, and a chain is cut
+ * before the first anchor already used, starting from the first dummy anchor
+ * instead; a chain whose cost grows with the cut is put back with its new
+ * cost. Unlike chaining again without the anchors of the previous chains,
+ * the predecessors of the anchors are not recomputed
+ */
+vector<GAFHit> backtrack_alternative_chains(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const vector<int> &costs, const vector<int> &backtrack, const int alternatives, const bool semiglobal, const int revisions, Stats &stats)
+{
+	const int n = anchors.size();
+	const int infinity = std::numeric_limits<int>::max();
+	vector<bool> used(n, false);
+	vector<GAFHit> solution, chain;
+
+	// costs from the first dummy anchor and to the last one, with the free gaps of semiglobal mode
+	auto start_cost = [&](int s) { return chain_start_cost(anchors, s, graph, semiglobal); };
+	auto end_cost = [&](int j) { return chain_end_cost(anchors, j, graph, semiglobal); };
+	// anchors from j back to s, marked as used
+	auto take_chain = [&](int j, int s, int cost) {
+		chain.clear();
+		for (int i = j; ; i = backtrack[i]) {
+			chain.push_back(anchors[i]);
+			used[i] = true;
+			if (i == s)
+				break;
+		}
+		std::reverse(chain.begin(), chain.end());
+		chain_stats(stats, revisions, cost, anchors[0].get_query_length());
+		move(chain.begin(), chain.end(), back_inserter(solution));
+	};
+
+	if (costs[n-1] == infinity)
+		return backtrack_chain(anchors, graph, costs, backtrack, semiglobal, revisions, stats, false);
+	if (backtrack[n-1] <= 0)
+		return solution;
+	{
+		int s = backtrack[n-1];
+		while (backtrack[s] > 0)
+			s = backtrack[s];
+		take_chain(backtrack[n-1], s, costs[n-1]);
+	}
+
+	typedef std::pair<long,int> Candidate; // (cost, end anchor)
+	std::priority_queue<Candidate,vector<Candidate>,std::greater<Candidate>> queue;
+	for (int j = 1; j < n-1; j++) {
+		if (!used[j] and costs[j] < infinity) {
+			const int e = end_cost(j);
+			if (e < infinity)
+				queue.push(Candidate((long)costs[j] + e, j));
+		}
+	}
+	for (int k = 0; k < alternatives and !queue.empty(); ) {
+		const auto [cost, j] = queue.top();
+		queue.pop();
+		if (used[j])
+			continue;
+		int s = j;
+		while (backtrack[s] > 0 and !used[backtrack[s]])
+			s = backtrack[s];
+		long cutcost = cost;
+		if (backtrack[s] > 0)
+			cutcost = (long)start_cost(s) + costs[j] - costs[s] + end_cost(j);
+		if (cutcost > cost and !queue.empty() and cutcost > queue.top().first) {
+			queue.push(Candidate(cutcost, j));
+			continue;
+		}
+		take_chain(j, s, std::min<long>(cutcost, infinity));
+		k++;
 	}
 
 	return solution;
 }
 
 /**
- * See chain_global_eds, comparison mode: semiglobal.
+ * Compute optimal chain based on anchor-restricted edit distance using
+ * strong precedence criteria optimized to run faster using engineering
+ * trick(s), comparison mode: global.
+ * We assume the anchors are sorted by the starting positions in the
+ * linear text and that there are two dummy anchors marking the
+ * beginning and end of the references.
+ * graph.init_eds_support() must have been called before this function.
+ * With threads > 1, each pass of the DP uses that many threads (see dp_pass)
  **/
-vector<GAFHit> chain_semiglobal_eds(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const int initial_guess, const double ramp_up_factor, Stats &stats, const bool removesol = false)
+vector<GAFHit> chain_global_eds(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const int initial_guess, const double ramp_up_factor, Stats &stats, const bool removesol = false, ChainBudget *budget = nullptr, const int alternatives = 0, const int threads = 1)
 {
 	//graph.init_eds_support();
 
@@ -139,62 +505,79 @@ vector<GAFHit> chain_semiglobal_eds(vector<GAFHit> &anchors, const Elasticfounde
 	int bound_redit = initial_guess; //distance assumed to be <= initial_guess
 	int revisions = 0;
 	//with this assumption on upper bound of distance, a gap of >bound_redit will not be allowed between adjacent anchors
+	if (budget != nullptr)
+		bound_redit = budget_bound(anchors, -1, bound_redit, revisions, false, *budget);
 
+	AnchorArrays arrays(anchors, graph);
+	int lastbound = -1;
 	while (true) {
-		int inner_loop_start = 0;
+		const long pairs = dp_pass(anchors, graph, arrays, costs, backtrack, lastbound, bound_redit, false, stats, threads);
+		lastbound = bound_redit;
 
-		for(int j=1; j<n; j++) {
-			//compute cost[j] here
-			int find_min_cost = std::numeric_limits<int>::max();
-			int backtrack_min_cost = std::numeric_limits<int>::max();
+		if (budget != nullptr)
+			budget->pairs += pairs;
 
-			// anchor i < anchor j 
-
-			while (anchors[inner_loop_start].gap_query(anchors[j]) > bound_redit)
-				inner_loop_start++;
+		if (costs[n-1] > bound_redit) {
+			// next guess, or fall back to the chain of this pass if out of budget
+			const int next = (budget != nullptr) ? budget_bound(anchors, bound_redit, next_guess(bound_redit, ramp_up_factor), revisions + 1, false, *budget) : next_guess(bound_redit, ramp_up_factor);
+			if (next == -1)
+				break;
+			bound_redit = next;
+			revisions++;
+		} else {
+			break;
+		}
+	}
 
-			{
-				//always consider the first dummy anchor 
-				//connection to first dummy anchor is done with modified cost to allow free gaps
-				//int i_d = std::get<1>(anchors[0]) + std::get<2>(anchors[0]) - 1;
-				//int qry_gap = j_c - i_d - 1;
-				int queryg = GAFHit::gap_query(anchors[0], anchors[j]);
-				find_min_cost = std::min(find_min_cost, costs[0] + queryg);
-				backtrack_min_cost = 0;
 #ifdef CHAIN_HPP_DEBUG
-					std::cerr << "anchors[" << "0" << "] -> anchors[" << j << "]: queryg = " << queryg << std::endl;
+		std::cerr << "Cost DP array = ";
+		for (auto c : costs)
+			std::cerr << c << " ";
+		std::cerr << std::endl;
+		std::cerr << "Backtrack array = ";
+		for (auto b : backtrack)
+			std::cerr << b << " ";
+		std::cerr << std::endl;
+		std::cerr << "Chaining cost computed " << revisions + 1 << " times" << "\n";
 #endif
-			}
 
-			//process all anchors in array for the final last dummy anchor
-			if (j == n-1)
-				inner_loop_start=0;
+	if (alternatives > 0)
+		return backtrack_alternative_chains(anchors, graph, costs, backtrack, alternatives, false, revisions, stats);
+	return backtrack_chain(anchors, graph, costs, backtrack, false, revisions, stats, removesol);
+}
+
+/**
+ * See chain_global_eds, comparison mode: semiglobal.
+ **/
+vector<GAFHit> chain_semiglobal_eds(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const int initial_guess, const double ramp_up_factor, Stats &stats, const bool removesol = false, ChainBudget *budget = nullptr, const int alternatives = 0, const int threads = 1)
+{
+	//graph.init_eds_support();
+
+	int n = anchors.size();
+	vector<int> costs(n, 0);
+	vector<int> backtrack(n, 0);
+
+	int bound_redit = initial_guess; //distance assumed to be <= initial_guess
+	int revisions = 0;
+	//with this assumption on upper bound of distance, a gap of >bound_redit will not be allowed between adjacent anchors
+	if (budget != nullptr)
+		bound_redit = budget_bound(anchors, -1, bound_redit, revisions, true, *budget);
 
-			for(int i=j-1; i>=inner_loop_start; i--) {
-				if (costs[i] < std::numeric_limits<int>::max() and are_colinear_eds(anchors[i], anchors[j], graph)) {
-					int g;
-					if (j == n-1) //modified cost for the last dummy anchor to allow free gaps
-						g = GAFHit::gap_query(anchors[i], anchors[j]);
-					else
-						g = max_gap_eds(anchors[i], anchors[j], graph);
+	AnchorArrays arrays(anchors, graph);
+	int lastbound = -1;
+	while (true) {
+		const long pairs = dp_pass(anchors, graph, arrays, costs, backtrack, lastbound, bound_redit, true, stats, threads);
+		lastbound = bound_redit;
 
-					int o = overlap_eds(anchors[i], anchors[j], graph);
-#ifdef CHAIN_HPP_DEBUG
-					std::cerr << "anchors[" << i << "] -> anchors[" << j << "]: g = " << g << ", o = " << o << std::endl;
-#endif
-					if (costs[i] + g + o < find_min_cost) {
-						find_min_cost = costs[i] + g + o;
-						backtrack_min_cost = i;
-					}
-				}
-			}
-			//save optimal cost at offset j
-			costs[j] = find_min_cost;
-			backtrack[j] = backtrack_min_cost;
-		}
+		if (budget != nullptr)
+			budget->pairs += pairs;
 
 		if (costs[n-1] > bound_redit) {
-			bound_redit = bound_redit * ramp_up_factor;
+			// next guess, or fall back to the chain of this pass if out of budget
+			const int next = (budget != nullptr) ? budget_bound(anchors, bound_redit, next_guess(bound_redit, ramp_up_factor), revisions + 1, true, *budget) : next_guess(bound_redit, ramp_up_factor);
+			if (next == -1)
+				break;
+			bound_redit = next;
 			revisions++;
 		} else {
 			break;
@@ -213,46 +596,9 @@ vector<GAFHit> chain_semiglobal_eds(vector<GAFHit> &anchors, const Elasticfounde
 		std::cerr << "Chaining cost computed " << revisions + 1 << " times" << "\n";
 #endif
 
-	//TODO: consider freeing here the space of costs array
-	// backtrack optimal solution
-	vector<GAFHit> solution;
-	for (int j = backtrack[n - 1]; j > 0; j = backtrack[j])
-	{
-		solution.push_back(anchors[j]);
-	}
-	std::reverse(solution.begin(), solution.end());
-	if (removesol)
-	{
-		vector<GAFHit> newanchors;
-		newanchors.reserve(anchors.size() - solution.size());
-		for (int i = 0, j = 0; i < anchors.size(); i += 1)
-		{
-			if (j < solution.size() and anchors[i] == solution[j])
-			{
-				j += 1;
-			} else {
-				newanchors.push_back(anchors[i]);
-			}
-		}
-		swap(anchors, newanchors);
-	}
-
-	//std::cerr << "distance = " << costs[n-1] << std::endl;
-	//std::cerr << "length - distance = " << anchors[0].get_query_length() - costs[n-1]  << std::endl;
-	if (solution.size() > 0) {
-		stats.maxiterations = std::max(stats.maxiterations, revisions);
-		stats.miniterations = std::min(stats.miniterations, revisions);
-		stats.totaliterations += revisions;
-		stats.maxcost = std::max(stats.maxcost, costs[n-1]);
-		stats.mincost = std::min(stats.mincost, costs[n-1]);
-		stats.totalcost += costs[n-1];
-		const double relativecost = (double)costs[n-1] / solution.at(0).get_query_length();
-		stats.maxrelativecost = std::max(stats.maxrelativecost, relativecost);
-		stats.minrelativecost = std::min(stats.minrelativecost, relativecost);
-		stats.totalrelativecost += relativecost;
-	}
-
-	return solution;
+	if (alternatives > 0)
+		return backtrack_alternative_chains(anchors, graph, costs, backtrack, alternatives, true, revisions, stats);
+	return backtrack_chain(anchors, graph, costs, backtrack, true, revisions, stats, removesol);
 }
 
 } // Namespace chainx_block_graph
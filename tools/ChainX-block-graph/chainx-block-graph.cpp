@@ -9,30 +9,66 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <thread>
+#include <map>
+#include <atomic>
 #include "concurrentqueue.h" // https://github.com/cameron314/concurrentqueue
 
 #include "chainx-block-graph.hpp"
 #include "command-line-parsing/cmdline.h" // gengetopt-generated parser
 #include "efg.hpp"
 #include "chaining.hpp"
+#include "chaining-rmq.hpp"
+#include "prefilter.hpp"
+#include "../common/shards.hpp"
+#include "partitions.hpp"
+#include "../common/numa.hpp"
+#include "../common/scheduler.hpp"
+#include "../common/trace.hpp"
+#include "../common/progress.hpp"
+#include "../efg-locate/seeding.hpp" // seeding with --seed-reads
+#include "../efg-locate/patterns.hpp"
 
 //#define CHAINX_DEBUG
 
 using namespace chainx_block_graph;
 using std::string;
 using std::move, std::back_inserter;
-std::mutex mutp;
-moodycamel::ConcurrentQueue<std::string*> outputqueue { 50, 64, 64 }; // TODO: parameterize this!
-moodycamel::ConcurrentQueue<string> anchorsqueue { 50, 64, 64 }; // TODO: parameterize this!
-moodycamel::ConcurrentQueue<std::pair<string,vector<string>>*> taskqueue { 50, 64, 64 }; // TODO: parameterize this!
+std::mutex mutp, mutdeferred;
+moodycamel::ConcurrentQueue<std::pair<long,std::string*>> outputqueue { 50, 64, 64 }; // TODO: parameterize this!
+moodycamel::ConcurrentQueue<std::pair<long,string>> anchorsqueue { 50, 64, 64 }; // TODO: parameterize this!
+WorkStealingScheduler<vector<ChainingTask*>> scheduler; // tasks are groups of queries
+WorkStealingScheduler<vector<efg_locate::InputPattern>> readscheduler; // with --seed-reads, tasks are groups of reads
+std::atomic<long> nextoutput = 0; // with --ordered-output, sequence number of the first query not written yet
 
+/*
+ * with --ordered-output, every query enqueues exactly one (possibly empty)
+ * output string and the writer keeps the strings that arrive early in a
+ * reorder buffer until all previous queries are written
+ */
 void writer_worker(std::atomic<bool> &input_done, std::atomic<bool>& done, Params &params)
 {
-	string *ptr;
+	std::pair<long,string*> item;
+	std::map<long,string*> reorderbuffer;
 	while (true) {
-		while (outputqueue.try_dequeue(ptr)) {
-			params.outputfs << *ptr << "\n";
-			delete(ptr);
+		while (outputqueue.try_dequeue(item)) {
+			if (!params.orderedoutput) {
+				params.outputfs << *item.second;
+				delete(item.second);
+				continue;
+			}
+
+			reorderbuffer.insert(item);
+			long next = nextoutput.load();
+			while (reorderbuffer.size() > 0 and reorderbuffer.begin()->first == next) {
+				params.outputfs << *reorderbuffer.begin()->second;
+				delete(reorderbuffer.begin()->second);
+				reorderbuffer.erase(reorderbuffer.begin());
+				next += 1;
+			}
+			if (next != nextoutput.load()) {
+				nextoutput.store(next);
+				nextoutput.notify_all();
+			}
 		}
 		// queue is empty?
 		if (!done or !input_done)
@@ -40,68 +76,304 @@ void writer_worker(std::atomic<bool> &input_done, std::atomic<bool>& done, Param
 		else
 			break;
 	}
+	assert(reorderbuffer.size() == 0);
+}
+
+/*
+ * with --ordered-output, block until query seq is within the reorder window,
+ * i.e. less than params.orderedoutputwindow queries after the first one not
+ * written yet, which bounds the size of the reorder buffer; with sorted input
+ * the reader calls this before scheduling a window of queries, so the
+ * chaining threads never block
+ */
+void inline wait_output_window(const long seq, const Params &params)
+{
+	if (!params.orderedoutput)
+		return;
+
+	long next = nextoutput.load();
+	while (seq >= next + params.orderedoutputwindow) {
+		nextoutput.wait(next);
+		next = nextoutput.load();
+	}
+}
+
+// with --sharded-output, write s directly to the shard of the thread
+void inline enqueue_output(const long seq, std::string *s, Params &params, const int shard)
+{
+	StageTimer outputtimer(shard, STAGE_OUTPUT);
+	if (params.shardedoutput) {
+		params.shardfs[shard] << *s;
+		delete(s);
+		return;
+	}
+
+	TraceSpan span("output enqueue");
+	std::pair<long,std::string*> item(seq, s);
+	while (!outputqueue.try_enqueue(item))
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+// GAF lines of the chain of query, each one terminated by a newline
+string chain_to_string(const Elasticfoundergraph &graph, vector<GAFHit> &solution, const string &query, const Params &params)
+{
+	TraceSpan span("format");
+	string out;
+	bool reverse = false;
+	if (query.find("rev_") != std::string::npos) {
+		for (auto &a : solution)
+			a.reverse();
+		reverse = true;
+	}
+	const string qname = (reverse) ? query.substr(4) : query;
+	if (params.nosplit) {
+		for (auto &a : solution)
+			out += a.to_string(graph, qname) + "\n";
+	} else {
+		for (auto &a : solution) {
+			if (params.splitgraphaligner) {
+				for (auto &b : a.split_single_graphaligner(graph))
+					out += b.to_string(graph, qname) + "\n";
+			} else {
+				for (auto &b : a.split(graph))
+					out += b.to_string(graph, qname) + "\n";
+			}
+		}
+	}
+	return out;
+}
+
+// work budget of a read starting now, see ChainBudget
+ChainBudget read_budget(const Params &params)
+{
+	ChainBudget budget;
+	budget.maxrevisions = params.maxrevisions;
+	budget.maxpairs = params.maxanchorpairs;
+	if (params.readtimeout > 0) {
+		budget.hasdeadline = true;
+		budget.deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((long)(params.readtimeout * 1000));
+	}
+	return budget;
+}
+
+// with --deferred, write the anchors of a read that exceeded its budget
+void defer_read(const string &lines, Params &params)
+{
+	std::scoped_lock lck {mutdeferred};
+	params.deferredfs << lines;
+}
+
+/*
+ * chain the anchors in the selected mode, with the alternative chains first;
+ * if the read exceeds its budget, the chains are those of the last completed
+ * pass of the DP (see budget_bound), and budget.exceeded tells why
+ */
+vector<GAFHit> chain_anchors(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const Params &params, Stats &stats, ChainBudget &budget)
+{
+	TraceSpan span("chaining");
+	ChainBudget *b = (budget.limited()) ? &budget : nullptr;
+	if (params.prefilter or params.minclusterscore > 0)
+		prefilter_anchors(anchors, graph, params.prefilter, params.minclusterscore, params.clusterband, params.clustermaxgap, stats);
+	vector<GAFHit> solution;
+	int initial_guess;
+	if (params.initialguesscov == 0) {
+		initial_guess = params.initialguess;
+	} else {
+		initial_guess = anchors.at(0).get_query_length() - (compute_coverage_greedy(anchors) * params.initialguesscov);
+	}
+	// threads for the DP of this query, see dp_pass
+	const int dpthreads = (params.parallelanchors > 0 and anchors.size() >= params.parallelanchors) ? std::max(1, params.threads) : 1;
+	// one chaining in the selected mode and engine, with the given alternative chains from the same DP
+	auto chain_once = [&](const bool removesol, const int alternatives) {
+		if (params.rmqchaining)
+			return (params.global) ? chain_global_rmq(anchors, graph, stats, removesol, alternatives) : chain_semiglobal_rmq(anchors, graph, stats, removesol, alternatives);
+		else if (params.global)
+			return chain_global_eds(anchors, graph, initial_guess, params.rampupfactor, stats, removesol, b, alternatives, dpthreads);
+		else
+			return chain_semiglobal_eds(anchors, graph, initial_guess, params.rampupfactor, stats, removesol, b, alternatives, dpthreads);
+	};
+	if (params.alternativealignments == 0) {
+		solution = chain_once(false, 0);
+	} else if (params.singlepassalternatives) {
+		solution = chain_once(false, params.alternativealignments);
+	} else {
+		vector<GAFHit> chain;
+		for (int i = params.alternativealignments; i > 0; i--) {
+			chain = chain_once(true, 0);
+			solution.reserve(solution.size() + chain.size());
+			move(chain.begin(), chain.end(), back_inserter(solution));
+			chain.clear();
+		}
+		chain = chain_once(false, 0);
+		solution.reserve(solution.size() + chain.size());
+		move(chain.begin(), chain.end(), back_inserter(solution));
+	}
+	if (budget.exceeded == BUDGET_REVISIONS)
+		stats.budgetrevisions += 1;
+	else if (budget.exceeded == BUDGET_PAIRS)
+		stats.budgetpairs += 1;
+	else if (budget.exceeded == BUDGET_TIME)
+		stats.budgettime += 1;
+	return solution;
+}
+
+// whether chain_anchors removes anchors from the list (alternative chains, prefilter)
+bool removes_anchors(const Params &params)
+{
+	return params.alternativealignments > 0 or params.prefilter or params.minclusterscore > 0;
+}
+
+// GAF lines of the anchors of query, without the dummy anchors
+string anchors_to_string(const Elasticfoundergraph &graph, vector<GAFHit> &anchors, const string &query)
+{
+	string out;
+	for (int i = 1; i + 1 < anchors.size(); i++)
+		out += anchors[i].to_string(graph, query) + "\n";
+	return out;
+}
+
+/*
+ * schedule a window of queries longest first: queries are sorted by
+ * decreasing number of anchors and packed into tasks of at least
+ * params.taskanchors anchors, so that queries with many anchors are tasks on
+ * their own and are started early
+ */
+void schedule_window(vector<ChainingTask*> &window, Params &params)
+{
+	if (window.size() == 0)
+		return;
+	wait_output_window(window.back()->seq, params);
+
+	std::stable_sort(window.begin(), window.end(), [](const ChainingTask *t1, const ChainingTask *t2)
+			{
+			return t1->anchors.size() > t2->anchors.size();
+			});
+	vector<ChainingTask*> task;
+	long taskanchors = 0;
+	for (ChainingTask *t : window) {
+		taskanchors += t->anchors.size();
+		task.push_back(t);
+		if (taskanchors >= params.taskanchors) {
+			scheduler.push(std::move(task), taskanchors);
+			task = vector<ChainingTask*>();
+			taskanchors = 0;
+		}
+	}
+	if (task.size() > 0)
+		scheduler.push(std::move(task), taskanchors);
+	window.clear();
 }
 
-void reader_worker(const Elasticfoundergraph &efg, std::atomic<bool> &input_done, Params &params)
+/*
+ * read the anchors files (shards) one after the other; with a sharded input
+ * and unordered output there is one reader per shard, and the last reader to
+ * finish sets input_done
+ */
+void reader_worker(const Elasticfoundergraph &efg, vector<std::ifstream*> anchorsfs, std::atomic<int> &readers, std::atomic<bool> &input_done, Params &params)
 {
-	std::pair<string,vector<string>> *ptr;
-	std::unordered_set<string> anchor_ids;
+	// a single thread keeps the input order; with --ordered-output, a window
+	// cannot exceed the reorder window
+	int windowsize = (params.threads <= 1) ? 1 : params.schedulewindow;
+	if (params.orderedoutput)
+		windowsize = std::min(windowsize, params.orderedoutputwindow);
+	vector<ChainingTask*> window;
+	long seq = 0;
+	RecentQueries anchor_ids;
 	string current_id = "", line;
 	vector<string> gafhits; // string description of anchors
-	string qname;
-	while (std::getline(params.anchorsfs, line)) {
-		if (line == "")
-			continue;
+	string_view qname;
+	for (std::ifstream *fs : anchorsfs) {
+		while (std::getline(*fs, line)) {
+			progress.inputbytes.fetch_add(line.size() + 1, std::memory_order_relaxed);
+			if (line == "")
+				continue;
+			progress.inputwork.fetch_add(1, std::memory_order_relaxed);
 	
-		//istringstream linestream(line);
-		//const GAFHit a(linestream, efg, qname);
-		qname = read_gaf_query_id(line);
+			//istringstream linestream(line);
+			//const GAFHit a(linestream, efg, qname);
+			qname = read_gaf_query_id(line);
 
-		if (qname == current_id) {
-			//gafhits.push_back(a);
-			gafhits.push_back(line);
-		} else {
-			if (current_id != "" and anchor_ids.contains(qname)) {
-				std::cerr << "Fatal error for anchors of query " << qname << ": are the anchors sorted? Sort them, or try flag --unsorted_input" << std::endl;
-				exit(1);
-			}
-			if (current_id != "") {
-				//std::pair<string,vector<GAFHit>> *ptr = new std::pair(current_id,vector<GAFHit>(std::move(gafhits)));
-				std::pair<string,vector<string>> *ptr = new std::pair(current_id,vector<string>(std::move(gafhits)));
-				while (!taskqueue.try_enqueue(ptr))
-					std::this_thread::sleep_for(std::chrono::milliseconds(10));
-				gafhits.clear(); // TODO assert?
-				////gafhits.push_back(dummy_start(a, efg));
-				//istringstream liness(line);
-				//GAFHit a(liness, efg, qname);
-				//gafhits.push_back(dummy_start(a, efg).to_string(efg, qname));
-			}
-			if (current_id == "") {
-				//istringstream liness(line);
-				//GAFHit a(liness, efg, qname);
-				//gafhits.push_back(dummy_start(a, efg).to_string(efg, qname));
-			}
+			if (qname == current_id) {
+				//gafhits.push_back(a);
+				gafhits.push_back(std::move(line));
+			} else {
+				if (current_id != "" and anchor_ids.contains(qname)) {
+					std::cerr << "Fatal error for anchors of query " << qname << ": are the anchors sorted? Sort them, or try flag --unsorted_input" << std::endl;
+					exit(1);
+				}
+				if (current_id != "") {
+					//std::pair<string,vector<GAFHit>> *ptr = new std::pair(current_id,vector<GAFHit>(std::move(gafhits)));
+					window.push_back(new ChainingTask {seq++, current_id, vector<string>(std::move(gafhits)), (tracer.enabled) ? tracer.now_us() : -1});
+					if (window.size() >= windowsize)
+						schedule_window(window, params);
+					gafhits.clear(); // TODO assert?
+					////gafhits.push_back(dummy_start(a, efg));
+					//istringstream liness(line);
+					//GAFHit a(liness, efg, qname);
+					//gafhits.push_back(dummy_start(a, efg).to_string(efg, qname));
+				}
+				if (current_id == "") {
+					//istringstream liness(line);
+					//GAFHit a(liness, efg, qname);
+					//gafhits.push_back(dummy_start(a, efg).to_string(efg, qname));
+				}
 
-			anchor_ids.insert(qname);
-			current_id = qname;
-			//gafhits.push_back(a);
-			gafhits.push_back(line);
+				anchor_ids.insert(qname);
+				current_id = qname;
+				//gafhits.push_back(a);
+				gafhits.push_back(std::move(line));
+			}
 		}
 	}
 	if (gafhits.size() > 0) {
 		//taskqueue.enqueue(new std::pair(current_id,vector<GAFHit>(std::move(gafhits))));
-		taskqueue.enqueue(new std::pair(current_id,vector<string>(std::move(gafhits))));
+		window.push_back(new ChainingTask {seq++, current_id, vector<string>(std::move(gafhits)), (tracer.enabled) ? tracer.now_us() : -1});
 	}
+	schedule_window(window, params);
+	if (--readers == 0)
+		input_done = true;
+}
+
+/*
+ * load the partitions of the unsorted anchors one after the other and
+ * schedule their queries as reader_worker does
+ */
+void partition_worker(AnchorPartitions &partitions, std::atomic<bool> &input_done, Params &params)
+{
+	// the partitions do not keep the input order, so a single thread can also use windows
+	const int windowsize = params.schedulewindow;
+	vector<ChainingTask*> window;
+	long seq = 0;
+	vector<std::pair<string,vector<string>>> groups;
+	for (int i = 0; i < partitions.size(); i++) {
+		if (!partitions.read(i, groups))
+			exit(1);
+		for (auto &group : groups) {
+			for (const string &line : group.second)
+				progress.inputbytes.fetch_add(line.size() + 1, std::memory_order_relaxed);
+			progress.inputwork.fetch_add(group.second.size(), std::memory_order_relaxed);
+			window.push_back(new ChainingTask {seq++, std::move(group.first), std::move(group.second), (tracer.enabled) ? tracer.now_us() : -1});
+			if (window.size() >= windowsize)
+				schedule_window(window, params);
+		}
+	}
+	schedule_window(window, params);
 	input_done = true;
 }
 
 void chain_worker(const Elasticfoundergraph &graph, unordered_map<string,vector<GAFHit>> &anchors, std::atomic<bool> &input_done, Params &params, vector<Stats> &stats, int statsindex)
 {
 	vector<GAFHit> matches;
-	string query;
+	std::pair<long,string> seqquery;
 	bool warning = false;
 	if (params.unsorted_anchors) {
-		while (anchorsqueue.try_dequeue(query)) {
+		while (anchorsqueue.try_dequeue(seqquery)) {
+			const string &query = seqquery.second;
+			StageTimer waittimer(statsindex, STAGE_OUTPUT);
+			wait_output_window(seqquery.first, params);
+			waittimer.end();
+			trace_read_begin(query);
+			StageTimer chaining(statsindex, STAGE_CHAINING);
 			stats[statsindex].reads += 1;
 			/*{
 			  std::scoped_lock lck {mutp};
@@ -118,6 +390,7 @@ void chain_worker(const Elasticfoundergraph &graph, unordered_map<string,vector<
 			//std::cerr << "Chaining for query " << anchorlist[0].get_query_id() << "..." << std::endl;
 			//anchorlist.push_back(dummy_start(anchorlist.at(0), graph)); // dummy start is already in the list
 			anchorlist.push_back(dummy_end(anchorlist.at(0), graph));
+			TraceSpan sortspan("sort");
 			if (!is_sorted(anchorlist)) {
 				if (!warning) {
 					std::cerr << "Anchors do not seem to be sorted by starting position in the query! Sorting...\n";
@@ -128,6 +401,7 @@ void chain_worker(const Elasticfoundergraph &graph, unordered_map<string,vector<
 						return (a1.get_query_start() < a2.get_query_start());
 						});
 			}
+			sortspan.end();
 
 #ifdef CHAINX_DEBUG
 			{
@@ -139,195 +413,325 @@ void chain_worker(const Elasticfoundergraph &graph, unordered_map<string,vector<
 			}
 #endif
 
-			vector<GAFHit> solution;
-			int initial_guess;
-			if (params.initialguesscov == 0) {
-				initial_guess = params.initialguess;
-			} else {
-				initial_guess = anchorlist.at(0).get_query_length() - (compute_coverage_greedy(anchorlist) * params.initialguesscov);
-			}
-			if (params.global) {
-				if (params.alternativealignments == 0) {
-					solution = chain_global_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats[statsindex]);
-				} else {
-					vector<GAFHit> chain;
-					for (int i = params.alternativealignments; i > 0; i--) {
-						chain = chain_global_eds(anchorlist, graph, initial_guess, params.rampupfactor,  stats[statsindex], true);
-						solution.reserve(solution.size() + chain.size());
-						move(chain.begin(), chain.end(), back_inserter(solution));
-						chain.clear();
-					}
-					chain = chain_global_eds(anchorlist, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-					solution.reserve(solution.size() + chain.size());
-					move(chain.begin(), chain.end(), back_inserter(solution));
-					//chain.clear();
-				}
-			} else if (params.semiglobal) {
-				if (params.alternativealignments == 0) {
-					solution = chain_semiglobal_eds(anchorlist, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-				} else {
-					vector<GAFHit> chain;
-					for (int i = params.alternativealignments; i > 0; i--) {
-						chain = chain_semiglobal_eds(anchorlist, graph, initial_guess, params.rampupfactor,  stats[statsindex], true);
-						solution.reserve(solution.size() + chain.size());
-						move(chain.begin(), chain.end(), back_inserter(solution));
-						chain.clear();
-					}
-					chain = chain_semiglobal_eds(anchorlist, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-					solution.reserve(solution.size() + chain.size());
-					move(chain.begin(), chain.end(), back_inserter(solution));
-					//chain.clear();
-				}
-			}
-			//std::cerr << "...done." << std::endl;
+			// the alternative chains and the prefilter remove anchors from anchorlist
+			vector<GAFHit> original;
+			if (params.deferred and removes_anchors(params))
+				original = anchorlist;
+			ChainBudget budget = read_budget(params);
+			vector<GAFHit> solution = chain_anchors(anchorlist, graph, params, stats[statsindex], budget);
+			if (params.deferred and budget.exceeded != BUDGET_OK)
+				defer_read(anchors_to_string(graph, (removes_anchors(params)) ? original : anchorlist, query), params);
 
-			bool reverse = false;
-			if (query.find("rev_") != std::string::npos) {
-				for (auto &a : solution)
-					a.reverse();
-				reverse = true;
-			}
-			if (params.nosplit) {
-				std::osyncstream ossoutput(params.outputfs);
-				for (auto &a : solution) {
-					string *ptr = new std::string(a.to_string(graph, (reverse) ? query.substr(4) : query));
-					while (!outputqueue.try_enqueue(ptr))
-						std::this_thread::sleep_for(std::chrono::milliseconds(10));
-				}
-			} else {
-				std::osyncstream ossoutput(params.outputfs);
-				for (auto &a : solution) {
-					if (params.splitgraphaligner) {
-						for (auto &b : a.split_single_graphaligner(graph)) {
-							string *ptr = new std::string(b.to_string(graph, (reverse) ? query.substr(4) : query));
-							while(!outputqueue.try_enqueue(ptr))
-								std::this_thread::sleep_for(std::chrono::milliseconds(10));
-						}
-					} else {
-						for (auto &b : a.split(graph)) {
-							string *ptr = new std::string(b.to_string(graph, (reverse) ? query.substr(4) : query));
-							while (!outputqueue.try_enqueue(ptr))
-								std::this_thread::sleep_for(std::chrono::milliseconds(10));
-						}
-					}
-				}
-			}
+			chaining.end();
+
+			// formatting is output time, not chaining time
+			StageTimer formatting(statsindex, STAGE_OUTPUT);
+			string *ptr = new std::string(chain_to_string(graph, solution, query, params));
+			formatting.end();
+			if (ptr->size() > 0 or params.orderedoutput)
+				enqueue_output(seqquery.first, ptr, params, statsindex);
+			else
+				delete(ptr);
+			progress.count_read(statsindex, anchorlist.at(0).get_query_length(), anchorlist.size() - 2);
+			trace_read_end();
 		}
 	} else {
 		//std::pair<string,vector<GAFHit>>* task;
-		std::pair<string,vector<string>>* task;
+		vector<ChainingTask*> tasks;
 		while (true) {
-			while (taskqueue.try_dequeue(task)) {
-				stats[statsindex].reads += 1;
-				vector<GAFHit> anchors;
-				//task->second.push_back(dummy_start(task->second.at(0), graph)); // BUG?
-				//task->second.push_back(dummy_end(task->second.at(0), graph));
-				string query = string(task->first);
-				istringstream dummyss(task->second.at(0));
-				anchors.push_back(dummy_start(GAFHit(dummyss, graph, query), graph));
-
-				for (string &line : task->second) {
-					istringstream ss(line);
-					anchors.push_back(GAFHit(ss, graph, query));
-				}
+			const bool finished = input_done;
+			while (scheduler.pop(statsindex, tasks)) {
+				for (ChainingTask *task : tasks) {
+					trace_read_begin(task->query, task->queued);
+					StageTimer chaining(statsindex, STAGE_CHAINING);
+					stats[statsindex].reads += 1;
+					TraceSpan parsespan("parse");
+					vector<GAFHit> anchors;
+					//task->second.push_back(dummy_start(task->second.at(0), graph)); // BUG?
+					//task->second.push_back(dummy_end(task->second.at(0), graph));
+					const string &query = task->query;
+					anchors.reserve(task->anchors.size() + 2);
+					string_view qname;
+					for (string &line : task->anchors)
+						anchors.push_back(GAFHit(line, graph, qname));
 
-				dummyss = istringstream(task->second.at(0));
-				anchors.push_back(dummy_end(GAFHit(dummyss, graph, query), graph));
-				stats[statsindex].seeds += anchors.size() - 2;
-				if (!is_sorted(anchors)) {
-					std::cerr << "Anchors do not seem to be sorted for read " << query << "...\nSorting...\n";
+					anchors.insert(anchors.begin(), dummy_start(anchors[0], graph));
+					anchors.push_back(dummy_end(anchors[0], graph));
+					stats[statsindex].seeds += anchors.size() - 2;
+					parsespan.end();
+					TraceSpan sortspan("sort");
+					if (!is_sorted(anchors)) {
+						std::cerr << "Anchors do not seem to be sorted for read " << query << "...\nSorting...\n";
+						std::sort(anchors.begin(), anchors.end(), [](GAFHit a1, GAFHit a2)
+								{
+								return (a1.get_query_start() < a2.get_query_start());
+								});
+					}
+					sortspan.end();
+
+					/*//std::sort(task->second.begin(), task->second.end(), [](GAFHit a1, GAFHit a2)
 					std::sort(anchors.begin(), anchors.end(), [](GAFHit a1, GAFHit a2)
 							{
 							return (a1.get_query_start() < a2.get_query_start());
-							});
-				}
+							});*/
 
-				/*//std::sort(task->second.begin(), task->second.end(), [](GAFHit a1, GAFHit a2)
-				std::sort(anchors.begin(), anchors.end(), [](GAFHit a1, GAFHit a2)
-						{
-						return (a1.get_query_start() < a2.get_query_start());
-						});*/
-
-				vector<GAFHit> solution;
-				int initial_guess;
-				if (params.initialguesscov == 0) {
-					initial_guess = params.initialguess;
-				} else {
-					initial_guess = anchors.at(0).get_query_length() - (compute_coverage_greedy(anchors) * params.initialguesscov);
-				}
-				if (params.global) {
-					if (params.alternativealignments == 0) {
-						solution = chain_global_eds(anchors, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-					} else {
-						vector<GAFHit> chain;
-						for (int i = params.alternativealignments; i > 0; i--) {
-							chain = chain_global_eds(anchors, graph, initial_guess, params.rampupfactor,  stats[statsindex], true);
-							solution.reserve(solution.size() + chain.size());
-							move(chain.begin(), chain.end(), back_inserter(solution));
-							chain.clear();
-						}
-						chain = chain_global_eds(anchors, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-						solution.reserve(solution.size() + chain.size());
-						move(chain.begin(), chain.end(), back_inserter(solution));
-						//chain.clear();
+					ChainBudget budget = read_budget(params);
+					vector<GAFHit> solution = chain_anchors(anchors, graph, params, stats[statsindex], budget);
+					if (params.deferred and budget.exceeded != BUDGET_OK) {
+						string lines;
+						for (const string &line : task->anchors)
+							lines += line + "\n";
+						defer_read(lines, params);
 					}
-				} else if (params.semiglobal) {
-					if (params.alternativealignments == 0) {
-						solution = chain_semiglobal_eds(anchors, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-					} else {
-						vector<GAFHit> chain;
-						for (int i = params.alternativealignments; i > 0; i--) {
-							chain = chain_semiglobal_eds(anchors, graph, initial_guess, params.rampupfactor,  stats[statsindex], true);
-							solution.reserve(solution.size() + chain.size());
-							move(chain.begin(), chain.end(), back_inserter(solution));
-							chain.clear();
-						}
-						chain = chain_semiglobal_eds(anchors, graph, initial_guess, params.rampupfactor,  stats[statsindex]);
-						solution.reserve(solution.size() + chain.size());
-						move(chain.begin(), chain.end(), back_inserter(solution));
-						//chain.clear();
-					}
-				}
-				//std::cerr << "...done." << std::endl;
 
-				bool reverse = false;
-				if (query.find("rev_") != std::string::npos) {
-					for (auto &a : solution)
-						a.reverse();
-					reverse = true;
-				}
-				if (params.nosplit) {
-					std::osyncstream ossoutput(params.outputfs);
-					for (auto &a : solution) {
-						string *ptr = new std::string(a.to_string(graph, (reverse) ? query.substr(4) : query));
-						while (!outputqueue.try_enqueue(ptr))
-							std::this_thread::sleep_for(std::chrono::milliseconds(10));
-					}
-				} else {
-					std::osyncstream ossoutput(params.outputfs);
-					for (auto &a : solution) {
-						if (params.splitgraphaligner) {
-							for (auto &b : a.split_single_graphaligner(graph)) {
-								string *ptr = new std::string(b.to_string(graph, (reverse) ? query.substr(4) : query));
-								while(!outputqueue.try_enqueue(ptr))
-									std::this_thread::sleep_for(std::chrono::milliseconds(10));
-							}
-						} else {
-							for (auto &b : a.split(graph)) {
-								string *ptr = new std::string(b.to_string(graph, (reverse) ? query.substr(4) : query));
-								while (!outputqueue.try_enqueue(ptr))
-									std::this_thread::sleep_for(std::chrono::milliseconds(10));
-							}
-						}
-					}
+					chaining.end();
+
+					// formatting is output time, not chaining time
+					StageTimer formatting(statsindex, STAGE_OUTPUT);
+					string *ptr = new std::string(chain_to_string(graph, solution, query, params));
+					formatting.end();
+					if (ptr->size() > 0 or params.orderedoutput)
+						enqueue_output(task->seq, ptr, params, statsindex);
+					else
+						delete(ptr);
+					delete(task);
+					progress.count_read(statsindex, anchors.at(0).get_query_length(), anchors.size() - 2);
+					trace_read_end();
 				}
-				delete(task);
+				scheduler.task_done(statsindex);
 			}
-			if (input_done)
+			if (finished)
 				break;
 			else
 				std::this_thread::sleep_for(std::chrono::milliseconds(10));
 		}
+		scheduler.worker_exit(statsindex);
+	}
+}
+
+// with --seed-reads, read the reads in windows scheduled longest first, as efg-locate does
+void seed_reader_worker(std::ifstream &readsfs, std::atomic<bool> &input_done, Params &params, const long taskbases)
+{
+	// a single thread keeps the input order; with --ordered-output, a window
+	// cannot exceed the reorder window
+	int windowsize = (params.threads <= 1) ? 1 : params.schedulewindow;
+	if (params.orderedoutput)
+		windowsize = std::min(windowsize, params.orderedoutputwindow);
+	efg_locate::read_pattern_windows(readsfs, windowsize, [&params, taskbases](vector<efg_locate::InputPattern> &window) {
+		if (window.size() == 0)
+			return;
+		wait_output_window(window.back().seq, params);
+		efg_locate::schedule_longest_first(window, readscheduler, taskbases);
+	});
+	input_done = true;
+}
+
+/*
+ * with --seed-reads, seed each read as efg-locate --approximate does (see
+ * approx_worker in efg-locate) and chain right away the seeds of the read and
+ * of its reverse complement (query rev_ID), converted to anchors in memory;
+ * the reads are numbered and scheduled as in efg-locate (see
+ * seed_reader_worker) and the chains go to the writer of the sorted input
+ */
+void seed_chain_worker(const efg_locate::Elasticfoundergraph &locategraph, efg_locate::Params &locateparams, const Elasticfoundergraph &graph, std::atomic<bool> &input_done, Params &params, vector<Stats> &stats, int statsindex)
+{
+	vector<efg_locate::GAFAnchor> matches;
+	while (true) {
+		const bool finished = input_done;
+		vector<efg_locate::InputPattern> task;
+		while (readscheduler.pop(statsindex, task)) {
+			for (efg_locate::InputPattern &p : task) {
+				trace_read_begin(p.id, p.queued);
+				StageTimer seeding(statsindex, STAGE_SEEDING);
+				TraceSpan seedspan("seeding");
+				const int found = efg_locate::approx_efg_backward_search(locategraph, p.id, p.sequence, locateparams, matches);
+				seedspan.end();
+				seeding.end();
+				if (found == 0)
+					matches.clear();
+
+				// the forward seeds come first, then those of the reverse complement
+				string *ptr = new std::string();
+				for (int first = 0, last; first < matches.size(); first = last) {
+					StageTimer chaining(statsindex, STAGE_CHAINING);
+					const string query = matches[first].get_query_id();
+					for (last = first + 1; last < matches.size() and matches[last].get_query_id() == query; last++);
+					stats[statsindex].reads += 1;
+					stats[statsindex].seeds += last - first;
+					vector<GAFHit> anchors;
+					anchors.reserve(last - first + 2);
+					for (int i = first; i < last; i++) {
+						const efg_locate::GAFAnchor &m = matches[i];
+						anchors.push_back(GAFHit(m.get_query_length(), m.get_query_start(), m.get_query_end(), m.get_path(), m.get_path_bases(), m.get_path_start(), m.get_path_end()));
+					}
+					anchors.insert(anchors.begin(), dummy_start(anchors[0], graph));
+					anchors.push_back(dummy_end(anchors[0], graph));
+					if (!is_sorted(anchors)) {
+						TraceSpan sortspan("sort");
+						std::stable_sort(anchors.begin(), anchors.end(), [](const GAFHit &a1, const GAFHit &a2)
+								{
+								return (a1.get_query_start() < a2.get_query_start());
+								});
+					}
+
+					vector<GAFHit> original;
+					if (params.deferred and removes_anchors(params))
+						original = anchors;
+					ChainBudget budget = read_budget(params);
+					vector<GAFHit> solution = chain_anchors(anchors, graph, params, stats[statsindex], budget);
+					if (params.deferred and budget.exceeded != BUDGET_OK)
+						defer_read(anchors_to_string(graph, (removes_anchors(params)) ? original : anchors, query), params);
+					chaining.end();
+
+					// formatting is output time, not chaining time
+					StageTimer formatting(statsindex, STAGE_OUTPUT);
+					*ptr += chain_to_string(graph, solution, query, params);
+				}
+				if (found == 0)
+					std::osyncstream(cerr) << "Cannot find any semi-repeat-free match of " << p.id << "\n";
+				if (ptr->size() > 0 or params.orderedoutput)
+					enqueue_output(p.seq, ptr, params, statsindex);
+				else
+					delete(ptr);
+				progress.count_read(statsindex, p.sequence.size(), matches.size());
+				trace_read_end();
+			}
+			readscheduler.task_done(statsindex);
+		}
+		if (finished)
+			break;
+		else
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	readscheduler.worker_exit(statsindex);
+}
+
+/*
+ * with --chain-on-graph, whether the graph distances fit in
+ * --graph-distance-memory, estimated before building them; if not, the
+ * chaining falls back to the distances on the EDS
+ */
+bool graph_distances_fit(const Elasticfoundergraph &graph, const Params &params)
+{
+	if (!params.chainongraph)
+		return false;
+	const long bytes = graph.estimate_distances_size_in_bytes();
+	if (params.graphdistancememory == 0 or bytes <= params.graphdistancememory * 1048576)
+		return true;
+	std::cerr << " the graph distances would take " << bytes / 1048576 << " MB, more than --graph-distance-memory " << params.graphdistancememory << ": chaining on the EDS instead..." << std::flush;
+	return false;
+}
+
+/*
+ * --seed-reads: parse the graph once for efg-locate, index it and build the
+ * chaining graph from it, then seed and chain the reads with params.threads
+ * threads, each one doing both (see seed_chain_worker)
+ */
+Stats seed_and_chain(Params &params, const std::filesystem::path &readspath, const double progressinterval, const std::filesystem::path &statusfile)
+{
+	// the seeding options of efg-locate, the output options are those of params
+	efg_locate::Params locateparams;
+	locateparams.ignorechars = params.ignorechars;
+	locateparams.reversecompl = true;
+	locateparams.renamereversecomplement = true;
+	locateparams.threads = params.threads;
+	locateparams.mincoverage = 0;
+	locateparams.reportstats = false;
+	locateparams.splitoutputmatches = false;
+	locateparams.splitoutputmatchesgraphaligner = false;
+	locateparams.splitkeepedgematches = false;
+	locateparams.edgemincount = params.edgemincount;
+	locateparams.edgelongestcount = params.edgelongestcount;
+	locateparams.edgelongestcountmax = params.edgelongestcountmax;
+	locateparams.windowlength = 0;
+	locateparams.windowoverlap = 0;
+	locateparams.windowthreads = 1;
+	locateparams.schedulewindow = params.schedulewindow;
+	locateparams.taskbases = 50000;
+	locateparams.orderedoutput = false;
+	locateparams.orderedoutputwindow = 1;
+	locateparams.shardedoutput = false;
+	locateparams.numapin = false;
+	locateparams.numareplicate = false;
+
+	std::cerr << "Reading the graph..." << std::flush;
+	efg_locate::Elasticfoundergraph locategraph(params.graphfs);
+	// before indexing, which adds a supersource to the graph of efg-locate
+	Elasticfoundergraph graph(locategraph.get_rows(), locategraph.get_columns(), locategraph.get_cuts(), locategraph.get_heights(), locategraph.get_ids(), locategraph.get_labels(), locategraph.get_edges());
+	std::cerr << " done." << std::endl;
+
+	std::cerr << "Indexing the graph..." << std::flush;
+	locategraph.init_pattern_matching_support();
+	params.chainongraph = graph_distances_fit(graph, params);
+	graph.init_eds_support(params.chainongraph);
+	if (params.chainongraph)
+		std::cerr << " done (graph distances in " << std::fixed << std::setprecision(1) << graph.distances_size_in_bytes() / 1048576.0 << std::defaultfloat << " MB)." << std::endl;
+	else
+		std::cerr << " done." << std::endl;
+
+	// progress reporting, see progress.hpp
+	progress.init(params.threads);
+	std::error_code ec;
+	progress.totalbytes = std::filesystem::is_regular_file(readspath, ec) ? std::filesystem::file_size(readspath, ec) : 0;
+	progress.add_queue("input", []() { return readscheduler.get_queued(); });
+	progress.add_queue("output", []() { return (long)outputqueue.size_approx(); });
+	if (progressinterval > 0)
+		progress.start_reporting(progressinterval, statusfile);
+
+	std::atomic<bool> input_done = false, workers_done = false;
+	readscheduler.init(params.threads, 4 * params.threads + 16);
+	std::thread inputworker(seed_reader_worker, std::ref(params.readsfs), std::ref(input_done), std::ref(params), locateparams.taskbases);
+	std::thread outputworker(writer_worker, std::ref(input_done), std::ref(workers_done), std::ref(params));
+	vector<std::thread> workers;
+	vector<Stats> workerstats(params.threads);
+	for (int i = 0; i < params.threads; i++)
+		workers.push_back(std::thread(seed_chain_worker, std::ref(locategraph), std::ref(locateparams), std::ref(graph), std::ref(input_done), std::ref(params), std::ref(workerstats), i));
+	for (int i = 0; i < workers.size(); i++)
+		workers[i].join();
+	progress.stop();
+	workers_done = true;
+	inputworker.join();
+	std::cerr << "tail time is " << readscheduler.tail_time() << " s (" << readscheduler.get_steals() << " tasks stolen)" << std::endl;
+	outputworker.join();
+	// sanity check?
+	outputworker = std::thread(writer_worker, std::ref(input_done), std::ref(workers_done), std::ref(params));
+	outputworker.join();
+
+	Stats stats;
+	for (const Stats &s : workerstats)
+		stats = mergestats(stats, s);
+	return stats;
+}
+
+// final statistics on stderr, and the trace file
+void report(const Stats &stats, const Params &params, const gengetopt_args_info &argsinfo, std::ofstream &tracefs)
+{
+	progress.report_utilisation(std::cerr);
+	std::cerr << "chained " << stats.seeds << " seeds for " << stats.reads << " reads\n";
+	std::cerr << "min number of revisions is " << stats.miniterations << "\n";
+	std::cerr << "max number of revisions is " << stats.maxiterations << "\n";
+	std::cerr << "average number of revisions is " << (double)stats.totaliterations / stats.reads << "\n";
+	std::cerr << "min chaining cost is " << stats.mincost << "\n";
+	std::cerr << "max chaining cost is " << stats.maxcost << "\n";
+	std::cerr << "average chaining cost is " << (double)stats.totalcost / stats.reads << "\n";
+	std::cerr << "min relative chaining cost is " << stats.minrelativecost << "\n";
+	std::cerr << "max relative chaining cost is " << stats.maxrelativecost << "\n";
+	std::cerr << "average relative chaining cost is " << (double)stats.totalrelativecost / stats.reads << "\n";
+	std::cerr << "examined " << stats.anchorpairs << " anchor pairs, " << stats.prunedpairs << " of them pruned by a lower bound on their cost (" << stats.prunedbuckets << " buckets of predecessors skipped)\n";
+	if (params.prefilter or params.minclusterscore > 0) {
+		std::cerr << "removed " << stats.duplicateanchors + stats.dominatedanchors + stats.clusteredanchors << " anchors before chaining (";
+		std::cerr << stats.duplicateanchors << " duplicate, " << stats.dominatedanchors << " dominated, " << stats.clusteredanchors << " in weak clusters)\n";
+	}
+	if (params.maxrevisions > 0 or params.maxanchorpairs > 0 or params.readtimeout > 0) {
+		std::cerr << stats.budgetrevisions + stats.budgetpairs + stats.budgettime << " reads exceeded the chaining budget (";
+		std::cerr << stats.budgetrevisions << " revisions, " << stats.budgetpairs << " anchor pairs, " << stats.budgettime << " time)";
+		if (params.deferred)
+			std::cerr << ", their anchors are in " << argsinfo.deferred_arg;
+		std::cerr << "\n";
+	}
+	if (argsinfo.trace_given) {
+		tracer.write(tracefs);
+		std::cerr << "traced " << tracer.get_traced_reads() << " reads\n";
 	}
 }
 
@@ -351,11 +755,39 @@ int main(int argc, char* argv[])
 	params.semiglobal = argsinfo.semi_global_flag;
 	params.nosplit = argsinfo.no_split_output_matches_flag;
 	params.unsorted_anchors = argsinfo.unsorted_input_flag;
+	params.partitionmemory = std::max(0L, argsinfo.partition_memory_arg) * 1024 * 1024;
+	params.partitioned = false;
 	params.splitgraphaligner = argsinfo.split_output_matches_graphaligner_flag;
 	params.alternativealignments = argsinfo.alternative_chains_arg;
+	params.singlepassalternatives = argsinfo.single_pass_alternatives_flag;
 	params.initialguess = argsinfo.initial_guess_arg;
 	params.initialguesscov = argsinfo.initial_guess_coverage_arg;
 	params.rampupfactor = argsinfo.ramp_up_factor_arg;
+	params.schedulewindow = std::max(1, argsinfo.schedule_window_arg);
+	params.taskanchors = argsinfo.task_anchors_arg;
+	params.parallelanchors = std::max(0L, argsinfo.parallel_chaining_anchors_arg);
+	params.orderedoutput = argsinfo.ordered_output_flag;
+	params.orderedoutputwindow = std::max(1L, argsinfo.ordered_output_window_arg);
+	params.shardedoutput = argsinfo.sharded_output_flag;
+	params.numapin = argsinfo.numa_pin_flag or argsinfo.numa_replicate_flag;
+	params.numareplicate = argsinfo.numa_replicate_flag;
+	params.maxrevisions = std::max(0, argsinfo.max_revisions_arg);
+	params.maxanchorpairs = std::max(0L, argsinfo.max_anchor_pairs_arg);
+	params.readtimeout = std::max(0.0, argsinfo.read_timeout_arg);
+	params.deferred = argsinfo.deferred_given;
+	params.rmqchaining = (string(argsinfo.chaining_engine_arg) == "rmq");
+	params.chainongraph = argsinfo.chain_on_graph_flag;
+	params.graphdistancememory = std::max(0L, argsinfo.graph_distance_memory_arg);
+	params.prefilter = argsinfo.prefilter_flag;
+	params.minclusterscore = std::max(0L, argsinfo.min_cluster_score_arg);
+	params.clusterband = std::max(1L, argsinfo.cluster_band_arg);
+	params.clustermaxgap = std::max(0L, argsinfo.cluster_max_gap_arg);
+	params.seedreads = argsinfo.seed_reads_flag;
+	params.edgemincount = std::max(0, argsinfo.approximate_edge_match_min_count_arg);
+	params.edgelongestcount = std::max(0, argsinfo.approximate_edge_match_longest_arg);
+	params.edgelongestcountmax = std::max(0, argsinfo.approximate_edge_match_longest_max_count_arg);
+	if (argsinfo.ignore_chars_given)
+		params.ignorechars = argsinfo.ignore_chars_arg;
 
 	Stats stats;
 
@@ -363,7 +795,18 @@ int main(int argc, char* argv[])
 		{std::cerr << argv[0] << ": select mode (global or semiglobal)" << std::endl; exit(1);};
 	if (params.global and params.semiglobal)
 		{std::cerr << argv[0] << ": select only one mode (global or semiglobal)" << std::endl; exit(1);};
-	// TODO check ramp-up factor
+	if (params.orderedoutput and params.shardedoutput)
+		{std::cerr << argv[0] << ": --ordered-output and --sharded-output are incompatible" << std::endl; exit(1);};
+	if (params.partitionmemory > 0 and (!params.unsorted_anchors or params.threads == -1 or params.orderedoutput))
+		{std::cerr << argv[0] << ": --partition-memory needs --unsorted-input and --threads, and is incompatible with --ordered-output" << std::endl; exit(1);};
+	if (string(argsinfo.chaining_engine_arg) != "dp" and string(argsinfo.chaining_engine_arg) != "rmq")
+		{std::cerr << argv[0] << ": unknown chaining engine " << argsinfo.chaining_engine_arg << " (dp or rmq)" << std::endl; exit(1);};
+	if (params.chainongraph and params.rmqchaining)
+		{std::cerr << argv[0] << ": --chain-on-graph needs --chaining-engine dp" << std::endl; exit(1);};
+	if (params.seedreads and (params.threads < 1 or params.unsorted_anchors or params.partitionmemory > 0 or params.numapin))
+		{std::cerr << argv[0] << ": --seed-reads needs --threads, and is incompatible with --unsorted-input, --partition-memory and --numa-pin" << std::endl; exit(1);};
+	if (params.rampupfactor <= 1)
+		{std::cerr << argv[0] << ": --ramp-up-factor must be larger than 1" << std::endl; exit(1);};
 
 	// open files
 	std::filesystem::path graphpath {argsinfo.inputs[0]};
@@ -371,8 +814,18 @@ int main(int argc, char* argv[])
 	if (!params.graphfs) {std::cerr << "Error opening graph file " << graphpath << "." << std::endl; exit(1);};
 
 	std::filesystem::path anchorspath {argsinfo.inputs[1]};
-	params.anchorsfs = std::ifstream {anchorspath};
-	if (!params.anchorsfs) {std::cerr << "Error opening anchors file " << anchorspath << "." << std::endl; exit(1);};
+	vector<std::filesystem::path> anchorspaths;
+	if (params.seedreads) {
+		params.readsfs = std::ifstream {anchorspath};
+		if (!params.readsfs) {std::cerr << "Error opening reads file " << anchorspath << "." << std::endl; exit(1);};
+	} else {
+		anchorspaths = read_shard_manifest(anchorspath);
+		if (anchorspaths.size() == 0) {std::cerr << "Error: no shards in anchors manifest " << anchorspath << "." << std::endl; exit(1);};
+	}
+	for (const std::filesystem::path &p : anchorspaths) {
+		params.anchorsfs.push_back(std::ifstream {p});
+		if (!params.anchorsfs.back()) {std::cerr << "Error opening anchors file " << p << "." << std::endl; exit(1);};
+	}
 
 	// check and open output file
 	std::filesystem::path outputpath {argsinfo.inputs[2]};
@@ -387,14 +840,59 @@ int main(int argc, char* argv[])
 		params.outputfs = std::ofstream(outputpath);
 	}
 	if (!params.outputfs) {std::cerr << "Error opening output file " << outputpath << "." << std::endl; exit(1);};
+	if (params.shardedoutput) {
+		if (!open_shards(outputpath, std::max(1, params.threads), argsinfo.overwrite_flag, params.shardfs))
+			exit(1);
+		write_shard_manifest(params.outputfs, outputpath, params.shardfs.size());
+	}
+
+	// open deferred reads file, see ChainBudget
+	if (params.deferred) {
+		params.deferredfs = std::ofstream(argsinfo.deferred_arg, std::ios::out | std::ios::trunc);
+		if (!params.deferredfs) {std::cerr << "Error opening deferred reads file " << argsinfo.deferred_arg << "." << std::endl; exit(1);};
+	}
+
+	// open trace file, see trace.hpp
+	std::ofstream tracefs;
+	if (argsinfo.trace_given) {
+		tracefs = std::ofstream(argsinfo.trace_arg, std::ios::out | std::ios::trunc);
+		if (!tracefs) {std::cerr << "Error opening trace file " << argsinfo.trace_arg << "." << std::endl; exit(1);};
+		tracer.init(argsinfo.trace_threshold_arg);
+	}
+
+	if (params.seedreads) {
+		stats = seed_and_chain(params, anchorspath, argsinfo.progress_interval_arg, (argsinfo.status_file_given) ? argsinfo.status_file_arg : "");
+		report(stats, params, argsinfo, tracefs);
+		return 0;
+	}
 
 	std::cerr << "Reading the graph..." << std::flush;
 	Elasticfoundergraph graph(params.graphfs);
 	std::cerr << " done." << std::endl;
 
 	std::cerr << "Indexing the graph..." << std::flush;
-	graph.init_eds_support();
-	std::cerr << " done." << std::endl;
+	params.chainongraph = graph_distances_fit(graph, params);
+	graph.init_eds_support(params.chainongraph);
+	if (params.chainongraph)
+		std::cerr << " done (graph distances in " << std::fixed << std::setprecision(1) << graph.distances_size_in_bytes() / 1048576.0 << std::defaultfloat << " MB)." << std::endl;
+	else
+		std::cerr << " done." << std::endl;
+
+	// group the unsorted anchors on disk, then chain them as sorted anchors
+	AnchorPartitions partitions;
+	if (params.unsorted_anchors and params.partitionmemory > 0) {
+		long totalbytes = 0;
+		for (const std::filesystem::path &p : anchorspaths) {
+			std::error_code ec;
+			totalbytes += std::filesystem::is_regular_file(p, ec) ? std::filesystem::file_size(p, ec) : 0;
+		}
+		std::cerr << "Partitioning the anchors..." << std::flush;
+		if (!partitions.write(params.anchorsfs, totalbytes, params.partitionmemory, outputpath))
+			exit(1);
+		std::cerr << " done (" << partitions.size() << " partitions)." << std::endl;
+		params.unsorted_anchors = false;
+		params.partitioned = true;
+	}
 
 	std::unordered_map<string,vector<GAFHit>> anchors; 
 	if (params.unsorted_anchors) {
@@ -420,6 +918,24 @@ int main(int argc, char* argv[])
 	}
 
 
+	// progress reporting, see progress.hpp
+	progress.init(std::max(1, params.threads));
+	progress.seedwork = true;
+	for (const std::filesystem::path &p : anchorspaths) {
+		std::error_code ec;
+		progress.totalbytes += std::filesystem::is_regular_file(p, ec) ? std::filesystem::file_size(p, ec) : 0;
+	}
+	if (params.unsorted_anchors) {
+		progress.totalreads = anchors.size();
+		if (params.threads != -1)
+			progress.add_queue("input", []() { return (long)anchorsqueue.size_approx(); });
+	} else {
+		progress.add_queue("input", []() { return scheduler.get_queued(); });
+	}
+	progress.add_queue("output", []() { return (long)outputqueue.size_approx(); });
+	if (argsinfo.progress_interval_arg > 0)
+		progress.start_reporting(argsinfo.progress_interval_arg, (argsinfo.status_file_given) ? argsinfo.status_file_arg : "");
+
 	if (params.threads == -1) {
 		if (!params.unsorted_anchors) {
 			std::cerr << "Mode not implemented yet! Try --unsorted_input flag." << std::endl;
@@ -428,6 +944,7 @@ int main(int argc, char* argv[])
 		for (auto &bucket : anchors) {
 			const string &query = bucket.first;
 			vector<GAFHit> &anchorlist = bucket.second;
+			trace_read_begin(query);
 			//std::cerr << "Chaining for query " << query << "..." << std::endl;
 			anchorlist.push_back(dummy_end(anchorlist[0], graph));
 			std::sort(anchorlist.begin(), anchorlist.end(), [](GAFHit a1, GAFHit a2)
@@ -442,106 +959,83 @@ int main(int argc, char* argv[])
 			std::cerr << std::endl;
 #endif
 
-			vector<GAFHit> solution;
-			int initial_guess;
-			if (params.initialguesscov == 0) {
-				initial_guess = params.initialguess;
-			} else {
-				initial_guess = anchorlist.at(0).get_query_length() - (compute_coverage_greedy(anchorlist) * params.initialguesscov);
-			}
-			if (params.global) {
-				if (params.alternativealignments == 0) {
-					solution = chain_global_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats);
-				} else {
-					vector<GAFHit> chain;
-					for (int i = params.alternativealignments; i > 0; i--) {
-						chain = chain_global_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats, true);
-						solution.reserve(solution.size() + chain.size());
-						move(chain.begin(), chain.end(), back_inserter(solution));
-						chain.clear();
-					}
-					chain = chain_global_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats);
-					solution.reserve(solution.size() + chain.size());
-					move(chain.begin(), chain.end(), back_inserter(solution));
-					//chain.clear();
-				}
-			} else if (params.semiglobal) {
-				if (params.alternativealignments == 0) {
-					solution = chain_semiglobal_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats);
-				} else {
-					vector<GAFHit> chain;
-					for (int i = params.alternativealignments; i > 0; i--) {
-						chain = chain_semiglobal_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats, true);
-						solution.reserve(solution.size() + chain.size());
-						move(chain.begin(), chain.end(), back_inserter(solution));
-						chain.clear();
-					}
-					chain = chain_semiglobal_eds(anchorlist, graph, initial_guess, params.rampupfactor, stats);
-					solution.reserve(solution.size() + chain.size());
-					move(chain.begin(), chain.end(), back_inserter(solution));
-					//chain.clear();
-				}
-			}
-			//std::cerr << "...done." << std::endl;
+			vector<GAFHit> original;
+			if (params.deferred and removes_anchors(params))
+				original = anchorlist;
+			ChainBudget budget = read_budget(params);
+			vector<GAFHit> solution = chain_anchors(anchorlist, graph, params, stats, budget);
+			if (params.deferred and budget.exceeded != BUDGET_OK)
+				defer_read(anchors_to_string(graph, (removes_anchors(params)) ? original : anchorlist, query), params);
 
-			bool reverse = false;
-			if (query.find("rev_") != std::string::npos) {
-				for (auto &a : solution)
-					a.reverse();
-				reverse = true;
-			}
-			if (params.nosplit) {
-				for (auto &a : solution)
-					params.outputfs << a.to_string(graph, (reverse) ? query.substr(4) : query) << std::endl;
-			} else {
-				for (auto &a : solution) {
-					if (params.splitgraphaligner) {
-						for (auto &b : a.split_single_graphaligner(graph))
-							params.outputfs << b.to_string(graph, (reverse) ? query.substr(4) : query) << std::endl;
-					} else {
-						for (auto &b : a.split(graph))
-							params.outputfs << b.to_string(graph, (reverse) ? query.substr(4) : query) << std::endl;
-					}
-				}
-			}
+			((params.shardedoutput) ? params.shardfs[0] : params.outputfs) << chain_to_string(graph, solution, query, params);
+			progress.count_read(0, anchorlist.at(0).get_query_length(), anchorlist.size() - 2);
+			trace_read_end();
 		}
+		progress.stop();
 	} else {
 		std::atomic<bool> workers_done = false;
 		std::atomic<bool> input_done = params.unsorted_anchors ? true : false;
-		std::thread inputworker;
-		if (!params.unsorted_anchors) {
-			inputworker = std::thread(reader_worker, std::ref(graph), std::ref(input_done), std::ref(params));
+		vector<std::thread> inputworkers;
+		// --threads 0 (or below -1) still needs a chaining thread
+		const int workernum = std::max(1, params.threads);
+		scheduler.init(workernum, 4 * workernum + 16);
+		// the sequence numbers of --ordered-output need a single reader
+		std::atomic<int> readers = (params.orderedoutput) ? 1 : params.anchorsfs.size();
+		if (params.partitioned) {
+			inputworkers.push_back(std::thread(partition_worker, std::ref(partitions), std::ref(input_done), std::ref(params)));
+		} else if (!params.unsorted_anchors) {
+			vector<std::ifstream*> anchorsfs;
+			for (std::ifstream &fs : params.anchorsfs)
+				anchorsfs.push_back(&fs);
+			if (params.orderedoutput) {
+				inputworkers.push_back(std::thread(reader_worker, std::ref(graph), anchorsfs, std::ref(readers), std::ref(input_done), std::ref(params)));
+			} else {
+				for (std::ifstream *fs : anchorsfs)
+					inputworkers.push_back(std::thread(reader_worker, std::ref(graph), vector<std::ifstream*>({fs}), std::ref(readers), std::ref(input_done), std::ref(params)));
+			}
 		}
 		std::thread outputworker(writer_worker, std::ref(input_done), std::ref(workers_done), std::ref(params));
 		vector<std::thread> workers;
-		vector<Stats> workerstats(params.threads);
-		for (int i = 0; i < params.threads; i++) {
-			workers.push_back(std::thread(chain_worker, std::ref(graph), std::ref(anchors), std::ref(input_done), std::ref(params), std::ref(workerstats), i));
+		vector<Stats> workerstats(workernum);
+		// NUMA placement of the threads, see numa.hpp
+		vector<vector<int>> numanodes;
+		vector<std::unique_ptr<Elasticfoundergraph>> replicas;
+		if (params.numapin) {
+			numanodes = numa_nodes_cpus();
+			if (numanodes.size() == 0)
+				std::cerr << "Warning: cannot read the NUMA topology, threads are not pinned." << std::endl;
+			else
+				std::cerr << "Pinning the threads to " << numanodes.size() << " NUMA node(s)." << std::endl;
+			if (numanodes.size() > 0 and params.numareplicate) {
+				std::cerr << "Replicating the graph on each NUMA node..." << std::flush;
+				replicas = replicate_on_nodes(graph, numanodes);
+				std::cerr << " done." << std::endl;
+			}
+		}
+		for (int i = 0; i < workernum; i++) {
+			const Elasticfoundergraph &g = (replicas.size() > 0) ? *replicas[i % replicas.size()] : graph;
+			workers.push_back(std::thread(chain_worker, std::ref(g), std::ref(anchors), std::ref(input_done), std::ref(params), std::ref(workerstats), i));
+			if (numanodes.size() > 0)
+				pin_thread(workers.back().native_handle(), numanodes[i % numanodes.size()]);
 		}
 		for (int i = 0; i < workers.size(); i++)
 			workers[i].join();
+		progress.stop();
 		workers_done = true;
 
 		for (const Stats &s : workerstats) {
 			stats = mergestats(stats, s);
 		}
 
+		for (std::thread &t : inputworkers)
+			t.join();
 		if (!params.unsorted_anchors)
-			inputworker.join();
+			std::cerr << "tail time is " << scheduler.tail_time() << " s (" << scheduler.get_steals() << " tasks stolen)" << std::endl;
 		outputworker.join();
 		// sanity check?
 		outputworker = std::thread(writer_worker, std::ref(input_done), std::ref(workers_done), std::ref(params));
 		outputworker.join();
 	}
 
-	std::cerr << "chained " << stats.seeds << " seeds for " << stats.reads << " reads\n";
-	std::cerr << "min number of revisions is " << stats.miniterations << "\n";
-	std::cerr << "max number of revisions is " << stats.maxiterations << "\n";
-	std::cerr << "average number of revisions is " << (double)stats.totaliterations / stats.reads << "\n";
-	std::cerr << "min chaining cost is " << stats.mincost << "\n";
-	std::cerr << "max chaining cost is " << stats.maxcost << "\n";
-	std::cerr << "average chaining cost is " << (double)stats.totalcost / stats.reads << "\n";
-	std::cerr << "min relative chaining cost is " << stats.minrelativecost << "\n";
-	std::cerr << "max relative chaining cost is " << stats.maxrelativecost << "\n";
-	std::cerr << "average relative chaining cost is " << (double)stats.totalrelativecost / stats.reads << "\n";
+	report(stats, params, argsinfo, tracefs);
 }
@@ -4,25 +4,104 @@
 #include <iostream>
 #include <fstream>
 #include <limits>
+#include <vector>
+#include <chrono>
+#include <string_view>
+#include <unordered_set>
+#include <deque>
 
-using std::string, std::ifstream, std::ofstream;
+using std::string, std::ifstream, std::ofstream, std::vector;
+
+// headers shared with efg-locate, see ../common
+namespace efg_common {}
 
 namespace chainx_block_graph {
+using namespace efg_common;
+
 struct Params {
 	ifstream graphfs;
-	ifstream anchorsfs;
+	vector<ifstream> anchorsfs; // one per input shard
 	ofstream outputfs;
 	string ignorechars;
 	bool unsorted_anchors;
+	long partitionmemory; // bytes, with --unsorted-input, see partitions.hpp
+	bool partitioned; // the unsorted anchors are grouped in partitions on disk
 	bool global;
 	bool semiglobal;
 	bool nosplit;
 	bool splitgraphaligner;
 	int threads;
 	int alternativealignments;
+	bool singlepassalternatives; // backtrack the alternative chains from the DP of the first one
 	int initialguess;
 	double initialguesscov;
 	double rampupfactor;
+	bool rmqchaining; // --chaining-engine rmq, see chaining-rmq.hpp
+	bool chainongraph; // exact graph distances, see graph-distance.hpp
+	long graphdistancememory; // MB, bound on the memory of the graph distances (0 for none)
+	bool prefilter; // remove duplicate and dominated anchors, see prefilter.hpp
+	long minclusterscore; // remove the weaker diagonal clusters, 0 for never
+	long clusterband;
+	long clustermaxgap;
+	int schedulewindow;
+	long parallelanchors; // queries with at least as many anchors are chained with all the threads, 0 for never
+	long taskanchors;
+	bool orderedoutput;
+	int orderedoutputwindow;
+	bool shardedoutput;
+	vector<ofstream> shardfs; // with --sharded-output, one per thread
+	bool numapin;
+	bool numareplicate;
+	int maxrevisions; // per-read budget, 0 for no limit
+	long maxanchorpairs;
+	double readtimeout; // milliseconds
+	bool deferred;
+	ofstream deferredfs; // with --deferred, anchors of the reads exceeding the budget
+	bool seedreads; // seed the reads in input with efg-locate, see seed_chain_worker
+	ifstream readsfs;
+	int edgemincount; // seeding options of efg-locate
+	int edgelongestcount;
+	int edgelongestcountmax;
+};
+
+// anchors (GAF lines) of one query, numbered by the position of the query in the input
+struct ChainingTask {
+	long seq;
+	string query;
+	vector<string> anchors;
+	double queued; // time of reading in microseconds, with --trace (see trace.hpp)
+};
+
+/*
+ * queries read so far by a reader, to detect unsorted anchors: only the
+ * names of the last SORTED_CHECK_QUERIES queries are kept, so that the
+ * memory does not grow with the input, and a query repeated after more
+ * queries than that is not detected (see --help)
+ */
+const int SORTED_CHECK_QUERIES = 1 << 20;
+
+class RecentQueries {
+	private:
+		std::deque<string> order; // owns the names, which a deque does not move
+		std::unordered_set<std::string_view> names; // views of the names in order
+
+	public:
+		bool contains(std::string_view query) const
+		{
+			return names.contains(query);
+		}
+
+		void insert(std::string_view query)
+		{
+			if (names.contains(query))
+				return;
+			order.push_back(string(query));
+			names.insert(order.back());
+			if (order.size() > SORTED_CHECK_QUERIES) {
+				names.erase(order.front());
+				order.pop_front();
+			}
+		}
 };
 
 struct Stats {
@@ -39,6 +118,36 @@ struct Stats {
 	double maxrelativecost = 0;
 	double minrelativecost = std::numeric_limits<double>::max();
 	double totalrelativecost = 0;
+
+	unsigned long long budgetrevisions = 0; // reads exceeding --max-revisions
+	unsigned long long budgetpairs = 0; // reads exceeding --max-anchor-pairs
+	unsigned long long budgettime = 0; // reads exceeding --read-timeout
+
+	unsigned long long anchorpairs = 0; // anchor pairs examined by the chaining
+	unsigned long long prunedpairs = 0; // of which skipped by a lower bound on their cost
+	unsigned long long prunedbuckets = 0; // buckets of predecessors skipped by the dp engine
+
+	unsigned long long duplicateanchors = 0; // removed before chaining, see prefilter.hpp
+	unsigned long long dominatedanchors = 0;
+	unsigned long long clusteredanchors = 0;
+};
+
+enum BudgetExceeded { BUDGET_OK = 0, BUDGET_REVISIONS, BUDGET_PAIRS, BUDGET_TIME };
+
+/*
+ * work budget of the chaining of one read: at most maxrevisions revisions of
+ * the ramp-up of each chaining, at most maxpairs anchor pairs examined by the
+ * DP over all the chainings of the read, and a deadline; 0 for no limit
+ */
+struct ChainBudget {
+	int maxrevisions = 0;
+	long maxpairs = 0;
+	bool hasdeadline = false;
+	std::chrono::steady_clock::time_point deadline;
+	long pairs = 0; // anchor pairs examined so far
+	BudgetExceeded exceeded = BUDGET_OK;
+
+	bool limited() const { return maxrevisions > 0 or maxpairs > 0 or hasdeadline; }
 };
 
 struct Stats mergestats(const struct Stats &s1, const struct Stats &s2)
@@ -55,6 +164,15 @@ struct Stats mergestats(const struct Stats &s1, const struct Stats &s2)
 	s.maxrelativecost = std::max(s1.maxrelativecost, s2.maxrelativecost);
 	s.minrelativecost = std::min(s1.minrelativecost, s2.minrelativecost);
 	s.totalrelativecost = s1.totalrelativecost + s2.totalrelativecost;
+	s.budgetrevisions = s1.budgetrevisions + s2.budgetrevisions;
+	s.budgetpairs = s1.budgetpairs + s2.budgetpairs;
+	s.budgettime = s1.budgettime + s2.budgettime;
+	s.anchorpairs = s1.anchorpairs + s2.anchorpairs;
+	s.prunedpairs = s1.prunedpairs + s2.prunedpairs;
+	s.prunedbuckets = s1.prunedbuckets + s2.prunedbuckets;
+	s.duplicateanchors = s1.duplicateanchors + s2.duplicateanchors;
+	s.dominatedanchors = s1.dominatedanchors + s2.dominatedanchors;
+	s.clusteredanchors = s1.clusteredanchors + s2.clusteredanchors;
 	return s;
 }
 
@@ -27,7 +27,7 @@
 
 const char *gengetopt_args_info_purpose = "Program to perform colinear chaining on Elastic Founder Graphs";
 
-const char *gengetopt_args_info_usage = "Usage: chainx-block-graph (--global|--semi-global) graph.gfa anchors.gaf output.gaf";
+const char *gengetopt_args_info_usage = "Usage: chainx-block-graph (--global|--semi-global) graph.gfa {anchors.gaf,reads.fasta} output.gaf";
 
 const char *gengetopt_args_info_versiontext = "";
 
@@ -40,13 +40,43 @@ const char *gengetopt_args_info_full_help[] = {
   "      --chain-to-eds            Perform chaining on the Elastic Degenerate\n                                  String relaxation of the graph (currently the\n                                  only implemented chaining solution)\n                                  (default=on)",
   "  -g, --global                  Chain between the whole query and any maximal\n                                  graph path  (default=off)",
   "  -s, --semi-global             Chain between the whole query and any graph\n                                  subpath  (default=off)",
-  "      --unsorted-input          Do not assume the input GAF anchors to be\n                                  sorted (at the cost of loading all anchors)\n                                  (default=off)",
+  "      --unsorted-input          Do not assume the input GAF anchors to be\n                                  sorted (at the cost of loading all anchors);\n                                  without it, a query repeated after another\n                                  one is a fatal error, detected only among the\n                                  last 1048576 distinct queries (a query\n                                  repeated after more is chained twice)\n                                  (default=off)",
+  "      --seed-reads              Take in input reads in FASTA format instead of\n                                  anchors: seed each read and its reverse\n                                  complement as efg-locate --approximate\n                                  --reverse-complement\n                                  --rename-reverse-complement does, and chain\n                                  its seeds in the same thread, with a single\n                                  copy of the graph index (needs --threads)\n                                  (default=off)",
+  "      --approximate-edge-match-min-count=COUNT\n                                With --seed-reads, consider any approximate\n                                  occurrence valid if the read substring occurs\n                                  at most COUNT times in the edges (see\n                                  efg-locate)  (default=`0')",
+  "      --approximate-edge-match-longest=COUNT\n                                With --seed-reads, consider the COUNT longest\n                                  substrings of the read appearing in the edges\n                                  valid (see efg-locate)  (default=`0')",
+  "      --approximate-edge-match-longest-max-count=COUNT\n                                With --seed-reads, consider the COUNT longest\n                                  substrings valid only if they appear less\n                                  than N times in the edges (see efg-locate)\n                                  (default=`1000')",
+  "      --ignore-chars=STRING     With --seed-reads, ignore these characters for\n                                  seed finding (see efg-locate)",
+  "      --partition-memory=MB     With --unsorted-input, group the anchors by\n                                  query in temporary files OUTPUT.partI of\n                                  about MB megabytes each, and chain one\n                                  partition while loading the next, instead of\n                                  loading all the anchors at once (0 to load\n                                  them all)  (default=`0')",
   "      --no-split-output-matches Do not split edge matches into node matches in\n                                  the output chains  (default=off)",
+  "      --chaining-engine=ENGINE  Compute the chains with ENGINE: dp (the DP\n                                  revising a guess for the cost of the optimal\n                                  chain) or rmq (a single pass with\n                                  range-minimum queries, subquadratic in the\n                                  number of anchors, with the same chains)\n                                  (default=`dp')",
+  "      --chain-on-graph          Compute the gaps between anchors on different\n                                  blocks as exact distances in the graph,\n                                  chaining only anchors reachable from one\n                                  another, instead of on the elastic degenerate\n                                  string where every node of a block is\n                                  connected to every node of the next one (dp\n                                  engine; O(height) time per distance, O(nodes\n                                  * height * log(blocks)) memory, about 4 *\n                                  nodes * height * log2(blocks) bytes)\n                                  (default=off)",
+  "      --graph-distance-memory=MB\n                                With --chain-on-graph, chain on the elastic\n                                  degenerate string instead if the graph\n                                  distances would take more than MB megabytes\n                                  (0 for no limit)  (default=`4096')",
+  "      --prefilter               Before chaining, remove the duplicate anchors\n                                  of each query and the anchors contained in a\n                                  longer anchor on the same diagonal\n                                  (default=off)",
+  "      --min-cluster-score=S     Before chaining, cluster the anchors of each\n                                  query by diagonal (graph position minus query\n                                  position) and remove the clusters whose\n                                  anchors total less than S query bases, except\n                                  the best one (0 to disable)  (default=`0')",
+  "      --cluster-band=BP         With --min-cluster-score, join in a cluster the\n                                  anchors whose diagonals are in the same or\n                                  adjacent bands of BP bases (and within\n                                  --cluster-max-gap in the query)\n                                  (default=`100')",
+  "      --cluster-max-gap=BP      With --min-cluster-score, join in a cluster\n                                  only the anchors at most BP bases apart in\n                                  the query  (default=`1000')",
   "      --initial-guess=GUESS     Fix a constant starting guess for the cost of\n                                  the optimal chain  (default=`100')",
   "      --initial-guess-coverage=GUESS\n                                Have the starting guess for the optimal cost be\n                                  a fraction of the inverse coverage of the\n                                  read (GUESS * (read length - read coverage))\n                                  instead of a constant (by default this is\n                                  disabled)  (default=`0')",
-  "      --ramp-up-factor=RAMPUP   At each chaining iteration, multiply by RAMPUP\n                                  the guess for the cost of the optimal chain\n                                  (default=`4.0')",
+  "      --ramp-up-factor=RAMPUP   At each chaining iteration, multiply by RAMPUP\n                                  (larger than 1) the guess for the cost of the\n                                  optimal chain  (default=`4.0')",
   "  -a, --alternative-chains=N    Chain N+1 times, removing the used anchors\n                                  after each execution, and output all chains\n                                  (default=`0')",
+  "      --single-pass-alternatives\n                                With --alternative-chains, backtrack the N\n                                  alternative chains from the chaining of the\n                                  first one, taking the unused anchors by\n                                  increasing chain cost, instead of chaining N\n                                  more times without the used anchors (faster,\n                                  but the chains can differ)  (default=off)",
+  "      --max-revisions=N         Revise the guess for the cost of the optimal\n                                  chain at most N times, then output the best\n                                  chain found so far (0 for no limit)\n                                  (default=`0')",
+  "      --max-anchor-pairs=N      Let the chaining of a query examine at most N\n                                  anchor pairs, then output the best chain\n                                  found so far (0 for no limit)  (default=`0')",
+  "      --read-timeout=MS         Stop revising the chain of a query after MS\n                                  milliseconds, and output the best chain found\n                                  so far (0 for no limit)  (default=`0')",
+  "      --deferred=FILE           Write to FILE the anchors of the queries\n                                  exceeding --max-revisions, --max-anchor-pairs\n                                  or --read-timeout, to chain them again with a\n                                  larger budget",
   "  -t, --threads=THREADNUM       Max # threads  (default=`-1')",
+  "      --schedule-window=N       With sorted input, schedule the queries in\n                                  windows of N queries, those with the most\n                                  anchors first  (default=`256')",
+  "      --task-anchors=A          With sorted input, group the queries of a\n                                  window into tasks of at least A anchors for\n                                  the threads, which steal tasks from each\n                                  other when idle  (default=`2000')",
+  "      --parallel-chaining-anchors=N\n                                Chain each query with at least N anchors with\n                                  THREADNUM threads, splitting the DP of the\n                                  query among them (dp engine, 0 to disable)\n                                  (default=`100000')",
+  "      --ordered-output          When using threads, write the chains in the\n                                  same order as the queries appear in the input\n                                  anchors  (default=off)",
+  "      --ordered-output-window=N With --ordered-output, let the threads work at\n                                  most N queries ahead of the first query whose\n                                  chains are not written yet  (default=`1024')",
+  "      --sharded-output          Let each thread write its chains to its own\n                                  shard file OUTPUT.shardI, and write to the\n                                  output file a manifest listing the shards\n                                  (incompatible with --ordered-output). The\n                                  anchors file can also be such a manifest\n                                  (default=off)",
+  "      --numa-pin                Pin each thread to the CPUs of a NUMA node,\n                                  assigning the threads to the nodes round\n                                  robin (Linux only)  (default=off)",
+  "      --numa-replicate          With --numa-pin, give each NUMA node its own\n                                  copy of the graph (uses one more copy of the\n                                  graph memory per node)  (default=off)",
+  "      --trace=FILE              Write to FILE a per-read trace of the threads\n                                  in Chrome trace-event JSON format\n                                  (chrome://tracing, Perfetto)",
+  "      --trace-threshold=MS      With --trace, trace only the reads whose\n                                  chaining takes at least MS milliseconds\n                                  (default=`0')",
+  "      --progress-interval=SEC   Print a progress line on stderr every SEC\n                                  seconds (0 to disable)  (default=`30')",
+  "      --status-file=FILE        With progress reporting, also write the\n                                  progress to FILE in JSON format, replacing it\n                                  at every update",
   "      --overwrite               Overwrite the output file, if it exists\n                                  (default=off)",
   "      --split-output-matches-graphaligner\n                                Filter out node matches of length 1 for use in\n                                  GraphAligner  (default=off)",
     0
@@ -69,14 +99,46 @@ init_help_array(void)
   gengetopt_args_info_help[11] = gengetopt_args_info_full_help[11];
   gengetopt_args_info_help[12] = gengetopt_args_info_full_help[12];
   gengetopt_args_info_help[13] = gengetopt_args_info_full_help[13];
-  gengetopt_args_info_help[14] = 0; 
+  gengetopt_args_info_help[14] = gengetopt_args_info_full_help[14];
+  gengetopt_args_info_help[15] = gengetopt_args_info_full_help[15];
+  gengetopt_args_info_help[16] = gengetopt_args_info_full_help[16];
+  gengetopt_args_info_help[17] = gengetopt_args_info_full_help[17];
+  gengetopt_args_info_help[18] = gengetopt_args_info_full_help[18];
+  gengetopt_args_info_help[19] = gengetopt_args_info_full_help[19];
+  gengetopt_args_info_help[20] = gengetopt_args_info_full_help[20];
+  gengetopt_args_info_help[21] = gengetopt_args_info_full_help[21];
+  gengetopt_args_info_help[22] = gengetopt_args_info_full_help[22];
+  gengetopt_args_info_help[23] = gengetopt_args_info_full_help[23];
+  gengetopt_args_info_help[24] = gengetopt_args_info_full_help[24];
+  gengetopt_args_info_help[25] = gengetopt_args_info_full_help[25];
+  gengetopt_args_info_help[26] = gengetopt_args_info_full_help[26];
+  gengetopt_args_info_help[27] = gengetopt_args_info_full_help[27];
+  gengetopt_args_info_help[28] = gengetopt_args_info_full_help[28];
+  gengetopt_args_info_help[29] = gengetopt_args_info_full_help[29];
+  gengetopt_args_info_help[30] = gengetopt_args_info_full_help[30];
+  gengetopt_args_info_help[31] = gengetopt_args_info_full_help[31];
+  gengetopt_args_info_help[32] = gengetopt_args_info_full_help[32];
+  gengetopt_args_info_help[33] = gengetopt_args_info_full_help[33];
+  gengetopt_args_info_help[34] = gengetopt_args_info_full_help[34];
+  gengetopt_args_info_help[35] = gengetopt_args_info_full_help[35];
+  gengetopt_args_info_help[36] = gengetopt_args_info_full_help[36];
+  gengetopt_args_info_help[37] = gengetopt_args_info_full_help[37];
+  gengetopt_args_info_help[38] = gengetopt_args_info_full_help[38];
+  gengetopt_args_info_help[39] = gengetopt_args_info_full_help[39];
+  gengetopt_args_info_help[40] = gengetopt_args_info_full_help[40];
+  gengetopt_args_info_help[41] = gengetopt_args_info_full_help[41];
+  gengetopt_args_info_help[42] = gengetopt_args_info_full_help[42];
+  gengetopt_args_info_help[43] = gengetopt_args_info_full_help[43];
+  gengetopt_args_info_help[44] = 0; 
   
 }
 
-const char *gengetopt_args_info_help[15];
+const char *gengetopt_args_info_help[45];
 
 typedef enum {ARG_NO
   , ARG_FLAG
+  , ARG_STRING
+  , ARG_INT
   , ARG_LONG
   , ARG_DOUBLE
 } cmdline_parser_arg_type;
@@ -104,12 +166,42 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->global_given = 0 ;
   args_info->semi_global_given = 0 ;
   args_info->unsorted_input_given = 0 ;
+  args_info->seed_reads_given = 0 ;
+  args_info->approximate_edge_match_min_count_given = 0 ;
+  args_info->approximate_edge_match_longest_given = 0 ;
+  args_info->approximate_edge_match_longest_max_count_given = 0 ;
+  args_info->ignore_chars_given = 0 ;
+  args_info->partition_memory_given = 0 ;
   args_info->no_split_output_matches_given = 0 ;
+  args_info->chaining_engine_given = 0 ;
+  args_info->chain_on_graph_given = 0 ;
+  args_info->graph_distance_memory_given = 0 ;
+  args_info->prefilter_given = 0 ;
+  args_info->min_cluster_score_given = 0 ;
+  args_info->cluster_band_given = 0 ;
+  args_info->cluster_max_gap_given = 0 ;
   args_info->initial_guess_given = 0 ;
   args_info->initial_guess_coverage_given = 0 ;
   args_info->ramp_up_factor_given = 0 ;
   args_info->alternative_chains_given = 0 ;
+  args_info->single_pass_alternatives_given = 0 ;
+  args_info->max_revisions_given = 0 ;
+  args_info->max_anchor_pairs_given = 0 ;
+  args_info->read_timeout_given = 0 ;
+  args_info->deferred_given = 0 ;
   args_info->threads_given = 0 ;
+  args_info->schedule_window_given = 0 ;
+  args_info->task_anchors_given = 0 ;
+  args_info->parallel_chaining_anchors_given = 0 ;
+  args_info->ordered_output_given = 0 ;
+  args_info->ordered_output_window_given = 0 ;
+  args_info->sharded_output_given = 0 ;
+  args_info->numa_pin_given = 0 ;
+  args_info->numa_replicate_given = 0 ;
+  args_info->trace_given = 0 ;
+  args_info->trace_threshold_given = 0 ;
+  args_info->progress_interval_given = 0 ;
+  args_info->status_file_given = 0 ;
   args_info->overwrite_given = 0 ;
   args_info->split_output_matches_graphaligner_given = 0 ;
 }
@@ -122,7 +214,30 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->global_flag = 0;
   args_info->semi_global_flag = 0;
   args_info->unsorted_input_flag = 0;
+  args_info->seed_reads_flag = 0;
+  args_info->approximate_edge_match_min_count_arg = 0;
+  args_info->approximate_edge_match_min_count_orig = NULL;
+  args_info->approximate_edge_match_longest_arg = 0;
+  args_info->approximate_edge_match_longest_orig = NULL;
+  args_info->approximate_edge_match_longest_max_count_arg = 1000;
+  args_info->approximate_edge_match_longest_max_count_orig = NULL;
+  args_info->ignore_chars_arg = NULL;
+  args_info->ignore_chars_orig = NULL;
+  args_info->partition_memory_arg = 0;
+  args_info->partition_memory_orig = NULL;
   args_info->no_split_output_matches_flag = 0;
+  args_info->chaining_engine_arg = gengetopt_strdup ("dp");
+  args_info->chaining_engine_orig = NULL;
+  args_info->chain_on_graph_flag = 0;
+  args_info->graph_distance_memory_arg = 4096;
+  args_info->graph_distance_memory_orig = NULL;
+  args_info->prefilter_flag = 0;
+  args_info->min_cluster_score_arg = 0;
+  args_info->min_cluster_score_orig = NULL;
+  args_info->cluster_band_arg = 100;
+  args_info->cluster_band_orig = NULL;
+  args_info->cluster_max_gap_arg = 1000;
+  args_info->cluster_max_gap_orig = NULL;
   args_info->initial_guess_arg = 100;
   args_info->initial_guess_orig = NULL;
   args_info->initial_guess_coverage_arg = 0;
@@ -131,8 +246,37 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->ramp_up_factor_orig = NULL;
   args_info->alternative_chains_arg = 0;
   args_info->alternative_chains_orig = NULL;
+  args_info->single_pass_alternatives_flag = 0;
+  args_info->max_revisions_arg = 0;
+  args_info->max_revisions_orig = NULL;
+  args_info->max_anchor_pairs_arg = 0;
+  args_info->max_anchor_pairs_orig = NULL;
+  args_info->read_timeout_arg = 0;
+  args_info->read_timeout_orig = NULL;
+  args_info->deferred_arg = NULL;
+  args_info->deferred_orig = NULL;
   args_info->threads_arg = -1;
   args_info->threads_orig = NULL;
+  args_info->schedule_window_arg = 256;
+  args_info->schedule_window_orig = NULL;
+  args_info->task_anchors_arg = 2000;
+  args_info->task_anchors_orig = NULL;
+  args_info->parallel_chaining_anchors_arg = 100000;
+  args_info->parallel_chaining_anchors_orig = NULL;
+  args_info->ordered_output_flag = 0;
+  args_info->ordered_output_window_arg = 1024;
+  args_info->ordered_output_window_orig = NULL;
+  args_info->sharded_output_flag = 0;
+  args_info->numa_pin_flag = 0;
+  args_info->numa_replicate_flag = 0;
+  args_info->trace_arg = NULL;
+  args_info->trace_orig = NULL;
+  args_info->trace_threshold_arg = 0;
+  args_info->trace_threshold_orig = NULL;
+  args_info->progress_interval_arg = 30;
+  args_info->progress_interval_orig = NULL;
+  args_info->status_file_arg = NULL;
+  args_info->status_file_orig = NULL;
   args_info->overwrite_flag = 0;
   args_info->split_output_matches_graphaligner_flag = 0;
   
@@ -150,14 +294,44 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->global_help = gengetopt_args_info_full_help[4] ;
   args_info->semi_global_help = gengetopt_args_info_full_help[5] ;
   args_info->unsorted_input_help = gengetopt_args_info_full_help[6] ;
-  args_info->no_split_output_matches_help = gengetopt_args_info_full_help[7] ;
-  args_info->initial_guess_help = gengetopt_args_info_full_help[8] ;
-  args_info->initial_guess_coverage_help = gengetopt_args_info_full_help[9] ;
-  args_info->ramp_up_factor_help = gengetopt_args_info_full_help[10] ;
-  args_info->alternative_chains_help = gengetopt_args_info_full_help[11] ;
-  args_info->threads_help = gengetopt_args_info_full_help[12] ;
-  args_info->overwrite_help = gengetopt_args_info_full_help[13] ;
-  args_info->split_output_matches_graphaligner_help = gengetopt_args_info_full_help[14] ;
+  args_info->seed_reads_help = gengetopt_args_info_full_help[7] ;
+  args_info->approximate_edge_match_min_count_help = gengetopt_args_info_full_help[8] ;
+  args_info->approximate_edge_match_longest_help = gengetopt_args_info_full_help[9] ;
+  args_info->approximate_edge_match_longest_max_count_help = gengetopt_args_info_full_help[10] ;
+  args_info->ignore_chars_help = gengetopt_args_info_full_help[11] ;
+  args_info->partition_memory_help = gengetopt_args_info_full_help[12] ;
+  args_info->no_split_output_matches_help = gengetopt_args_info_full_help[13] ;
+  args_info->chaining_engine_help = gengetopt_args_info_full_help[14] ;
+  args_info->chain_on_graph_help = gengetopt_args_info_full_help[15] ;
+  args_info->graph_distance_memory_help = gengetopt_args_info_full_help[16] ;
+  args_info->prefilter_help = gengetopt_args_info_full_help[17] ;
+  args_info->min_cluster_score_help = gengetopt_args_info_full_help[18] ;
+  args_info->cluster_band_help = gengetopt_args_info_full_help[19] ;
+  args_info->cluster_max_gap_help = gengetopt_args_info_full_help[20] ;
+  args_info->initial_guess_help = gengetopt_args_info_full_help[21] ;
+  args_info->initial_guess_coverage_help = gengetopt_args_info_full_help[22] ;
+  args_info->ramp_up_factor_help = gengetopt_args_info_full_help[23] ;
+  args_info->alternative_chains_help = gengetopt_args_info_full_help[24] ;
+  args_info->single_pass_alternatives_help = gengetopt_args_info_full_help[25] ;
+  args_info->max_revisions_help = gengetopt_args_info_full_help[26] ;
+  args_info->max_anchor_pairs_help = gengetopt_args_info_full_help[27] ;
+  args_info->read_timeout_help = gengetopt_args_info_full_help[28] ;
+  args_info->deferred_help = gengetopt_args_info_full_help[29] ;
+  args_info->threads_help = gengetopt_args_info_full_help[30] ;
+  args_info->schedule_window_help = gengetopt_args_info_full_help[31] ;
+  args_info->task_anchors_help = gengetopt_args_info_full_help[32] ;
+  args_info->parallel_chaining_anchors_help = gengetopt_args_info_full_help[33] ;
+  args_info->ordered_output_help = gengetopt_args_info_full_help[34] ;
+  args_info->ordered_output_window_help = gengetopt_args_info_full_help[35] ;
+  args_info->sharded_output_help = gengetopt_args_info_full_help[36] ;
+  args_info->numa_pin_help = gengetopt_args_info_full_help[37] ;
+  args_info->numa_replicate_help = gengetopt_args_info_full_help[38] ;
+  args_info->trace_help = gengetopt_args_info_full_help[39] ;
+  args_info->trace_threshold_help = gengetopt_args_info_full_help[40] ;
+  args_info->progress_interval_help = gengetopt_args_info_full_help[41] ;
+  args_info->status_file_help = gengetopt_args_info_full_help[42] ;
+  args_info->overwrite_help = gengetopt_args_info_full_help[43] ;
+  args_info->split_output_matches_graphaligner_help = gengetopt_args_info_full_help[44] ;
   
 }
 
@@ -259,11 +433,38 @@ static void
 cmdline_parser_release (struct gengetopt_args_info *args_info)
 {
   unsigned int i;
+  free_string_field (&(args_info->approximate_edge_match_min_count_orig));
+  free_string_field (&(args_info->approximate_edge_match_longest_orig));
+  free_string_field (&(args_info->approximate_edge_match_longest_max_count_orig));
+  free_string_field (&(args_info->ignore_chars_arg));
+  free_string_field (&(args_info->ignore_chars_orig));
+  free_string_field (&(args_info->partition_memory_orig));
+  free_string_field (&(args_info->chaining_engine_arg));
+  free_string_field (&(args_info->chaining_engine_orig));
+  free_string_field (&(args_info->graph_distance_memory_orig));
+  free_string_field (&(args_info->min_cluster_score_orig));
+  free_string_field (&(args_info->cluster_band_orig));
+  free_string_field (&(args_info->cluster_max_gap_orig));
   free_string_field (&(args_info->initial_guess_orig));
   free_string_field (&(args_info->initial_guess_coverage_orig));
   free_string_field (&(args_info->ramp_up_factor_orig));
   free_string_field (&(args_info->alternative_chains_orig));
+  free_string_field (&(args_info->max_revisions_orig));
+  free_string_field (&(args_info->max_anchor_pairs_orig));
+  free_string_field (&(args_info->read_timeout_orig));
+  free_string_field (&(args_info->deferred_arg));
+  free_string_field (&(args_info->deferred_orig));
   free_string_field (&(args_info->threads_orig));
+  free_string_field (&(args_info->schedule_window_orig));
+  free_string_field (&(args_info->task_anchors_orig));
+  free_string_field (&(args_info->parallel_chaining_anchors_orig));
+  free_string_field (&(args_info->ordered_output_window_orig));
+  free_string_field (&(args_info->trace_arg));
+  free_string_field (&(args_info->trace_orig));
+  free_string_field (&(args_info->trace_threshold_orig));
+  free_string_field (&(args_info->progress_interval_orig));
+  free_string_field (&(args_info->status_file_arg));
+  free_string_field (&(args_info->status_file_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -313,8 +514,34 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "semi-global", 0, 0 );
   if (args_info->unsorted_input_given)
     write_into_file(outfile, "unsorted-input", 0, 0 );
+  if (args_info->seed_reads_given)
+    write_into_file(outfile, "seed-reads", 0, 0 );
+  if (args_info->approximate_edge_match_min_count_given)
+    write_into_file(outfile, "approximate-edge-match-min-count", args_info->approximate_edge_match_min_count_orig, 0);
+  if (args_info->approximate_edge_match_longest_given)
+    write_into_file(outfile, "approximate-edge-match-longest", args_info->approximate_edge_match_longest_orig, 0);
+  if (args_info->approximate_edge_match_longest_max_count_given)
+    write_into_file(outfile, "approximate-edge-match-longest-max-count", args_info->approximate_edge_match_longest_max_count_orig, 0);
+  if (args_info->ignore_chars_given)
+    write_into_file(outfile, "ignore-chars", args_info->ignore_chars_orig, 0);
+  if (args_info->partition_memory_given)
+    write_into_file(outfile, "partition-memory", args_info->partition_memory_orig, 0);
   if (args_info->no_split_output_matches_given)
     write_into_file(outfile, "no-split-output-matches", 0, 0 );
+  if (args_info->chaining_engine_given)
+    write_into_file(outfile, "chaining-engine", args_info->chaining_engine_orig, 0);
+  if (args_info->chain_on_graph_given)
+    write_into_file(outfile, "chain-on-graph", 0, 0 );
+  if (args_info->graph_distance_memory_given)
+    write_into_file(outfile, "graph-distance-memory", args_info->graph_distance_memory_orig, 0);
+  if (args_info->prefilter_given)
+    write_into_file(outfile, "prefilter", 0, 0 );
+  if (args_info->min_cluster_score_given)
+    write_into_file(outfile, "min-cluster-score", args_info->min_cluster_score_orig, 0);
+  if (args_info->cluster_band_given)
+    write_into_file(outfile, "cluster-band", args_info->cluster_band_orig, 0);
+  if (args_info->cluster_max_gap_given)
+    write_into_file(outfile, "cluster-max-gap", args_info->cluster_max_gap_orig, 0);
   if (args_info->initial_guess_given)
     write_into_file(outfile, "initial-guess", args_info->initial_guess_orig, 0);
   if (args_info->initial_guess_coverage_given)
@@ -323,8 +550,42 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "ramp-up-factor", args_info->ramp_up_factor_orig, 0);
   if (args_info->alternative_chains_given)
     write_into_file(outfile, "alternative-chains", args_info->alternative_chains_orig, 0);
+  if (args_info->single_pass_alternatives_given)
+    write_into_file(outfile, "single-pass-alternatives", 0, 0 );
+  if (args_info->max_revisions_given)
+    write_into_file(outfile, "max-revisions", args_info->max_revisions_orig, 0);
+  if (args_info->max_anchor_pairs_given)
+    write_into_file(outfile, "max-anchor-pairs", args_info->max_anchor_pairs_orig, 0);
+  if (args_info->read_timeout_given)
+    write_into_file(outfile, "read-timeout", args_info->read_timeout_orig, 0);
+  if (args_info->deferred_given)
+    write_into_file(outfile, "deferred", args_info->deferred_orig, 0);
   if (args_info->threads_given)
     write_into_file(outfile, "threads", args_info->threads_orig, 0);
+  if (args_info->schedule_window_given)
+    write_into_file(outfile, "schedule-window", args_info->schedule_window_orig, 0);
+  if (args_info->task_anchors_given)
+    write_into_file(outfile, "task-anchors", args_info->task_anchors_orig, 0);
+  if (args_info->parallel_chaining_anchors_given)
+    write_into_file(outfile, "parallel-chaining-anchors", args_info->parallel_chaining_anchors_orig, 0);
+  if (args_info->ordered_output_given)
+    write_into_file(outfile, "ordered-output", 0, 0 );
+  if (args_info->ordered_output_window_given)
+    write_into_file(outfile, "ordered-output-window", args_info->ordered_output_window_orig, 0);
+  if (args_info->sharded_output_given)
+    write_into_file(outfile, "sharded-output", 0, 0 );
+  if (args_info->numa_pin_given)
+    write_into_file(outfile, "numa-pin", 0, 0 );
+  if (args_info->numa_replicate_given)
+    write_into_file(outfile, "numa-replicate", 0, 0 );
+  if (args_info->trace_given)
+    write_into_file(outfile, "trace", args_info->trace_orig, 0);
+  if (args_info->trace_threshold_given)
+    write_into_file(outfile, "trace-threshold", args_info->trace_threshold_orig, 0);
+  if (args_info->progress_interval_given)
+    write_into_file(outfile, "progress-interval", args_info->progress_interval_orig, 0);
+  if (args_info->status_file_given)
+    write_into_file(outfile, "status-file", args_info->status_file_orig, 0);
   if (args_info->overwrite_given)
     write_into_file(outfile, "overwrite", 0, 0 );
   if (args_info->split_output_matches_graphaligner_given)
@@ -464,6 +725,7 @@ int update_arg(void *field, char **orig_field,
   char *stop_char = 0;
   const char *val = value;
   int found;
+  char **string_field;
   FIX_UNUSED (field);
 
   stop_char = 0;
@@ -497,18 +759,30 @@ int update_arg(void *field, char **orig_field,
   case ARG_FLAG:
     *((int *)field) = !*((int *)field);
     break;
+  case ARG_INT:
+    if (val) *((int *)field) = strtol (val, &stop_char, 0);
+    break;
   case ARG_LONG:
     if (val) *((long *)field) = (long)strtol (val, &stop_char, 0);
     break;
   case ARG_DOUBLE:
     if (val) *((double *)field) = strtod (val, &stop_char);
     break;
+  case ARG_STRING:
+    if (val) {
+      string_field = (char **)field;
+      if (!no_free && *string_field)
+        free (*string_field); /* free previous string */
+      *string_field = gengetopt_strdup (val);
+    }
+    break;
   default:
     break;
   };
 
   /* check numeric conversion */
   switch(arg_type) {
+  case ARG_INT:
   case ARG_LONG:
   case ARG_DOUBLE:
     if (val && !(stop_char && *stop_char == '\0')) {
@@ -591,12 +865,42 @@ cmdline_parser_internal (
         { "global",	0, NULL, 'g' },
         { "semi-global",	0, NULL, 's' },
         { "unsorted-input",	0, NULL, 0 },
+        { "seed-reads",	0, NULL, 0 },
+        { "approximate-edge-match-min-count",	1, NULL, 0 },
+        { "approximate-edge-match-longest",	1, NULL, 0 },
+        { "approximate-edge-match-longest-max-count",	1, NULL, 0 },
+        { "ignore-chars",	1, NULL, 0 },
+        { "partition-memory",	1, NULL, 0 },
         { "no-split-output-matches",	0, NULL, 0 },
+        { "chaining-engine",	1, NULL, 0 },
+        { "chain-on-graph",	0, NULL, 0 },
+        { "graph-distance-memory",	1, NULL, 0 },
+        { "prefilter",	0, NULL, 0 },
+        { "min-cluster-score",	1, NULL, 0 },
+        { "cluster-band",	1, NULL, 0 },
+        { "cluster-max-gap",	1, NULL, 0 },
         { "initial-guess",	1, NULL, 0 },
         { "initial-guess-coverage",	1, NULL, 0 },
         { "ramp-up-factor",	1, NULL, 0 },
         { "alternative-chains",	1, NULL, 'a' },
+        { "single-pass-alternatives",	0, NULL, 0 },
+        { "max-revisions",	1, NULL, 0 },
+        { "max-anchor-pairs",	1, NULL, 0 },
+        { "read-timeout",	1, NULL, 0 },
+        { "deferred",	1, NULL, 0 },
         { "threads",	1, NULL, 't' },
+        { "schedule-window",	1, NULL, 0 },
+        { "task-anchors",	1, NULL, 0 },
+        { "parallel-chaining-anchors",	1, NULL, 0 },
+        { "ordered-output",	0, NULL, 0 },
+        { "ordered-output-window",	1, NULL, 0 },
+        { "sharded-output",	0, NULL, 0 },
+        { "numa-pin",	0, NULL, 0 },
+        { "numa-replicate",	0, NULL, 0 },
+        { "trace",	1, NULL, 0 },
+        { "trace-threshold",	1, NULL, 0 },
+        { "progress-interval",	1, NULL, 0 },
+        { "status-file",	1, NULL, 0 },
         { "overwrite",	0, NULL, 0 },
         { "split-output-matches-graphaligner",	0, NULL, 0 },
         { 0,  0, 0, 0 }
@@ -682,7 +986,7 @@ cmdline_parser_internal (
               goto failure;
           
           }
-          /* Do not assume the input GAF anchors to be sorted (at the cost of loading all anchors).  */
+          /* Do not assume the input GAF anchors to be sorted (at the cost of loading all anchors); without it, a query repeated after another one is a fatal error, detected only among the last 1048576 distinct queries (a query repeated after more is chained twice).  */
           else if (strcmp (long_options[option_index].name, "unsorted-input") == 0)
           {
           
@@ -693,6 +997,88 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* Take in input reads in FASTA format instead of anchors: seed each read and its reverse complement as efg-locate --approximate --reverse-complement --rename-reverse-complement does, and chain its seeds in the same thread, with a single copy of the graph index (needs --threads).  */
+          else if (strcmp (long_options[option_index].name, "seed-reads") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->seed_reads_flag), 0, &(args_info->seed_reads_given),
+                &(local_args_info.seed_reads_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "seed-reads", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --seed-reads, consider any approximate occurrence valid if the read substring occurs at most COUNT times in the edges (see efg-locate).  */
+          else if (strcmp (long_options[option_index].name, "approximate-edge-match-min-count") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->approximate_edge_match_min_count_arg), 
+                 &(args_info->approximate_edge_match_min_count_orig), &(args_info->approximate_edge_match_min_count_given),
+                &(local_args_info.approximate_edge_match_min_count_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "approximate-edge-match-min-count", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --seed-reads, consider the COUNT longest substrings of the read appearing in the edges valid (see efg-locate).  */
+          else if (strcmp (long_options[option_index].name, "approximate-edge-match-longest") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->approximate_edge_match_longest_arg), 
+                 &(args_info->approximate_edge_match_longest_orig), &(args_info->approximate_edge_match_longest_given),
+                &(local_args_info.approximate_edge_match_longest_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "approximate-edge-match-longest", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --seed-reads, consider the COUNT longest substrings valid only if they appear less than N times in the edges (see efg-locate).  */
+          else if (strcmp (long_options[option_index].name, "approximate-edge-match-longest-max-count") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->approximate_edge_match_longest_max_count_arg), 
+                 &(args_info->approximate_edge_match_longest_max_count_orig), &(args_info->approximate_edge_match_longest_max_count_given),
+                &(local_args_info.approximate_edge_match_longest_max_count_given), optarg, 0, "1000", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "approximate-edge-match-longest-max-count", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --seed-reads, ignore these characters for seed finding (see efg-locate).  */
+          else if (strcmp (long_options[option_index].name, "ignore-chars") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ignore_chars_arg), 
+                 &(args_info->ignore_chars_orig), &(args_info->ignore_chars_given),
+                &(local_args_info.ignore_chars_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "ignore-chars", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --unsorted-input, group the anchors by query in temporary files OUTPUT.partI of about MB megabytes each, and chain one partition while loading the next, instead of loading all the anchors at once (0 to load them all).  */
+          else if (strcmp (long_options[option_index].name, "partition-memory") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->partition_memory_arg), 
+                 &(args_info->partition_memory_orig), &(args_info->partition_memory_given),
+                &(local_args_info.partition_memory_given), optarg, 0, "0", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "partition-memory", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* Do not split edge matches into node matches in the output chains.  */
           else if (strcmp (long_options[option_index].name, "no-split-output-matches") == 0)
@@ -705,6 +1091,100 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* Compute the chains with ENGINE: dp (the DP revising a guess for the cost of the optimal chain) or rmq (a single pass with range-minimum queries, subquadratic in the number of anchors, with the same chains).  */
+          else if (strcmp (long_options[option_index].name, "chaining-engine") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->chaining_engine_arg), 
+                 &(args_info->chaining_engine_orig), &(args_info->chaining_engine_given),
+                &(local_args_info.chaining_engine_given), optarg, 0, "dp", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "chaining-engine", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Compute the gaps between anchors on different blocks as exact distances in the graph, chaining only anchors reachable from one another, instead of on the elastic degenerate string where every node of a block is connected to every node of the next one (dp engine; O(height) time per distance, O(nodes * height * log(blocks)) memory, about 4 * nodes * height * log2(blocks) bytes).  */
+          else if (strcmp (long_options[option_index].name, "chain-on-graph") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->chain_on_graph_flag), 0, &(args_info->chain_on_graph_given),
+                &(local_args_info.chain_on_graph_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "chain-on-graph", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --chain-on-graph, chain on the elastic degenerate string instead if the graph distances would take more than MB megabytes (0 for no limit).  */
+          else if (strcmp (long_options[option_index].name, "graph-distance-memory") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->graph_distance_memory_arg), 
+                 &(args_info->graph_distance_memory_orig), &(args_info->graph_distance_memory_given),
+                &(local_args_info.graph_distance_memory_given), optarg, 0, "4096", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "graph-distance-memory", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Before chaining, remove the duplicate anchors of each query and the anchors contained in a longer anchor on the same diagonal.  */
+          else if (strcmp (long_options[option_index].name, "prefilter") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->prefilter_flag), 0, &(args_info->prefilter_given),
+                &(local_args_info.prefilter_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "prefilter", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Before chaining, cluster the anchors of each query by diagonal (graph position minus query position) and remove the clusters whose anchors total less than S query bases, except the best one (0 to disable).  */
+          else if (strcmp (long_options[option_index].name, "min-cluster-score") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->min_cluster_score_arg), 
+                 &(args_info->min_cluster_score_orig), &(args_info->min_cluster_score_given),
+                &(local_args_info.min_cluster_score_given), optarg, 0, "0", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "min-cluster-score", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --min-cluster-score, join in a cluster the anchors whose diagonals are in the same or adjacent bands of BP bases (and within --cluster-max-gap in the query).  */
+          else if (strcmp (long_options[option_index].name, "cluster-band") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->cluster_band_arg), 
+                 &(args_info->cluster_band_orig), &(args_info->cluster_band_given),
+                &(local_args_info.cluster_band_given), optarg, 0, "100", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "cluster-band", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --min-cluster-score, join in a cluster only the anchors at most BP bases apart in the query.  */
+          else if (strcmp (long_options[option_index].name, "cluster-max-gap") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->cluster_max_gap_arg), 
+                 &(args_info->cluster_max_gap_orig), &(args_info->cluster_max_gap_given),
+                &(local_args_info.cluster_max_gap_given), optarg, 0, "1000", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "cluster-max-gap", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* Fix a constant starting guess for the cost of the optimal chain.  */
           else if (strcmp (long_options[option_index].name, "initial-guess") == 0)
@@ -734,7 +1214,7 @@ cmdline_parser_internal (
               goto failure;
           
           }
-          /* At each chaining iteration, multiply by RAMPUP the guess for the cost of the optimal chain.  */
+          /* At each chaining iteration, multiply by RAMPUP (larger than 1) the guess for the cost of the optimal chain.  */
           else if (strcmp (long_options[option_index].name, "ramp-up-factor") == 0)
           {
           
@@ -747,6 +1227,234 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* With --alternative-chains, backtrack the N alternative chains from the chaining of the first one, taking the unused anchors by increasing chain cost, instead of chaining N more times without the used anchors (faster, but the chains can differ).  */
+          else if (strcmp (long_options[option_index].name, "single-pass-alternatives") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->single_pass_alternatives_flag), 0, &(args_info->single_pass_alternatives_given),
+                &(local_args_info.single_pass_alternatives_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "single-pass-alternatives", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Revise the guess for the cost of the optimal chain at most N times, then output the best chain found so far (0 for no limit).  */
+          else if (strcmp (long_options[option_index].name, "max-revisions") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->max_revisions_arg), 
+                 &(args_info->max_revisions_orig), &(args_info->max_revisions_given),
+                &(local_args_info.max_revisions_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "max-revisions", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Let the chaining of a query examine at most N anchor pairs, then output the best chain found so far (0 for no limit).  */
+          else if (strcmp (long_options[option_index].name, "max-anchor-pairs") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->max_anchor_pairs_arg), 
+                 &(args_info->max_anchor_pairs_orig), &(args_info->max_anchor_pairs_given),
+                &(local_args_info.max_anchor_pairs_given), optarg, 0, "0", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "max-anchor-pairs", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Stop revising the chain of a query after MS milliseconds, and output the best chain found so far (0 for no limit).  */
+          else if (strcmp (long_options[option_index].name, "read-timeout") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->read_timeout_arg), 
+                 &(args_info->read_timeout_orig), &(args_info->read_timeout_given),
+                &(local_args_info.read_timeout_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "read-timeout", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Write to FILE the anchors of the queries exceeding --max-revisions, --max-anchor-pairs or --read-timeout, to chain them again with a larger budget.  */
+          else if (strcmp (long_options[option_index].name, "deferred") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->deferred_arg), 
+                 &(args_info->deferred_orig), &(args_info->deferred_given),
+                &(local_args_info.deferred_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "deferred", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With sorted input, schedule the queries in windows of N queries, those with the most anchors first.  */
+          else if (strcmp (long_options[option_index].name, "schedule-window") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->schedule_window_arg), 
+                 &(args_info->schedule_window_orig), &(args_info->schedule_window_given),
+                &(local_args_info.schedule_window_given), optarg, 0, "256", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "schedule-window", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With sorted input, group the queries of a window into tasks of at least A anchors for the threads, which steal tasks from each other when idle.  */
+          else if (strcmp (long_options[option_index].name, "task-anchors") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->task_anchors_arg), 
+                 &(args_info->task_anchors_orig), &(args_info->task_anchors_given),
+                &(local_args_info.task_anchors_given), optarg, 0, "2000", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "task-anchors", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Chain each query with at least N anchors with THREADNUM threads, splitting the DP of the query among them (dp engine, 0 to disable).  */
+          else if (strcmp (long_options[option_index].name, "parallel-chaining-anchors") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->parallel_chaining_anchors_arg), 
+                 &(args_info->parallel_chaining_anchors_orig), &(args_info->parallel_chaining_anchors_given),
+                &(local_args_info.parallel_chaining_anchors_given), optarg, 0, "100000", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "parallel-chaining-anchors", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* When using threads, write the chains in the same order as the queries appear in the input anchors.  */
+          else if (strcmp (long_options[option_index].name, "ordered-output") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->ordered_output_flag), 0, &(args_info->ordered_output_given),
+                &(local_args_info.ordered_output_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "ordered-output", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --ordered-output, let the threads work at most N queries ahead of the first query whose chains are not written yet.  */
+          else if (strcmp (long_options[option_index].name, "ordered-output-window") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ordered_output_window_arg), 
+                 &(args_info->ordered_output_window_orig), &(args_info->ordered_output_window_given),
+                &(local_args_info.ordered_output_window_given), optarg, 0, "1024", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "ordered-output-window", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Let each thread write its chains to its own shard file OUTPUT.shardI, and write to the output file a manifest listing the shards (incompatible with --ordered-output). The anchors file can also be such a manifest.  */
+          else if (strcmp (long_options[option_index].name, "sharded-output") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->sharded_output_flag), 0, &(args_info->sharded_output_given),
+                &(local_args_info.sharded_output_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "sharded-output", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Pin each thread to the CPUs of a NUMA node, assigning the threads to the nodes round robin (Linux only).  */
+          else if (strcmp (long_options[option_index].name, "numa-pin") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->numa_pin_flag), 0, &(args_info->numa_pin_given),
+                &(local_args_info.numa_pin_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "numa-pin", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --numa-pin, give each NUMA node its own copy of the graph (uses one more copy of the graph memory per node).  */
+          else if (strcmp (long_options[option_index].name, "numa-replicate") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->numa_replicate_flag), 0, &(args_info->numa_replicate_given),
+                &(local_args_info.numa_replicate_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "numa-replicate", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Write to FILE a per-read trace of the threads in Chrome trace-event JSON format (chrome://tracing, Perfetto).  */
+          else if (strcmp (long_options[option_index].name, "trace") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->trace_arg), 
+                 &(args_info->trace_orig), &(args_info->trace_given),
+                &(local_args_info.trace_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "trace", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --trace, trace only the reads whose chaining takes at least MS milliseconds.  */
+          else if (strcmp (long_options[option_index].name, "trace-threshold") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->trace_threshold_arg), 
+                 &(args_info->trace_threshold_orig), &(args_info->trace_threshold_given),
+                &(local_args_info.trace_threshold_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "trace-threshold", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Print a progress line on stderr every SEC seconds (0 to disable).  */
+          else if (strcmp (long_options[option_index].name, "progress-interval") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->progress_interval_arg), 
+                 &(args_info->progress_interval_orig), &(args_info->progress_interval_given),
+                &(local_args_info.progress_interval_given), optarg, 0, "30", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "progress-interval", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With progress reporting, also write the progress to FILE in JSON format, replacing it at every update.  */
+          else if (strcmp (long_options[option_index].name, "status-file") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->status_file_arg), 
+                 &(args_info->status_file_orig), &(args_info->status_file_given),
+                &(local_args_info.status_file_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "status-file", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* Overwrite the output file, if it exists.  */
           else if (strcmp (long_options[option_index].name, "overwrite") == 0)
@@ -46,25 +46,107 @@ struct gengetopt_args_info
   const char *global_help; /**< @brief Chain between the whole query and any maximal graph path help description.  */
   int semi_global_flag;	/**< @brief Chain between the whole query and any graph subpath (default=off).  */
   const char *semi_global_help; /**< @brief Chain between the whole query and any graph subpath help description.  */
-  int unsorted_input_flag;	/**< @brief Do not assume the input GAF anchors to be sorted (at the cost of loading all anchors) (default=off).  */
-  const char *unsorted_input_help; /**< @brief Do not assume the input GAF anchors to be sorted (at the cost of loading all anchors) help description.  */
+  int unsorted_input_flag;	/**< @brief Do not assume the input GAF anchors to be sorted (at the cost of loading all anchors); without it, a query repeated after another one is a fatal error, detected only among the last 1048576 distinct queries (a query repeated after more is chained twice) (default=off).  */
+  const char *unsorted_input_help; /**< @brief Do not assume the input GAF anchors to be sorted (at the cost of loading all anchors); without it, a query repeated after another one is a fatal error, detected only among the last 1048576 distinct queries (a query repeated after more is chained twice) help description.  */
+  int seed_reads_flag;	/**< @brief Take in input reads in FASTA format instead of anchors: seed each read and its reverse complement as efg-locate --approximate --reverse-complement --rename-reverse-complement does, and chain its seeds in the same thread, with a single copy of the graph index (needs --threads) (default=off).  */
+  const char *seed_reads_help; /**< @brief Take in input reads in FASTA format instead of anchors: seed each read and its reverse complement as efg-locate --approximate --reverse-complement --rename-reverse-complement does, and chain its seeds in the same thread, with a single copy of the graph index (needs --threads) help description.  */
+  int approximate_edge_match_min_count_arg;	/**< @brief With --seed-reads, consider any approximate occurrence valid if the read substring occurs at most COUNT times in the edges (see efg-locate) (default='0').  */
+  char * approximate_edge_match_min_count_orig;	/**< @brief With --seed-reads, consider any approximate occurrence valid if the read substring occurs at most COUNT times in the edges (see efg-locate) original value given at command line.  */
+  const char *approximate_edge_match_min_count_help; /**< @brief With --seed-reads, consider any approximate occurrence valid if the read substring occurs at most COUNT times in the edges (see efg-locate) help description.  */
+  int approximate_edge_match_longest_arg;	/**< @brief With --seed-reads, consider the COUNT longest substrings of the read appearing in the edges valid (see efg-locate) (default='0').  */
+  char * approximate_edge_match_longest_orig;	/**< @brief With --seed-reads, consider the COUNT longest substrings of the read appearing in the edges valid (see efg-locate) original value given at command line.  */
+  const char *approximate_edge_match_longest_help; /**< @brief With --seed-reads, consider the COUNT longest substrings of the read appearing in the edges valid (see efg-locate) help description.  */
+  int approximate_edge_match_longest_max_count_arg;	/**< @brief With --seed-reads, consider the COUNT longest substrings valid only if they appear less than N times in the edges (see efg-locate) (default='1000').  */
+  char * approximate_edge_match_longest_max_count_orig;	/**< @brief With --seed-reads, consider the COUNT longest substrings valid only if they appear less than N times in the edges (see efg-locate) original value given at command line.  */
+  const char *approximate_edge_match_longest_max_count_help; /**< @brief With --seed-reads, consider the COUNT longest substrings valid only if they appear less than N times in the edges (see efg-locate) help description.  */
+  char * ignore_chars_arg;	/**< @brief With --seed-reads, ignore these characters for seed finding (see efg-locate).  */
+  char * ignore_chars_orig;	/**< @brief With --seed-reads, ignore these characters for seed finding (see efg-locate) original value given at command line.  */
+  const char *ignore_chars_help; /**< @brief With --seed-reads, ignore these characters for seed finding (see efg-locate) help description.  */
+  long partition_memory_arg;	/**< @brief With --unsorted-input, group the anchors by query in temporary files OUTPUT.partI of about MB megabytes each, and chain one partition while loading the next, instead of loading all the anchors at once (0 to load them all) (default='0').  */
+  char * partition_memory_orig;	/**< @brief With --unsorted-input, group the anchors by query in temporary files OUTPUT.partI of about MB megabytes each, and chain one partition while loading the next, instead of loading all the anchors at once (0 to load them all) original value given at command line.  */
+  const char *partition_memory_help; /**< @brief With --unsorted-input, group the anchors by query in temporary files OUTPUT.partI of about MB megabytes each, and chain one partition while loading the next, instead of loading all the anchors at once (0 to load them all) help description.  */
   int no_split_output_matches_flag;	/**< @brief Do not split edge matches into node matches in the output chains (default=off).  */
   const char *no_split_output_matches_help; /**< @brief Do not split edge matches into node matches in the output chains help description.  */
+  char * chaining_engine_arg;	/**< @brief Compute the chains with ENGINE: dp (the DP revising a guess for the cost of the optimal chain) or rmq (a single pass with range-minimum queries, subquadratic in the number of anchors, with the same chains) (default='dp').  */
+  char * chaining_engine_orig;	/**< @brief Compute the chains with ENGINE: dp (the DP revising a guess for the cost of the optimal chain) or rmq (a single pass with range-minimum queries, subquadratic in the number of anchors, with the same chains) original value given at command line.  */
+  const char *chaining_engine_help; /**< @brief Compute the chains with ENGINE: dp (the DP revising a guess for the cost of the optimal chain) or rmq (a single pass with range-minimum queries, subquadratic in the number of anchors, with the same chains) help description.  */
+  int chain_on_graph_flag;	/**< @brief Compute the gaps between anchors on different blocks as exact distances in the graph, chaining only anchors reachable from one another, instead of on the elastic degenerate string where every node of a block is connected to every node of the next one (dp engine; O(height) time per distance, O(nodes * height * log(blocks)) memory, about 4 * nodes * height * log2(blocks) bytes) (default=off).  */
+  const char *chain_on_graph_help; /**< @brief Compute the gaps between anchors on different blocks as exact distances in the graph, chaining only anchors reachable from one another, instead of on the elastic degenerate string where every node of a block is connected to every node of the next one (dp engine; O(height) time per distance, O(nodes * height * log(blocks)) memory, about 4 * nodes * height * log2(blocks) bytes) help description.  */
+  long graph_distance_memory_arg;	/**< @brief With --chain-on-graph, chain on the elastic degenerate string instead if the graph distances would take more than MB megabytes (0 for no limit) (default='4096').  */
+  char * graph_distance_memory_orig;	/**< @brief With --chain-on-graph, chain on the elastic degenerate string instead if the graph distances would take more than MB megabytes (0 for no limit) original value given at command line.  */
+  const char *graph_distance_memory_help; /**< @brief With --chain-on-graph, chain on the elastic degenerate string instead if the graph distances would take more than MB megabytes (0 for no limit) help description.  */
+  int prefilter_flag;	/**< @brief Before chaining, remove the duplicate anchors of each query and the anchors contained in a longer anchor on the same diagonal (default=off).  */
+  const char *prefilter_help; /**< @brief Before chaining, remove the duplicate anchors of each query and the anchors contained in a longer anchor on the same diagonal help description.  */
+  long min_cluster_score_arg;	/**< @brief Before chaining, cluster the anchors of each query by diagonal (graph position minus query position) and remove the clusters whose anchors total less than S query bases, except the best one (0 to disable) (default='0').  */
+  char * min_cluster_score_orig;	/**< @brief Before chaining, cluster the anchors of each query by diagonal (graph position minus query position) and remove the clusters whose anchors total less than S query bases, except the best one (0 to disable) original value given at command line.  */
+  const char *min_cluster_score_help; /**< @brief Before chaining, cluster the anchors of each query by diagonal (graph position minus query position) and remove the clusters whose anchors total less than S query bases, except the best one (0 to disable) help description.  */
+  long cluster_band_arg;	/**< @brief With --min-cluster-score, join in a cluster the anchors whose diagonals are in the same or adjacent bands of BP bases (and within --cluster-max-gap in the query) (default='100').  */
+  char * cluster_band_orig;	/**< @brief With --min-cluster-score, join in a cluster the anchors whose diagonals are in the same or adjacent bands of BP bases (and within --cluster-max-gap in the query) original value given at command line.  */
+  const char *cluster_band_help; /**< @brief With --min-cluster-score, join in a cluster the anchors whose diagonals are in the same or adjacent bands of BP bases (and within --cluster-max-gap in the query) help description.  */
+  long cluster_max_gap_arg;	/**< @brief With --min-cluster-score, join in a cluster only the anchors at most BP bases apart in the query (default='1000').  */
+  char * cluster_max_gap_orig;	/**< @brief With --min-cluster-score, join in a cluster only the anchors at most BP bases apart in the query original value given at command line.  */
+  const char *cluster_max_gap_help; /**< @brief With --min-cluster-score, join in a cluster only the anchors at most BP bases apart in the query help description.  */
   long initial_guess_arg;	/**< @brief Fix a constant starting guess for the cost of the optimal chain (default='100').  */
   char * initial_guess_orig;	/**< @brief Fix a constant starting guess for the cost of the optimal chain original value given at command line.  */
   const char *initial_guess_help; /**< @brief Fix a constant starting guess for the cost of the optimal chain help description.  */
   double initial_guess_coverage_arg;	/**< @brief Have the starting guess for the optimal cost be a fraction of the inverse coverage of the read (GUESS * (read length - read coverage)) instead of a constant (by default this is disabled) (default='0').  */
   char * initial_guess_coverage_orig;	/**< @brief Have the starting guess for the optimal cost be a fraction of the inverse coverage of the read (GUESS * (read length - read coverage)) instead of a constant (by default this is disabled) original value given at command line.  */
   const char *initial_guess_coverage_help; /**< @brief Have the starting guess for the optimal cost be a fraction of the inverse coverage of the read (GUESS * (read length - read coverage)) instead of a constant (by default this is disabled) help description.  */
-  double ramp_up_factor_arg;	/**< @brief At each chaining iteration, multiply by RAMPUP the guess for the cost of the optimal chain (default='4.0').  */
-  char * ramp_up_factor_orig;	/**< @brief At each chaining iteration, multiply by RAMPUP the guess for the cost of the optimal chain original value given at command line.  */
-  const char *ramp_up_factor_help; /**< @brief At each chaining iteration, multiply by RAMPUP the guess for the cost of the optimal chain help description.  */
+  double ramp_up_factor_arg;	/**< @brief At each chaining iteration, multiply by RAMPUP (larger than 1) the guess for the cost of the optimal chain (default='4.0').  */
+  char * ramp_up_factor_orig;	/**< @brief At each chaining iteration, multiply by RAMPUP (larger than 1) the guess for the cost of the optimal chain original value given at command line.  */
+  const char *ramp_up_factor_help; /**< @brief At each chaining iteration, multiply by RAMPUP (larger than 1) the guess for the cost of the optimal chain help description.  */
   long alternative_chains_arg;	/**< @brief Chain N+1 times, removing the used anchors after each execution, and output all chains (default='0').  */
   char * alternative_chains_orig;	/**< @brief Chain N+1 times, removing the used anchors after each execution, and output all chains original value given at command line.  */
   const char *alternative_chains_help; /**< @brief Chain N+1 times, removing the used anchors after each execution, and output all chains help description.  */
+  int single_pass_alternatives_flag;	/**< @brief With --alternative-chains, backtrack the N alternative chains from the chaining of the first one, taking the unused anchors by increasing chain cost, instead of chaining N more times without the used anchors (faster, but the chains can differ) (default=off).  */
+  const char *single_pass_alternatives_help; /**< @brief With --alternative-chains, backtrack the N alternative chains from the chaining of the first one, taking the unused anchors by increasing chain cost, instead of chaining N more times without the used anchors (faster, but the chains can differ) help description.  */
+  int max_revisions_arg;	/**< @brief Revise the guess for the cost of the optimal chain at most N times, then output the best chain found so far (0 for no limit) (default='0').  */
+  char * max_revisions_orig;	/**< @brief Revise the guess for the cost of the optimal chain at most N times, then output the best chain found so far (0 for no limit) original value given at command line.  */
+  const char *max_revisions_help; /**< @brief Revise the guess for the cost of the optimal chain at most N times, then output the best chain found so far (0 for no limit) help description.  */
+  long max_anchor_pairs_arg;	/**< @brief Let the chaining of a query examine at most N anchor pairs, then output the best chain found so far (0 for no limit) (default='0').  */
+  char * max_anchor_pairs_orig;	/**< @brief Let the chaining of a query examine at most N anchor pairs, then output the best chain found so far (0 for no limit) original value given at command line.  */
+  const char *max_anchor_pairs_help; /**< @brief Let the chaining of a query examine at most N anchor pairs, then output the best chain found so far (0 for no limit) help description.  */
+  double read_timeout_arg;	/**< @brief Stop revising the chain of a query after MS milliseconds, and output the best chain found so far (0 for no limit) (default='0').  */
+  char * read_timeout_orig;	/**< @brief Stop revising the chain of a query after MS milliseconds, and output the best chain found so far (0 for no limit) original value given at command line.  */
+  const char *read_timeout_help; /**< @brief Stop revising the chain of a query after MS milliseconds, and output the best chain found so far (0 for no limit) help description.  */
+  char * deferred_arg;	/**< @brief Write to FILE the anchors of the queries exceeding --max-revisions, --max-anchor-pairs or --read-timeout, to chain them again with a larger budget.  */
+  char * deferred_orig;	/**< @brief Write to FILE the anchors of the queries exceeding --max-revisions, --max-anchor-pairs or --read-timeout, to chain them again with a larger budget original value given at command line.  */
+  const char *deferred_help; /**< @brief Write to FILE the anchors of the queries exceeding --max-revisions, --max-anchor-pairs or --read-timeout, to chain them again with a larger budget help description.  */
   long threads_arg;	/**< @brief Max # threads (default='-1').  */
   char * threads_orig;	/**< @brief Max # threads original value given at command line.  */
   const char *threads_help; /**< @brief Max # threads help description.  */
+  int schedule_window_arg;	/**< @brief With sorted input, schedule the queries in windows of N queries, those with the most anchors first (default='256').  */
+  char * schedule_window_orig;	/**< @brief With sorted input, schedule the queries in windows of N queries, those with the most anchors first original value given at command line.  */
+  const char *schedule_window_help; /**< @brief With sorted input, schedule the queries in windows of N queries, those with the most anchors first help description.  */
+  long task_anchors_arg;	/**< @brief With sorted input, group the queries of a window into tasks of at least A anchors for the threads, which steal tasks from each other when idle (default='2000').  */
+  char * task_anchors_orig;	/**< @brief With sorted input, group the queries of a window into tasks of at least A anchors for the threads, which steal tasks from each other when idle original value given at command line.  */
+  const char *task_anchors_help; /**< @brief With sorted input, group the queries of a window into tasks of at least A anchors for the threads, which steal tasks from each other when idle help description.  */
+  long parallel_chaining_anchors_arg;	/**< @brief Chain each query with at least N anchors with THREADNUM threads, splitting the DP of the query among them (dp engine, 0 to disable) (default='100000').  */
+  char * parallel_chaining_anchors_orig;	/**< @brief Chain each query with at least N anchors with THREADNUM threads, splitting the DP of the query among them (dp engine, 0 to disable) original value given at command line.  */
+  const char *parallel_chaining_anchors_help; /**< @brief Chain each query with at least N anchors with THREADNUM threads, splitting the DP of the query among them (dp engine, 0 to disable) help description.  */
+  int ordered_output_flag;	/**< @brief When using threads, write the chains in the same order as the queries appear in the input anchors (default=off).  */
+  const char *ordered_output_help; /**< @brief When using threads, write the chains in the same order as the queries appear in the input anchors help description.  */
+  long ordered_output_window_arg;	/**< @brief With --ordered-output, let the threads work at most N queries ahead of the first query whose chains are not written yet (default='1024').  */
+  char * ordered_output_window_orig;	/**< @brief With --ordered-output, let the threads work at most N queries ahead of the first query whose chains are not written yet original value given at command line.  */
+  const char *ordered_output_window_help; /**< @brief With --ordered-output, let the threads work at most N queries ahead of the first query whose chains are not written yet help description.  */
+  int sharded_output_flag;	/**< @brief Let each thread write its chains to its own shard file OUTPUT.shardI, and write to the output file a manifest listing the shards (incompatible with --ordered-output). The anchors file can also be such a manifest (default=off).  */
+  const char *sharded_output_help; /**< @brief Let each thread write its chains to its own shard file OUTPUT.shardI, and write to the output file a manifest listing the shards (incompatible with --ordered-output). The anchors file can also be such a manifest help description.  */
+  int numa_pin_flag;	/**< @brief Pin each thread to the CPUs of a NUMA node, assigning the threads to the nodes round robin (Linux only) (default=off).  */
+  const char *numa_pin_help; /**< @brief Pin each thread to the CPUs of a NUMA node, assigning the threads to the nodes round robin (Linux only) help description.  */
+  int numa_replicate_flag;	/**< @brief With --numa-pin, give each NUMA node its own copy of the graph (uses one more copy of the graph memory per node) (default=off).  */
+  const char *numa_replicate_help; /**< @brief With --numa-pin, give each NUMA node its own copy of the graph (uses one more copy of the graph memory per node) help description.  */
+  char * trace_arg;	/**< @brief Write to FILE a per-read trace of the threads in Chrome trace-event JSON format (chrome://tracing, Perfetto).  */
+  char * trace_orig;	/**< @brief Write to FILE a per-read trace of the threads in Chrome trace-event JSON format (chrome://tracing, Perfetto) original value given at command line.  */
+  const char *trace_help; /**< @brief Write to FILE a per-read trace of the threads in Chrome trace-event JSON format (chrome://tracing, Perfetto) help description.  */
+  double trace_threshold_arg;	/**< @brief With --trace, trace only the reads whose chaining takes at least MS milliseconds (default='0').  */
+  char * trace_threshold_orig;	/**< @brief With --trace, trace only the reads whose chaining takes at least MS milliseconds original value given at command line.  */
+  const char *trace_threshold_help; /**< @brief With --trace, trace only the reads whose chaining takes at least MS milliseconds help description.  */
+  double progress_interval_arg;	/**< @brief Print a progress line on stderr every SEC seconds (0 to disable) (default='30').  */
+  char * progress_interval_orig;	/**< @brief Print a progress line on stderr every SEC seconds (0 to disable) original value given at command line.  */
+  const char *progress_interval_help; /**< @brief Print a progress line on stderr every SEC seconds (0 to disable) help description.  */
+  char * status_file_arg;	/**< @brief With progress reporting, also write the progress to FILE in JSON format, replacing it at every update.  */
+  char * status_file_orig;	/**< @brief With progress reporting, also write the progress to FILE in JSON format, replacing it at every update original value given at command line.  */
+  const char *status_file_help; /**< @brief With progress reporting, also write the progress to FILE in JSON format, replacing it at every update help description.  */
   int overwrite_flag;	/**< @brief Overwrite the output file, if it exists (default=off).  */
   const char *overwrite_help; /**< @brief Overwrite the output file, if it exists help description.  */
   int split_output_matches_graphaligner_flag;	/**< @brief Filter out node matches of length 1 for use in GraphAligner (default=off).  */
@@ -77,12 +159,42 @@ struct gengetopt_args_info
   unsigned int global_given ;	/**< @brief Whether global was given.  */
   unsigned int semi_global_given ;	/**< @brief Whether semi-global was given.  */
   unsigned int unsorted_input_given ;	/**< @brief Whether unsorted-input was given.  */
+  unsigned int seed_reads_given ;	/**< @brief Whether seed-reads was given.  */
+  unsigned int approximate_edge_match_min_count_given ;	/**< @brief Whether approximate-edge-match-min-count was given.  */
+  unsigned int approximate_edge_match_longest_given ;	/**< @brief Whether approximate-edge-match-longest was given.  */
+  unsigned int approximate_edge_match_longest_max_count_given ;	/**< @brief Whether approximate-edge-match-longest-max-count was given.  */
+  unsigned int ignore_chars_given ;	/**< @brief Whether ignore-chars was given.  */
+  unsigned int partition_memory_given ;	/**< @brief Whether partition-memory was given.  */
   unsigned int no_split_output_matches_given ;	/**< @brief Whether no-split-output-matches was given.  */
+  unsigned int chaining_engine_given ;	/**< @brief Whether chaining-engine was given.  */
+  unsigned int chain_on_graph_given ;	/**< @brief Whether chain-on-graph was given.  */
+  unsigned int graph_distance_memory_given ;	/**< @brief Whether graph-distance-memory was given.  */
+  unsigned int prefilter_given ;	/**< @brief Whether prefilter was given.  */
+  unsigned int min_cluster_score_given ;	/**< @brief Whether min-cluster-score was given.  */
+  unsigned int cluster_band_given ;	/**< @brief Whether cluster-band was given.  */
+  unsigned int cluster_max_gap_given ;	/**< @brief Whether cluster-max-gap was given.  */
   unsigned int initial_guess_given ;	/**< @brief Whether initial-guess was given.  */
   unsigned int initial_guess_coverage_given ;	/**< @brief Whether initial-guess-coverage was given.  */
   unsigned int ramp_up_factor_given ;	/**< @brief Whether ramp-up-factor was given.  */
   unsigned int alternative_chains_given ;	/**< @brief Whether alternative-chains was given.  */
+  unsigned int single_pass_alternatives_given ;	/**< @brief Whether single-pass-alternatives was given.  */
+  unsigned int max_revisions_given ;	/**< @brief Whether max-revisions was given.  */
+  unsigned int max_anchor_pairs_given ;	/**< @brief Whether max-anchor-pairs was given.  */
+  unsigned int read_timeout_given ;	/**< @brief Whether read-timeout was given.  */
+  unsigned int deferred_given ;	/**< @brief Whether deferred was given.  */
   unsigned int threads_given ;	/**< @brief Whether threads was given.  */
+  unsigned int schedule_window_given ;	/**< @brief Whether schedule-window was given.  */
+  unsigned int task_anchors_given ;	/**< @brief Whether task-anchors was given.  */
+  unsigned int parallel_chaining_anchors_given ;	/**< @brief Whether parallel-chaining-anchors was given.  */
+  unsigned int ordered_output_given ;	/**< @brief Whether ordered-output was given.  */
+  unsigned int ordered_output_window_given ;	/**< @brief Whether ordered-output-window was given.  */
+  unsigned int sharded_output_given ;	/**< @brief Whether sharded-output was given.  */
+  unsigned int numa_pin_given ;	/**< @brief Whether numa-pin was given.  */
+  unsigned int numa_replicate_given ;	/**< @brief Whether numa-replicate was given.  */
+  unsigned int trace_given ;	/**< @brief Whether trace was given.  */
+  unsigned int trace_threshold_given ;	/**< @brief Whether trace-threshold was given.  */
+  unsigned int progress_interval_given ;	/**< @brief Whether progress-interval was given.  */
+  unsigned int status_file_given ;	/**< @brief Whether status-file was given.  */
   unsigned int overwrite_given ;	/**< @brief Whether overwrite was given.  */
   unsigned int split_output_matches_graphaligner_given ;	/**< @brief Whether split-output-matches-graphaligner was given.  */
 
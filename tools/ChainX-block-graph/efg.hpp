@@ -4,6 +4,8 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <sstream>
 #include <filesystem>
 #include <vector>
@@ -16,9 +18,11 @@
 #include <sdsl/util.hpp> // init_support for rank queries
 #include "concurrentqueue.h" // https://github.com/cameron314/concurrentqueue
 
+#include "graph-distance.hpp"
+
 //#define EFG_HPP_DEBUG
 
-using std::vector, std::map, std::unordered_map, std::set, std::pair, std::get, std::string, std::istringstream, std::cerr, sdsl::bit_vector;
+using std::vector, std::map, std::unordered_map, std::set, std::pair, std::get, std::string, std::string_view, std::istringstream, std::cerr, sdsl::bit_vector;
 
 namespace chainx_block_graph {
 
@@ -31,6 +35,7 @@ class Elasticfoundergraph {
 		vector<int> cuts, heights, cumulative_height;
 		vector<string> ordered_node_ids;
 		unordered_map<string,int> node_indexes;
+		vector<int> numeric_node_indexes; // if the ids are small integers, index of node id i, -1 if none
 		vector<string> ordered_node_labels;
 		map<int,vector<int>> edges; // adjacency lists // TODO decide this map
 		vector<string> walk_ids;
@@ -43,15 +48,20 @@ class Elasticfoundergraph {
 
 		// shortest_paths[i] is the length of a shortest path from the beginning of first block to the end of the (i-1)-th block, extremes included
 		sdsl::int_vector<> shortest_paths; 
+		// exact distances between the nodes, empty unless --chain-on-graph
+		GraphDistanceOracle distances;
 
 	friend bool are_colinear_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph);
 	friend int max_gap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph);
 	friend int overlap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph);
+	friend bool shared_path_offset(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph, int &offset);
 	friend GAFHit dummy_start(const GAFHit &a, const Elasticfoundergraph &graph);
 	friend GAFHit dummy_end(const GAFHit &a, const Elasticfoundergraph &graph);
+	friend int eds_start(const GAFHit &a, const Elasticfoundergraph &graph);
+	friend int eds_end(const GAFHit &a, const Elasticfoundergraph &graph);
 
 	public:
-		Elasticfoundergraph(std::ifstream &graphstream)
+		Elasticfoundergraph(std::istream &graphstream)
 		{
 			int nodes = 0;
 
@@ -120,12 +130,33 @@ class Elasticfoundergraph {
 					std::cerr << "Unrecognized line " << line[0] << ": skipping..." << std::endl;
 				}
 			}
+			init_nodes();
+		}
+
+		// graph already parsed, e.g. by efg-locate with --seed-reads, with the nodes numbered as in the file
+		Elasticfoundergraph(int m, int n, const vector<int> &cuts, const vector<int> &heights, const vector<string> &ids, const vector<string> &labels, const map<int,vector<int>> &edges) :
+			m(m), n(n), cuts(cuts), heights(heights), ordered_node_ids(ids), ordered_node_labels(labels), edges(edges)
+		{
+			cumulative_height = vector<int>(heights.size() + 1, 0);
+			for (int i = 1; i <= heights.size(); i++)
+				cumulative_height[i] = cumulative_height[i-1] + heights[i-1];
+			for (int i = 0; i < ordered_node_ids.size(); i++)
+				node_indexes[ordered_node_ids[i]] = i;
+
+			init_nodes();
+		}
+
+		// checks and indexes of the nodes, once parsed
+		void init_nodes()
+		{
 			if (!check()) {
 				exit(1);
 			}
 			for (const auto &id    : ordered_node_ids)    assert(id.size() > 0);
 			for (const auto &label : ordered_node_labels) assert(label.size() > 0);
 
+			init_numeric_node_indexes();
+
 			block = vector<int>(ordered_node_ids.size());
 			for (int b = 0, i = 0; b < heights.size(); b++) {
 				for (int j = 0; j < heights[b]; j++) {
@@ -152,11 +183,41 @@ class Elasticfoundergraph {
 			return true;
 		}
 
-		int get_node(string node_id) const
+		// dense index of the ids if they are all integers without leading zeros, at most twice the number of nodes
+		void init_numeric_node_indexes()
 		{
+			vector<int> indexes;
+			for (int i = 0; i < ordered_node_ids.size(); i++) {
+				const int id = numeric_id(ordered_node_ids[i]);
+				if (id < 0 or id > 2 * ordered_node_ids.size() + 16)
+					return;
+				if (id >= indexes.size())
+					indexes.resize(id + 1, -1);
+				indexes[id] = i;
+			}
+			std::swap(indexes, numeric_node_indexes);
+		}
+
+		// value of a node id that is a non-negative integer without leading zeros, -1 otherwise
+		static int numeric_id(string_view node_id)
+		{
+			int id;
+			const auto [end, ec] = std::from_chars(node_id.data(), node_id.data() + node_id.size(), id);
+			if (ec != std::errc() or end != node_id.data() + node_id.size() or id < 0 or (node_id.size() > 1 and node_id[0] == '0'))
+				return -1;
+			return id;
+		}
+
+		int get_node(string_view node_id) const
+		{
+			if (numeric_node_indexes.size() > 0) {
+				const int id = numeric_id(node_id);
+				if (id >= 0 and id < numeric_node_indexes.size() and numeric_node_indexes[id] >= 0)
+					return numeric_node_indexes[id];
+			}
 			//TODO: warn the user
-			assert(node_indexes.contains(node_id));
-			return node_indexes.at(node_id);
+			assert(node_indexes.contains(string(node_id)));
+			return node_indexes.at(string(node_id));
 		}
 
 		string get_id(int node) const
@@ -188,8 +249,15 @@ class Elasticfoundergraph {
 			return block.at(node);
 		}
 
-		void init_eds_support()
+		// with ongraph, also the exact distances between the nodes (see graph-distance.hpp)
+		void init_eds_support(const bool ongraph = false)
 		{
+			if (ongraph) {
+				vector<int> labels(ordered_node_labels.size());
+				for (int i = 0; i < labels.size(); i++)
+					labels[i] = ordered_node_labels[i].size();
+				distances.build(heights, labels, edges);
+			}
 
 			int shortest_path = 0;
 			for (int node = 0, j = 0; j < heights.size(); j++) {
@@ -221,6 +289,25 @@ class Elasticfoundergraph {
 #endif
 		}
 
+		bool on_graph() const
+		{
+			return !distances.empty();
+		}
+
+		// whether the gap between a1 and a2 (not overlapping) is an exact distance
+		bool on_graph_pair(const GAFHit &a1, const GAFHit &a2) const;
+
+		long distances_size_in_bytes() const
+		{
+			return distances.size_in_bytes();
+		}
+
+		// bytes of the distances that init_eds_support(true) would build
+		long estimate_distances_size_in_bytes() const
+		{
+			return GraphDistanceOracle::estimate_size_in_bytes(heights);
+		}
+
 		int shortest_path_eds(int block1, int block2) const
 		{
 			if (block1 > block2)
@@ -326,8 +413,11 @@ class GAFHit {
 	friend bool are_colinear_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph);
 	friend int max_gap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph);
 	friend int overlap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph);
+	friend bool shared_path_offset(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph, int &offset);
 	friend GAFHit dummy_start(const GAFHit &a, const Elasticfoundergraph &graph);
 	friend GAFHit dummy_end(const GAFHit &a, const Elasticfoundergraph &graph);
+	friend int eds_start(const GAFHit &a, const Elasticfoundergraph &graph);
+	friend int eds_end(const GAFHit &a, const Elasticfoundergraph &graph);
 
 	public:
 		GAFHit(istringstream &descr, const Elasticfoundergraph &efg, string &qname)
@@ -360,6 +450,54 @@ class GAFHit {
 			descr >> plength >> pstart >> pend;
 		}
 
+		/*
+		 * parse a GAF line without copying it, splitting the fields at tabs;
+		 * qname points into the line
+		 */
+		GAFHit(string_view line, const Elasticfoundergraph &efg, string_view &qname)
+		{
+			// query info
+			qname = next_gaf_field(line);
+			qlength = gaf_int(next_gaf_field(line));
+			qstart = gaf_int(next_gaf_field(line));
+			qend = gaf_int(next_gaf_field(line));
+
+			// path info
+			pstrand = (next_gaf_field(line) == "+");
+			//TODO: warn user that we assume only forward matches
+			assert(pstrand);
+
+			string_view pathdescr = next_gaf_field(line);
+			//TODO: generalize orientation or warn user
+			assert(pathdescr.size() > 0 and pathdescr[0] == '>');
+			for (size_t start = 1, end; start <= pathdescr.size(); start = end + 1) {
+				end = std::min(pathdescr.find('>', start), pathdescr.size());
+				path.push_back(efg.get_node(pathdescr.substr(start, end - start)));
+				orientations.push_back(true);
+			}
+
+			plength = gaf_int(next_gaf_field(line));
+			pstart = gaf_int(next_gaf_field(line));
+			pend = gaf_int(next_gaf_field(line));
+		}
+
+		// remove and return the first tab-separated field of line
+		static string_view next_gaf_field(string_view &line)
+		{
+			const size_t tab = line.find('\t');
+			const string_view field = line.substr(0, tab);
+			line.remove_prefix((tab == string_view::npos) ? line.size() : tab + 1);
+			return field;
+		}
+
+		static int gaf_int(string_view field)
+		{
+			int value = 0;
+			[[maybe_unused]] const auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+			assert(ec == std::errc());
+			return value;
+		}
+
 		GAFHit(int qlength, int qstart, int qend, vector<int> path, int plength, int pstart, int pend, bool reverse = false)
 		{
 			this->qlength = qlength;
@@ -401,6 +539,31 @@ class GAFHit {
 			return qlength;
 		}
 
+		int get_first_node() const
+		{
+			return path.front();
+		}
+
+		int get_last_node() const
+		{
+			return path.back();
+		}
+
+		const vector<int> &get_path() const
+		{
+			return path;
+		}
+
+		int get_path_start() const
+		{
+			return pstart;
+		}
+
+		int get_path_end() const
+		{
+			return pend;
+		}
+
 		int start_distance_query(GAFHit &a)
 		{
 			if (qstart <= a.qstart)
@@ -586,30 +749,30 @@ class GAFHit {
 		}
 };
 
-string read_gaf_query_id(string const &gafline) {
-	string id;
-	istringstream(gafline) >> id;
-	return id;
+// first field of a GAF line, pointing into it
+string_view read_gaf_query_id(string_view gafline) {
+	return gafline.substr(0, gafline.find('\t'));
 }
 
-std::unordered_map<string, vector<GAFHit>> read_gaf_chaining(std::ifstream &anchorsstream, Elasticfoundergraph &efg, moodycamel::ConcurrentQueue<string> &anchorsqueue)
+std::unordered_map<string, vector<GAFHit>> read_gaf_chaining(vector<std::ifstream> &anchorsstreams, Elasticfoundergraph &efg, moodycamel::ConcurrentQueue<std::pair<long,string>> &anchorsqueue)
 {
 	unordered_map<string,vector<GAFHit>> buckets;
-	// read file
+	long seq = 0; // queries are numbered by their first appearance
+	// read files (shards) one after the other
 	// sort anchors in a bucket for each corresponding query
-	{
+	for (std::ifstream &anchorsstream : anchorsstreams) {
 		string line;
 		while (std::getline(anchorsstream, line)) {
-			istringstream linestream(line);
-			string qname;
-			const GAFHit a(linestream, efg, qname);
-			if (buckets.contains(qname)) {
-				buckets[qname].push_back(a);
-			} else {
-				anchorsqueue.enqueue(qname);
-				buckets[qname] = vector<GAFHit>({ dummy_start(a, efg) });
-				buckets[qname].push_back(a);
+			if (line == "")
+				continue;
+			string_view qname;
+			const GAFHit a(line, efg, qname);
+			auto [it, inserted] = buckets.try_emplace(string(qname));
+			if (inserted) {
+				anchorsqueue.enqueue(std::pair<long,string>(seq++, it->first));
+				it->second.push_back(dummy_start(a, efg));
 			}
+			it->second.push_back(a);
 		}
 	}
 
@@ -624,46 +787,65 @@ std::unordered_map<string, vector<GAFHit>> read_gaf_chaining(std::stringstream &
 	{
 		string line;
 		while (std::getline(anchorsstream, line)) {
-			istringstream linestream(line);
-			string qname;
-			const GAFHit a(linestream, efg, qname);
-			if (buckets.contains(qname)) {
-				buckets[qname].push_back(a);
-			} else {
-				buckets[qname] = vector<GAFHit>({ dummy_start(a, efg) });
-				buckets[qname].push_back(a);
+			if (line == "")
+				continue;
+			string_view qname;
+			const GAFHit a(line, efg, qname);
+			auto [it, inserted] = buckets.try_emplace(string(qname));
+			if (inserted) {
+				it->second.push_back(dummy_start(a, efg));
 			}
+			it->second.push_back(a);
 		}
 	}
 
 	return buckets;
 }
 
+/*
+ * when the paths of a1 and a2 overlap in the blocks (a1 ends in a block at or
+ * after the one where a2 starts), whether a1 starts in a block at or before
+ * a2 and the paths agree on the shared blocks; offset is then the length of
+ * the nodes of a1 before the first node of a2, so that the path positions of
+ * a1 minus offset are positions on the path of a2
+ */
+bool shared_path_offset(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph, int &offset)
+{
+	const int skip = graph.get_block(a2.path[0]) - graph.get_block(a1.path[0]);
+	if (skip < 0)
+		return false;
+	const int shared = std::min<int>(a1.path.size() - skip, a2.path.size());
+	for (int k = 0; k < shared; k++) {
+		if (a1.path[skip + k] != a2.path[k])
+			return false;
+	}
+	offset = 0;
+	for (int k = 0; k < skip; k++)
+		offset += graph.get_label_length(a1.path[k]);
+	return true;
+}
+
+bool Elasticfoundergraph::on_graph_pair(const GAFHit &a1, const GAFHit &a2) const
+{
+	return on_graph() and a1.get_last_node() != -1 and a2.get_first_node() != ordered_node_ids.size();
+}
+
 // colinear here means that startpoints (endpoints) strictly precede one another
 // (i_a < j_a && i_b < j_b && i_c < j_c && i_d < j_d in the original algorithm)
 bool are_colinear_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph)
 {
-	assert(a1.path.size() <= 2 && a2.path.size() <= 2);
-
 	// TODO: implement short circuit differently?
 	if (a1.qstart >= a2.qstart || a1.qend >= a2.qend)
 		return false;
 
-	// no path overlap
+	// no path overlap, a2 must be reachable from a1 with --chain-on-graph (always from and to the dummy anchors)
 	if (graph.get_block(a1.path.back()) < graph.get_block(a2.path[0]))
-		return true;
-
-	// the paths match
-	if (a1.path == a2.path)
-		return (a1.pstart < a2.pstart && a1.pend < a2.pend);
-
-	// one node overlap, paths do not match
-	if (a1.path.back() == a2.path[0]) {
-		if (a1.path.size() == 1)
-			return (a1.pstart < a2.pstart && a1.pend < a2.pend);
-		else // a1 starts from previous block
-			return (a1.pstart < graph.get_label_length(a1.path[0]) + a2.pstart && a1.pend < graph.get_label_length(a1.path[0]) + a2.pend);
-	}
+		return !graph.on_graph_pair(a1, a2) or graph.distances.reachable(a1.path.back(), a2.path[0]);
+
+	// paths overlap in one or more blocks, compare the positions on the path of a2
+	int offset;
+	if (shared_path_offset(a1, a2, graph, offset))
+		return (a1.pstart - offset < a2.pstart && a1.pend - offset < a2.pend);
 
 	return false;
 }
@@ -671,7 +853,6 @@ bool are_colinear_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergr
 int max_gap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &graph)
 {
 	// we assume that the GAFHit utilizes all nodes in the path 
-	assert(a1.path.size() <= 2 && a2.path.size() <= 2);
 	assert(graph.shortest_paths.size() > 0);
 	int graphdistance;
 
@@ -682,18 +863,15 @@ int max_gap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &g
 		const int a1suf	= a1.plength - a1.pend;
 		const int a2pre = a2.pstart;
 
-		graphdistance = a1suf + graph.shortest_path_eds(b1 + 1, b2 - 1) + a2pre;
-	} else if (a1.path.back() == a2.path.at(0)) { // paths overlap in one node
-		const int a1suf = a1.plength - a1.pend;
-		const int a1end = graph.get_label_length(a1.path.back()) - a1suf;
-
-		graphdistance = std::max(0, a2.pstart - a1end);
-	} else if (a1.path == a2.path) {
-		// paths overlap in two nodes
-		graphdistance = std::max(0, a2.pstart - a1.pend);
+		const int between = (graph.on_graph_pair(a1, a2)) ? graph.distances.distance(a1.path.back(), a2.path[0]) : graph.shortest_path_eds(b1 + 1, b2 - 1);
+		graphdistance = a1suf + between + a2pre;
 	} else {
-		// they are not co-linear?
-		assert(false);
+		// paths overlap in one or more blocks
+		int offset = 0;
+		[[maybe_unused]] const bool shared = shared_path_offset(a1, a2, graph, offset);
+		assert(shared); // otherwise they are not co-linear
+
+		graphdistance = std::max(0, a2.pstart - (a1.pend - offset));
 	}
 
 	return std::max(graphdistance, std::max(0, a2.qstart - a1.qend));
@@ -707,22 +885,33 @@ int overlap_eds(const GAFHit &a1, const GAFHit &a2, const Elasticfoundergraph &g
 
 	if (b1 < b2) { // paths do not overlap
 		graphoverlap = 0;
-	} else if (a1.path.back() == a2.path[0]) { // paths overlap in one node
-		const int a1suf = a1.plength - a1.pend;
-		const int a1end = graph.get_label_length(a1.path.back()) - a1suf;
-
-		graphoverlap = std::max(0, a1end - a2.pstart);
-	} else if (a1.path == a2.path) {
-		// paths overlap in two nodes
-		graphoverlap = std::max(0, a1.pend - a2.pstart);
 	} else {
-		// they are not co-linear?
-		assert(false);
+		// paths overlap in one or more blocks
+		int offset = 0;
+		[[maybe_unused]] const bool shared = shared_path_offset(a1, a2, graph, offset);
+		assert(shared); // otherwise they are not co-linear
+
+		graphoverlap = std::max(0, (a1.pend - offset) - a2.pstart);
 	}
 
 	return std::abs(graphoverlap - std::max(0, a1.qend - a2.qstart));
 }
 
+/*
+ * start (end) of the match of a in the shortest-path coordinates of the EDS,
+ * so that max_gap_eds(a1, a2) = max(eds_start(a2) - eds_end(a1), gap in the
+ * query) when a1 ends in a block before the one where a2 starts
+ */
+int eds_start(const GAFHit &a, const Elasticfoundergraph &graph)
+{
+	return graph.shortest_path_eds(0, graph.get_block(a.path[0]) - 1) + a.pstart;
+}
+
+int eds_end(const GAFHit &a, const Elasticfoundergraph &graph)
+{
+	return graph.shortest_path_eds(0, graph.get_block(a.path.back())) - (a.plength - a.pend);
+}
+
 GAFHit dummy_start(const GAFHit &a, const Elasticfoundergraph &graph)
 {
 	return GAFHit(
@@ -0,0 +1,177 @@
+#ifndef GRAPH_DISTANCE_HPP
+#define GRAPH_DISTANCE_HPP
+
+#include <vector>
+#include <map>
+#include <limits>
+#include <bit>
+#include <cassert>
+#include <algorithm>
+
+/*
+ * exact distances between the nodes of an elastic founder graph, whose edges
+ * go from a block to the next one (--chain-on-graph). The distance from node
+ * u of block b1 to node v of block b2 > b1 is the total label length of the
+ * nodes strictly between them on a shortest path, infinity if v is not
+ * reachable from u, while shortest_path_eds assumes every node of a block
+ * connected to every node of the next one.
+ *
+ * Disjoint sparse table over the blocks: at level l, the blocks are split in
+ * segments of 2^(l+1) blocks, and the pivot block of a segment is the last
+ * one of its first half. A node in the first half of its segment stores its
+ * distance to each node of the pivot block (plus the label of the latter), a
+ * node in the second half the distance from each node of the pivot block.
+ * The pivot of u and v is that of the level of the highest bit where b1 and
+ * b2 differ, so the distance is a minimum over the pivot block: O(H) time and
+ * O(N H log B) space for N nodes, B blocks and height H.
+ */
+namespace chainx_block_graph {
+
+class GraphDistanceOracle {
+	private:
+		static constexpr int infinity = std::numeric_limits<int>::max() / 4;
+
+		std::vector<int> block, first; // block of each node, first node of each block
+		std::vector<std::vector<int>> offset; // by level, of the distances of each node
+		std::vector<std::vector<int>> distances; // by level, see above
+
+		int height(int b) const
+		{
+			return first[b + 1] - first[b];
+		}
+
+		// pivot block of the segment of block b at level l, -1 if the segment has no second half
+		int pivot(int b, int l) const
+		{
+			const int mid = ((b >> (l + 1)) << (l + 1)) + (1 << l);
+			return (mid < block_count()) ? mid - 1 : -1;
+		}
+
+		int block_count() const
+		{
+			return first.size() - 1;
+		}
+
+		void build_level(int l, const std::vector<int> &labels, const std::map<int,std::vector<int>> &edges, const std::vector<std::vector<int>> &inedges)
+		{
+			const int blocks = block_count(), nodes = block.size();
+			offset[l].assign(nodes + 1, 0);
+			for (int u = 0; u < nodes; u++) {
+				const int p = pivot(block[u], l);
+				offset[l][u + 1] = offset[l][u] + ((p >= 0) ? height(p) : 0);
+			}
+			distances[l].assign(offset[l][nodes], infinity);
+			auto d = [&](int u, int w) -> int & { return distances[l][offset[l][u] + w - first[pivot(block[u], l)]]; };
+
+			for (int p = (1 << l) - 1; p + 1 < blocks; p += 1 << (l + 1)) {
+				const int segment = p + 1 - (1 << l);
+				// first half, backwards from the pivot: through the successors
+				for (int w = first[p]; w < first[p + 1]; w++)
+					d(w, w) = 0;
+				for (int b = p - 1; b >= segment; b--) {
+					for (int u = first[b]; u < first[b + 1]; u++) {
+						auto it = edges.find(u);
+						if (it == edges.end())
+							continue;
+						for (int x : it->second) {
+							for (int w = first[p]; w < first[p + 1]; w++)
+								d(u, w) = std::min(d(u, w), std::min(infinity, labels[x] + d(x, w)));
+						}
+					}
+				}
+				// second half, forwards from the pivot: through the predecessors
+				const int end = std::min(blocks, p + 1 + (1 << l));
+				for (int b = p + 1; b < end; b++) {
+					for (int v = first[b]; v < first[b + 1]; v++) {
+						for (int x : inedges[v]) {
+							for (int w = first[p]; w < first[p + 1]; w++)
+								d(v, w) = std::min(d(v, w), (b == p + 1) ? ((x == w) ? 0 : infinity) : std::min(infinity, d(x, w) + labels[x]));
+						}
+					}
+				}
+			}
+		}
+
+	public:
+		// heights of the blocks, label lengths of the nodes (numbered block by block) and edges
+		void build(const std::vector<int> &heights, const std::vector<int> &labels, const std::map<int,std::vector<int>> &edges)
+		{
+			const int blocks = heights.size(), nodes = labels.size();
+			first.assign(blocks + 1, 0);
+			block.assign(nodes, 0);
+			for (int b = 0; b < blocks; b++) {
+				first[b + 1] = first[b] + heights[b];
+				for (int u = first[b]; u < first[b + 1]; u++)
+					block[u] = b;
+			}
+			std::vector<std::vector<int>> inedges(nodes);
+			for (const auto &[u, targets] : edges) {
+				for (int v : targets) {
+					assert(block[v] == block[u] + 1); // edges between consecutive blocks only
+					inedges[v].push_back(u);
+				}
+			}
+
+			const int levels = (blocks > 1) ? std::bit_width((unsigned)blocks - 1) : 0;
+			offset.assign(levels, std::vector<int>());
+			distances.assign(levels, std::vector<int>());
+			for (int l = 0; l < levels; l++)
+				build_level(l, labels, edges, inedges);
+		}
+
+		bool empty() const
+		{
+			return first.empty();
+		}
+
+		// distance from node u to node v in a later block, infinity (larger than any path) if v is not reachable from u
+		int distance(int u, int v) const
+		{
+			assert(block[u] < block[v]);
+			const int l = std::bit_width((unsigned)(block[u] ^ block[v])) - 1;
+			const int p = pivot(block[v], l);
+			const int *du = distances[l].data() + offset[l][u], *dv = distances[l].data() + offset[l][v];
+			int d = infinity;
+			for (int w = 0; w < height(p); w++)
+				d = std::min(d, du[w] + dv[w]);
+			return std::min(d, infinity);
+		}
+
+		bool reachable(int u, int v) const
+		{
+			return distance(u, v) < infinity;
+		}
+
+		// bytes that build would take with these block heights, without building
+		static long estimate_size_in_bytes(const std::vector<int> &heights)
+		{
+			const int blocks = heights.size();
+			long nodes = 0;
+			for (int h : heights)
+				nodes += h;
+			const int levels = (blocks > 1) ? std::bit_width((unsigned)blocks - 1) : 0;
+			long bytes = 0;
+			for (int l = 0; l < levels; l++) {
+				bytes += (nodes + 1) * sizeof(int);
+				for (int b = 0; b < blocks; b++) {
+					const int mid = ((b >> (l + 1)) << (l + 1)) + (1 << l);
+					if (mid < blocks)
+						bytes += (long)heights[b] * heights[mid - 1] * sizeof(int);
+				}
+			}
+			return bytes;
+		}
+
+		// bytes of the distances
+		long size_in_bytes() const
+		{
+			long bytes = 0;
+			for (int l = 0; l < offset.size(); l++)
+				bytes += (offset[l].size() + distances[l].size()) * sizeof(int);
+			return bytes;
+		}
+};
+
+} // Namespace chainx_block_graph
+
+#endif
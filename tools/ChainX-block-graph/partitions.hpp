@@ -0,0 +1,114 @@
+#ifndef PARTITIONS_HPP
+#define PARTITIONS_HPP
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+/*
+ * external-memory grouping of unsorted anchors (--unsorted-input with
+ * --partition-memory): the GAF lines are spread over the temporary files
+ * <output>.part<i> by a hash of their query, with enough partitions for the
+ * lines of one partition to take about the given memory, then the partitions
+ * are loaded one at a time and grouped by query. All the anchors of a query
+ * are in the same partition, so each query is chained once. The partition
+ * files are removed once loaded.
+ */
+namespace chainx_block_graph {
+
+const int MAX_PARTITIONS = 512; // open files while partitioning
+const int UNKNOWN_SIZE_PARTITIONS = 64; // when the input is a pipe
+
+class AnchorPartitions {
+	private:
+		std::vector<std::filesystem::path> paths;
+
+	public:
+		~AnchorPartitions()
+		{
+			std::error_code ec;
+			for (const std::filesystem::path &p : paths)
+				std::filesystem::remove(p, ec);
+		}
+
+		/*
+		 * spread the lines of the inputs (of totalbytes bytes, 0 if unknown)
+		 * over the partitions; returns false on I/O errors
+		 */
+		bool write(std::vector<std::ifstream> &inputs, long totalbytes, long memorybytes, const std::filesystem::path &outputpath)
+		{
+			const long wanted = (totalbytes > 0) ? (totalbytes + memorybytes - 1) / memorybytes : UNKNOWN_SIZE_PARTITIONS;
+			const int partitions = std::clamp<long>(wanted, 1, MAX_PARTITIONS);
+
+			std::vector<std::ofstream> partitionfs;
+			for (int i = 0; i < partitions; i++) {
+				std::filesystem::path p = outputpath;
+				p += ".part" + std::to_string(i);
+				paths.push_back(p);
+				partitionfs.push_back(std::ofstream(p, std::ios::out | std::ios::trunc));
+				if (!partitionfs.back()) {
+					std::cerr << "Error opening partition file " << p << "." << std::endl;
+					return false;
+				}
+			}
+
+			std::string line;
+			for (std::ifstream &inputfs : inputs) {
+				while (std::getline(inputfs, line)) {
+					if (line == "")
+						continue;
+					const std::string_view query = std::string_view(line).substr(0, line.find('\t'));
+					partitionfs[std::hash<std::string_view>{}(query) % partitions] << line << "\n";
+				}
+			}
+			for (int i = 0; i < partitions; i++) {
+				partitionfs[i].close();
+				if (!partitionfs[i]) {
+					std::cerr << "Error writing partition file " << paths[i] << "." << std::endl;
+					return false;
+				}
+			}
+			return true;
+		}
+
+		int size() const
+		{
+			return paths.size();
+		}
+
+		/*
+		 * load partition i into groups, the GAF lines of each query in
+		 * order of first appearance, then remove its file
+		 */
+		bool read(int i, std::vector<std::pair<std::string,std::vector<std::string>>> &groups)
+		{
+			groups.clear();
+			std::ifstream partitionfs(paths[i]);
+			if (!partitionfs) {
+				std::cerr << "Error opening partition file " << paths[i] << "." << std::endl;
+				return false;
+			}
+			std::unordered_map<std::string,int> index;
+			std::string line;
+			while (std::getline(partitionfs, line)) {
+				const std::string_view query = std::string_view(line).substr(0, line.find('\t'));
+				auto [it, inserted] = index.try_emplace(std::string(query), groups.size());
+				if (inserted)
+					groups.push_back({it->first, {}});
+				groups[it->second].second.push_back(std::move(line));
+			}
+			partitionfs.close();
+			std::error_code ec;
+			std::filesystem::remove(paths[i], ec);
+			return true;
+		}
+};
+
+} // Namespace chainx_block_graph
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef PREFILTER_HPP
+#define PREFILTER_HPP
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+
+#include "efg.hpp"
+
+/*
+ * filters of the anchors of a query before chaining, in (expected) linear
+ * time over the anchors sorted by query start, keeping the dummy anchors:
+ * - --prefilter removes the duplicate anchors and the anchors contained in a
+ *   longer anchor on the same diagonal, i.e. a substring of the same match;
+ * - --min-cluster-score clusters the anchors by diagonal (eds_start minus
+ *   the query start, see efg.hpp) in bands of --cluster-band bases, joining
+ *   the anchors of the same or adjacent bands at most --cluster-max-gap
+ *   apart in the query, and removes the clusters whose anchors total less
+ *   than the given query bases, except the best cluster.
+ */
+namespace chainx_block_graph {
+
+// whether a is a substring of the longer match b on the same path
+bool is_dominated(const GAFHit &a, const GAFHit &b, const Elasticfoundergraph &graph)
+{
+	if (b.get_query_start() > a.get_query_start() or a.get_query_end() > b.get_query_end())
+		return false;
+	if (b.get_query_end() - b.get_query_start() <= a.get_query_end() - a.get_query_start())
+		return false;
+	if (graph.get_block(a.get_last_node()) > graph.get_block(b.get_last_node()))
+		return false;
+	int offset;
+	if (!shared_path_offset(b, a, graph, offset))
+		return false;
+	return a.get_path_start() + offset - b.get_path_start() == a.get_query_start() - b.get_query_start();
+}
+
+long diagonal_band(long diagonal, long band)
+{
+	return (diagonal >= 0) ? diagonal / band : -((-diagonal + band - 1) / band);
+}
+
+class AnchorPrefilter {
+	private:
+		vector<int> parent; // union-find of the clusters
+
+		int find(int i)
+		{
+			while (parent[i] != i) {
+				parent[i] = parent[parent[i]];
+				i = parent[i];
+			}
+			return i;
+		}
+
+		void unite(int i, int j)
+		{
+			i = find(i);
+			j = find(j);
+			if (i != j)
+				parent[std::max(i, j)] = std::min(i, j);
+		}
+
+	public:
+		// duplicates have the same query start, so they are in the same run of anchors
+		void remove_duplicates(const vector<GAFHit> &anchors, vector<bool> &keep, Stats &stats)
+		{
+			const int n = anchors.size();
+			vector<int> run;
+			for (int runstart = 1, runend; runstart < n - 1; runstart = runend) {
+				for (runend = runstart + 1; runend < n - 1 and anchors[runend].get_query_start() == anchors[runstart].get_query_start(); runend++);
+				if (runend - runstart == 1)
+					continue;
+				run.resize(runend - runstart);
+				std::iota(run.begin(), run.end(), runstart);
+				std::sort(run.begin(), run.end(), [&](int i, int j) {
+					const GAFHit &a = anchors[i], &b = anchors[j];
+					if (a.get_query_end() != b.get_query_end())
+						return a.get_query_end() < b.get_query_end();
+					if (a.get_path_start() != b.get_path_start())
+						return a.get_path_start() < b.get_path_start();
+					if (a.get_path_end() != b.get_path_end())
+						return a.get_path_end() < b.get_path_end();
+					return a.get_path() < b.get_path();
+				});
+				for (int k = 1; k < run.size(); k++) {
+					if (anchors[run[k]] == anchors[run[k - 1]]) {
+						keep[run[k]] = false;
+						stats.duplicateanchors++;
+					}
+				}
+			}
+		}
+
+		// keeping, for each diagonal, the anchor reaching furthest in the query
+		void remove_dominated(const vector<GAFHit> &anchors, const Elasticfoundergraph &graph, vector<bool> &keep, Stats &stats)
+		{
+			const int n = anchors.size();
+			std::unordered_map<long,int> furthest;
+			for (int i = 1; i < n - 1; i++) {
+				if (!keep[i])
+					continue;
+				const long diagonal = (long)eds_start(anchors[i], graph) - anchors[i].get_query_start();
+				auto [it, inserted] = furthest.try_emplace(diagonal, i);
+				if (inserted)
+					continue;
+				const int b = it->second;
+				if (is_dominated(anchors[i], anchors[b], graph)) {
+					keep[i] = false;
+					stats.dominatedanchors++;
+					continue;
+				}
+				if (is_dominated(anchors[b], anchors[i], graph)) {
+					keep[b] = false;
+					stats.dominatedanchors++;
+				}
+				if (anchors[i].get_query_end() > anchors[b].get_query_end() or !keep[b])
+					it->second = i;
+			}
+		}
+
+		void remove_weak_clusters(const vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const long minscore, const long band, const long maxgap, vector<bool> &keep, Stats &stats)
+		{
+			const int n = anchors.size();
+			parent.resize(n);
+			std::iota(parent.begin(), parent.end(), 0);
+			// last anchor of each band and the furthest query end of its cluster
+			std::unordered_map<long,std::pair<int,int>> last;
+			for (int i = 1; i < n - 1; i++) {
+				if (!keep[i])
+					continue;
+				const long b = diagonal_band((long)eds_start(anchors[i], graph) - anchors[i].get_query_start(), band);
+				for (long nb = b - 1; nb <= b + 1; nb++) {
+					auto it = last.find(nb);
+					if (it != last.end() and anchors[i].get_query_start() - it->second.second <= maxgap)
+						unite(i, it->second.first);
+				}
+				auto [it, inserted] = last.try_emplace(b, i, anchors[i].get_query_end());
+				if (!inserted) {
+					const bool joined = anchors[i].get_query_start() - it->second.second <= maxgap;
+					it->second = {i, (joined) ? std::max(it->second.second, anchors[i].get_query_end()) : anchors[i].get_query_end()};
+				}
+			}
+
+			vector<long> score(n, 0);
+			int best = -1;
+			for (int i = 1; i < n - 1; i++) {
+				if (!keep[i])
+					continue;
+				const int r = find(i);
+				score[r] += anchors[i].get_query_end() - anchors[i].get_query_start();
+				if (best == -1 or score[r] > score[best])
+					best = r;
+			}
+			for (int i = 1; i < n - 1; i++) {
+				if (keep[i] and score[find(i)] < minscore and find(i) != best) {
+					keep[i] = false;
+					stats.clusteredanchors++;
+				}
+			}
+		}
+};
+
+/*
+ * filter the anchors of a query sorted by query start, between the dummy
+ * anchors, as selected (see above)
+ */
+void prefilter_anchors(vector<GAFHit> &anchors, const Elasticfoundergraph &graph, const bool dominated, const long minscore, const long band, const long maxgap, Stats &stats)
+{
+	vector<bool> keep(anchors.size(), true);
+	AnchorPrefilter filter;
+	if (dominated) {
+		filter.remove_duplicates(anchors, keep, stats);
+		filter.remove_dominated(anchors, graph, keep, stats);
+	}
+	if (minscore > 0)
+		filter.remove_weak_clusters(anchors, graph, minscore, band, maxgap, keep, stats);
+
+	int kept = 0;
+	for (int i = 0; i < anchors.size(); i++) {
+		if (keep[i]) {
+			if (kept != i)
+				anchors[kept] = std::move(anchors[i]);
+			kept++;
+		}
+	}
+	anchors.erase(anchors.begin() + kept, anchors.end());
+}
+
+} // Namespace chainx_block_graph
+
+#endif
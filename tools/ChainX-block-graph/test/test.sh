@@ -8,29 +8,205 @@ chainxblockgraph=$thisfolder/../chainx-block-graph
 mkdir $outputfolder
 echo -n > $logfile
 
+# graph of the anchors of a test file: input/X.gaf is on input/X.gfa if it
+# exists, on input/graph.gfa otherwise. input/generated.gaf has the seeds of
+# two simulated reads on input/generated.gfa, about 500 anchors per query
+# (efg-generate -b 600 --max-label-length 20 -n 2 --read-length 8000
+# --read-length-stdev 0 --error-rate 0.01 --seed 7, seeded with efg-locate
+# --approximate --split-output-matches --reverse-complement
+# --rename-reverse-complement), and input/sparse.gfa has consecutive blocks
+# that are not fully connected
+graph_of() {
+	if [ -f ${1%.*}.gfa ] ; then echo ${1%.*}.gfa ; else echo $thisfolder/input/graph.gfa ; fi
+}
+
+# both engines give the expected chains, also on the generated queries with several buckets of anchors
+for engine in dp rmq
+do
+	for testfile in $thisfolder/input/anchors-1.gaf $thisfolder/input/generated.gaf $thisfolder/input/sparse.gaf
+	do
+		echo "$testfile : " >> $logfile
+		basename=$(basename $testfile)
+		outfileg=$outputfolder/${basename%.*}-global-$engine.gaf
+		correctg=$thisfolder/correctoutput/${basename%.*}-global.gaf
+		$chainxblockgraph --chaining-engine $engine --unsorted-input --global $(graph_of $testfile) $testfile $outfileg \
+			>> $logfile 2>> $logfile
+		diff <(sort $outfileg) <(sort $correctg) > /dev/null 2>/dev/null
+		exitcode=$? ; if [ $exitcode -ne 0 ] ; then
+			echo "Test failed on file $testfile with engine $engine!" | tee -a $logfile
+			exit 1
+		fi
+
+		outfilesg=$outputfolder/${basename%.*}-semi-global-$engine.gaf
+		correctsg=$thisfolder/correctoutput/${basename%.*}-semi-global.gaf
+
+		$chainxblockgraph --chaining-engine $engine --unsorted-input --semi-global $(graph_of $testfile) $testfile $outfilesg \
+			>> $logfile 2>> $logfile
+
+		diff <(sort $outfilesg) <(sort $correctsg) > /dev/null 2>/dev/null
+		exitcode=$? ; if [ $exitcode -ne 0 ] ; then
+			echo "Test failed on file $testfile with engine $engine!" | tee -a $logfile
+			exit 1
+		fi
+	done
+done
+
+# unsorted anchors grouped in partitions on disk
+for testfile in $thisfolder/input/anchors-1.gaf
+do
+	echo "$testfile : " >> $logfile
+	basename=$(basename $testfile)
+	outfilep=$outputfolder/${basename%.*}-semi-global-partitioned.gaf
+	correctsg=$thisfolder/correctoutput/${basename%.*}-semi-global.gaf
+	$chainxblockgraph --unsorted-input --partition-memory 1 --threads 1 --progress-interval 0 --semi-global $thisfolder/input/graph.gfa $testfile $outfilep \
+		>> $logfile 2>> $logfile
+	diff <(sort $outfilep) <(sort $correctsg) > /dev/null 2>/dev/null
+	exitcode=$? ; if [ $exitcode -ne 0 ] || ls $outfilep.part* > /dev/null 2>&1 ; then
+		echo "Test failed on file $testfile with partitions!" | tee -a $logfile
+		exit 1
+	fi
+done
+
+# sorted anchors with --threads 0, chained by a single thread
 for testfile in $thisfolder/input/anchors-1.gaf
 do
 	echo "$testfile : " >> $logfile
 	basename=$(basename $testfile)
-	outfileg=$outputfolder/${basename%.*}-global.gaf
+	outfilez=$outputfolder/${basename%.*}-global-threads0.gaf
 	correctg=$thisfolder/correctoutput/${basename%.*}-global.gaf
-	$chainxblockgraph --unsorted-input --global $thisfolder/input/graph.gfa $testfile $outfileg \
+	timeout 60 $chainxblockgraph --threads 0 --progress-interval 0 --global $thisfolder/input/graph.gfa $testfile $outfilez \
 		>> $logfile 2>> $logfile
-	diff <(sort $outfileg) <(sort $correctg) > /dev/null 2>/dev/null
-	exitcode=$? ; if [ $exitcode -ne 0 ] ; then
-		echo "Test failed on file $testfile!" | tee -a $logfile
+	exitcode=$? ; if [ $exitcode -ne 0 ] || ! diff <(sort $outfilez) <(sort $correctg) > /dev/null 2>/dev/null ; then
+		echo "Test failed on file $testfile with --threads 0!" | tee -a $logfile
 		exit 1
 	fi
+done
 
-	outfilesg=$outputfolder/${basename%.*}-semi-global.gaf
-	correctsg=$thisfolder/correctoutput/${basename%.*}-semi-global.gaf
+# queries exceeding the work budget, still chained and written to --deferred
+for testfile in $thisfolder/input/anchors-1.gaf
+do
+	echo "$testfile : " >> $logfile
+	basename=$(basename $testfile)
+	# budget and the suffix of its expected chains: after two passes, q1 gets the chain of the full budget
+	for budgetcorrect in "--max-anchor-pairs 1:global-budget" "--max-revisions 1 --initial-guess 0:global"
+	do
+		budget=${budgetcorrect%:*}
+		outfileb=$outputfolder/${basename%.*}-global-budget.gaf
+		deferred=$outputfolder/${basename%.*}-deferred.gaf
+		correct=$thisfolder/correctoutput/${basename%.*}-${budgetcorrect#*:}.gaf
+		rm -f $outfileb $deferred
+		$chainxblockgraph --unsorted-input $budget --deferred $deferred --progress-interval 0 --global $thisfolder/input/graph.gfa $testfile $outfileb \
+			>> $logfile 2>> $logfile
+		diff <(sort $outfileb) <(sort $correct) > /dev/null 2>/dev/null
+		exitcode=$? ; if [ $exitcode -ne 0 ] || ! diff <(sort $deferred) <(sort $testfile) > /dev/null 2>/dev/null ; then
+			echo "Test failed on file $testfile with budget $budget!" | tee -a $logfile
+			exit 1
+		fi
+	done
+done
 
-	$chainxblockgraph --unsorted-input --semi-global $thisfolder/input/graph.gfa $testfile $outfilesg \
-		>> $logfile 2>> $logfile
+# many revisions of the guess, with the DP of each revision reusing that of the previous one
+for testfile in $thisfolder/input/generated.gaf
+do
+	echo "$testfile : " >> $logfile
+	basename=$(basename $testfile)
+	for mode in global semi-global
+	do
+		for threads in "--threads 1" "--threads 4 --parallel-chaining-anchors 1"
+		do
+			outfiler=$outputfolder/${basename%.*}-$mode-revisions.gaf
+			correct=$thisfolder/correctoutput/${basename%.*}-$mode.gaf
+			rm -f $outfiler
+			timeout 60 $chainxblockgraph --initial-guess 1 --ramp-up-factor 1.5 $threads --progress-interval 0 --$mode $(graph_of $testfile) $testfile $outfiler \
+				>> $logfile 2>> $logfile
+			exitcode=$? ; if [ $exitcode -ne 0 ] || ! diff <(sort $outfiler) <(sort $correct) > /dev/null 2>/dev/null ; then
+				echo "Test failed on file $testfile with many revisions ($mode, $threads)!" | tee -a $logfile
+				exit 1
+			fi
+		done
+	done
+done
+
+# predecessors pruned in buckets of 128 anchors, skipped over the several buckets and revisions of the generated queries
+for testfile in $thisfolder/input/generated.gaf
+do
+	echo "$testfile : " >> $logfile
+	basename=$(basename $testfile)
+	for mode in global semi-global
+	do
+		outfilep=$outputfolder/${basename%.*}-$mode-buckets.gaf
+		statsp=$outputfolder/${basename%.*}-$mode-buckets.log
+		correct=$thisfolder/correctoutput/${basename%.*}-$mode.gaf
+		$chainxblockgraph --initial-guess 1 --ramp-up-factor 1.5 --threads 1 --progress-interval 0 --$mode $(graph_of $testfile) $testfile $outfilep \
+			> $statsp 2>&1
+		cat $statsp >> $logfile
+		diff <(sort $outfilep) <(sort $correct) > /dev/null 2>/dev/null
+		exitcode=$? ; if [ $exitcode -ne 0 ] || ! grep -q "([1-9][0-9]* buckets of predecessors skipped)" $statsp ; then
+			echo "Test failed on file $testfile with pruned buckets ($mode)!" | tee -a $logfile
+			exit 1
+		fi
+	done
+done
+
+# DP of each query split among the threads, over several tiles of 256 anchors with the generated queries
+for testfile in $thisfolder/input/anchors-1.gaf $thisfolder/input/generated.gaf
+do
+	echo "$testfile : " >> $logfile
+	basename=$(basename $testfile)
+	for mode in global semi-global
+	do
+		outfilet=$outputfolder/${basename%.*}-$mode-parallel.gaf
+		correct=$thisfolder/correctoutput/${basename%.*}-$mode.gaf
+		$chainxblockgraph --unsorted-input --parallel-chaining-anchors 1 --threads 4 --progress-interval 0 --$mode $(graph_of $testfile) $testfile $outfilet \
+			>> $logfile 2>> $logfile
+		diff <(sort $outfilet) <(sort $correct) > /dev/null 2>/dev/null
+		exitcode=$? ; if [ $exitcode -ne 0 ] ; then
+			echo "Test failed on file $testfile with parallel chaining ($mode)!" | tee -a $logfile
+			exit 1
+		fi
+	done
+done
+
+# exact graph distances, the same as those of the EDS on graph.gfa, whose consecutive blocks are fully
+# connected, but not on sparse.gfa, where n5 (the best chain on the EDS) is not reachable from n2
+for testfile in $thisfolder/input/anchors-1.gaf $thisfolder/input/sparse.gaf
+do
+	echo "$testfile : " >> $logfile
+	basename=$(basename $testfile)
+	for mode in global semi-global
+	do
+		outfileo=$outputfolder/${basename%.*}-$mode-on-graph.gaf
+		correcteds=$thisfolder/correctoutput/${basename%.*}-$mode.gaf
+		correct=$thisfolder/correctoutput/${basename%.*}-$mode-on-graph.gaf
+		if [ ! -f $correct ] ; then correct=$correcteds ; fi
+		$chainxblockgraph --unsorted-input --chain-on-graph --progress-interval 0 --$mode $(graph_of $testfile) $testfile $outfileo \
+			>> $logfile 2>> $logfile
+		diff <(sort $outfileo) <(sort $correct) > /dev/null 2>/dev/null
+		exitcode=$? ; if [ $exitcode -ne 0 ] || { [ $correct != $correcteds ] && diff $outfileo $correcteds > /dev/null 2>/dev/null ; } ; then
+			echo "Test failed on file $testfile with graph distances ($mode)!" | tee -a $logfile
+			exit 1
+		fi
+	done
+done
 
-	diff <(sort $outfilesg) <(sort $correctsg) > /dev/null 2>/dev/null
-	exitcode=$? ; if [ $exitcode -ne 0 ] ; then
-		echo "Test failed on file $testfile!" | tee -a $logfile
+# --seed-reads gives the chains of efg-locate piped into chainx-block-graph
+efglocate=$thisfolder/../../efg-locate/efg-locate
+locateinputs=$thisfolder/../../efg-locate/test/inputs
+if [ -x $efglocate ] ; then
+	graph=$locateinputs/tcs_fig_5.gfa
+	reads=$locateinputs/tcs_fig_5_approximate.fasta
+	echo "$reads : " >> $logfile
+	$efglocate --approximate --reverse-complement --rename-reverse-complement $graph $reads $outputfolder/seeds.gaf \
+		>> $logfile 2>> $logfile
+	$chainxblockgraph --threads 1 --semi-global --progress-interval 0 $graph $outputfolder/seeds.gaf $outputfolder/seeds-chains.gaf \
+		>> $logfile 2>> $logfile
+	$chainxblockgraph --seed-reads --threads 2 --ordered-output --semi-global --progress-interval 0 $graph $reads $outputfolder/seed-reads.gaf \
+		>> $logfile 2>> $logfile
+	diff $outputfolder/seed-reads.gaf $outputfolder/seeds-chains.gaf > /dev/null 2>/dev/null
+	exitcode=$? ; if [ $exitcode -ne 0 ] || [ ! -s $outputfolder/seed-reads.gaf ] ; then
+		echo "Test failed on file $reads with --seed-reads!" | tee -a $logfile
 		exit 1
 	fi
-done
+else
+	echo "efg-locate not built, skipping the --seed-reads test" | tee -a $logfile
+fi
@@ -0,0 +1,300 @@
+#ifndef MICROBENCH_HPP
+#define MICROBENCH_HPP
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/*
+ * minimal microbenchmark harness for make bench: each benchmark is run in
+ * batches until a batch takes at least 50 ms, the best of 5 batches is
+ * reported as ns/op and, if the perf_event interface is available, as CPU
+ * cycles/op. Results can be saved as a baseline JSON file and compared with
+ * a later run, failing if any benchmark is slower than the tolerance.
+ */
+namespace microbench {
+
+template <class T>
+void inline do_not_optimize(const T &value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// hardware cycle counter of this thread, if perf_event_open is permitted
+class CycleCounter {
+	private:
+		int fd = -1;
+
+	public:
+		CycleCounter()
+		{
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = PERF_COUNT_HW_CPU_CYCLES;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+			if (fd >= 0)
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+
+		~CycleCounter() { if (fd >= 0) close(fd); }
+
+		bool available() const { return fd >= 0; }
+
+		long long read_cycles() const
+		{
+			long long count = 0;
+			if (fd < 0 or ::read(fd, &count, sizeof(count)) != sizeof(count))
+				return 0;
+			return count;
+		}
+};
+
+struct Result {
+	std::string name;
+	double nsperop;
+	double cyclesperop; // < 0 if not available
+};
+
+class Suite {
+	private:
+		CycleCounter cycles;
+		std::vector<Result> results;
+		std::string filter;
+
+	public:
+		Suite(const std::string &f = "") : filter(f) {}
+
+		/*
+		 * run(name, f): f() performs a batch of operations and returns how
+		 * many, it is called repeatedly with the same inputs
+		 */
+		template <class F>
+		void run(const std::string &name, F &&f)
+		{
+			if (filter != "" and name.find(filter) == std::string::npos)
+				return;
+			long reps = 1;
+			double bestns = -1, bestcycles = -1;
+			for (int batch = 0; batch < 5;) {
+				const long long c0 = cycles.read_cycles();
+				const auto t0 = std::chrono::steady_clock::now();
+				long ops = 0;
+				for (long r = 0; r < reps; r++)
+					ops += f();
+				const double ns = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - t0).count();
+				const long long c1 = cycles.read_cycles();
+				if (ns < 5e7) { // calibrating
+					reps *= 2;
+					continue;
+				}
+				if (ops == 0)
+					break;
+				if (bestns < 0 or ns / ops < bestns) {
+					bestns = ns / ops;
+					bestcycles = (cycles.available()) ? (double)(c1 - c0) / ops : -1;
+				}
+				batch++;
+			}
+			results.push_back(Result {name, bestns, bestcycles});
+			std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(1);
+			std::cout << std::setw(14) << bestns << " ns/op";
+			if (bestcycles >= 0)
+				std::cout << std::setw(14) << bestcycles << " cycles/op";
+			std::cout << std::endl;
+		}
+
+		void save(const std::string &path) const
+		{
+			std::ofstream fs(path);
+			fs << "{\n";
+			for (int i = 0; i < results.size(); i++) {
+				fs << "\t\"" << results[i].name << "\": {\"ns_per_op\": " << results[i].nsperop;
+				fs << ", \"cycles_per_op\": " << results[i].cyclesperop << "}" << ((i + 1 < results.size()) ? "," : "") << "\n";
+			}
+			fs << "}\n";
+		}
+
+		// parse a file written by save(), name -> ns/op
+		static std::map<std::string,double> load(const std::string &path)
+		{
+			std::map<std::string,double> baseline;
+			std::ifstream fs(path);
+			const std::string key = "\"ns_per_op\": ";
+			for (std::string line; std::getline(fs, line);) {
+				const size_t q1 = line.find('"'), q2 = line.find('"', q1 + 1), k = line.find(key);
+				if (q1 == std::string::npos or q2 == std::string::npos or k == std::string::npos)
+					continue;
+				baseline[line.substr(q1 + 1, q2 - q1 - 1)] = std::stod(line.substr(k + key.size()));
+			}
+			return baseline;
+		}
+
+		// true if no benchmark is slower than the baseline by more than tolerance percent
+		bool compare(const std::string &path, double tolerance) const
+		{
+			const std::map<std::string,double> baseline = load(path);
+			bool ok = true;
+			std::cout << std::endl << "Comparison with baseline " << path << " (tolerance " << tolerance << "%)" << std::endl;
+			for (const Result &r : results) {
+				if (!baseline.contains(r.name)) {
+					std::cout << std::left << std::setw(36) << r.name << "   not in baseline" << std::endl;
+					continue;
+				}
+				const double change = (r.nsperop / baseline.at(r.name) - 1) * 100;
+				const bool regression = change > tolerance;
+				ok = ok and !regression;
+				std::cout << std::left << std::setw(36) << r.name << std::right << std::showpos << std::setw(10) << change << std::noshowpos << "%";
+				std::cout << ((regression) ? "   REGRESSION" : "") << std::endl;
+			}
+			return ok;
+		}
+};
+
+/*
+ * fixed random input graph: blocks of 1..maxheight nodes with random labels
+ * of minlen..maxlen bases, long enough to make the graph semi-repeat-free
+ * with high probability, and every node connected to at least one node of
+ * the next block. Node i has id i+1.
+ */
+struct SyntheticEfg {
+	std::vector<std::vector<int>> blocks;
+	std::vector<std::string> labels;
+	std::vector<std::vector<int>> out;
+
+	SyntheticEfg(int nblocks, int maxheight, int minlen, int maxlen, unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		const char bases[] = "ACGT";
+		for (int b = 0; b < nblocks; b++) {
+			const int h = 1 + rng() % maxheight;
+			blocks.push_back({});
+			for (int k = 0; k < h; k++) {
+				std::string label(minlen + rng() % (maxlen - minlen + 1), 'A');
+				for (char &c : label)
+					c = bases[rng() % 4];
+				blocks.back().push_back(labels.size());
+				labels.push_back(label);
+				out.push_back({});
+			}
+		}
+		for (int b = 0; b + 1 < nblocks; b++) {
+			const std::vector<int> &cur = blocks[b], &next = blocks[b+1];
+			for (int k = 0; k < std::max(cur.size(), next.size()); k++) {
+				std::vector<int> &adj = out[cur[k % cur.size()]];
+				const int v = next[k % next.size()];
+				if (std::find(adj.begin(), adj.end(), v) == adj.end())
+					adj.push_back(v);
+			}
+			for (int u : cur) {
+				const int v = next[rng() % next.size()];
+				if (std::find(out[u].begin(), out[u].end(), v) == out[u].end())
+					out[u].push_back(v);
+			}
+		}
+	}
+
+	std::string to_xgfa() const
+	{
+		std::ostringstream ss;
+		ss << "X";
+		for (int b = 0, col = 0; b < blocks.size(); b++) {
+			ss << "\t" << col;
+			col += labels[blocks[b][0]].size();
+		}
+		ss << "\nB";
+		for (const auto &block : blocks)
+			ss << "\t" << block.size();
+		ss << "\n";
+		for (int i = 0; i < labels.size(); i++)
+			ss << "S\t" << i + 1 << "\t" << labels[i] << "\n";
+		for (int i = 0; i < labels.size(); i++)
+			for (int j : out[i])
+				ss << "L\t" << i + 1 << "\t+\t" << j + 1 << "\t+\t0M\n";
+		return ss.str();
+	}
+
+	// random path of nodes from block startblock, of at least length bases if possible
+	std::vector<int> random_path(std::mt19937 &rng, int startblock, long length) const
+	{
+		std::vector<int> path({blocks[startblock][rng() % blocks[startblock].size()]});
+		long spelled = labels[path[0]].size();
+		while (spelled < length and out[path.back()].size() > 0) {
+			path.push_back(out[path.back()][rng() % out[path.back()].size()]);
+			spelled += labels[path.back()].size();
+		}
+		return path;
+	}
+
+	std::string spell(const std::vector<int> &path) const
+	{
+		std::string s;
+		for (int v : path)
+			s += labels[v];
+		return s;
+	}
+};
+
+/*
+ * arguments shared by the bench programs:
+ *   --filter STR          run only the benchmarks whose name contains STR
+ *   --save-baseline FILE  write the results to FILE
+ *   --baseline FILE       compare with FILE, exit 1 on regressions
+ *   --tolerance PERC      allowed slowdown (default 10)
+ */
+struct Args {
+	std::string filter, savepath, baselinepath;
+	double tolerance = 10;
+
+	Args(int argc, char *argv[])
+	{
+		for (int i = 1; i + 1 < argc; i += 2) {
+			const std::string a = argv[i];
+			if (a == "--filter")
+				filter = argv[i+1];
+			else if (a == "--save-baseline")
+				savepath = argv[i+1];
+			else if (a == "--baseline")
+				baselinepath = argv[i+1];
+			else if (a == "--tolerance")
+				tolerance = std::stod(argv[i+1]);
+			else
+				std::cerr << "Unknown argument " << a << ": skipping..." << std::endl;
+		}
+	}
+
+	// to call after the benchmarks, returns the exit value
+	int finish(const Suite &suite) const
+	{
+		if (savepath != "")
+			suite.save(savepath);
+		if (baselinepath != "") {
+			if (access(baselinepath.c_str(), R_OK) != 0) {
+				std::cout << std::endl << "No baseline " << baselinepath << " (make bench-baseline to create it)." << std::endl;
+				return 0;
+			}
+			return (suite.compare(baselinepath, tolerance)) ? 0 : 1;
+		}
+		return 0;
+	}
+};
+
+} // Namespace microbench
+
+#endif
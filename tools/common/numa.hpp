@@ -0,0 +1,91 @@
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+/*
+ * NUMA-aware placement of the compute threads (Linux only, no libnuma):
+ * the topology is read from sysfs, compute thread i is pinned to the CPUs of
+ * node i % nodes, and each node can get its own replica of the read-only
+ * graph index, copied by a thread pinned to that node so that the first-touch
+ * policy allocates it in local memory
+ */
+namespace efg_common {
+
+// parse a sysfs cpulist such as "0-3,8-11"
+std::vector<int> parse_cpulist(const std::string &cpulist)
+{
+	std::vector<int> cpus;
+	std::istringstream ss(cpulist);
+	for (std::string range; std::getline(ss, range, ',');) {
+		if (range.find_first_not_of(" \n") == std::string::npos)
+			continue;
+		const size_t dash = range.find('-');
+		const int first = std::stoi(range.substr(0, dash));
+		const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+		for (int c = first; c <= last; c++)
+			cpus.push_back(c);
+	}
+	return cpus;
+}
+
+// CPUs of each NUMA node with at least one CPU; empty if the topology is unknown
+std::vector<std::vector<int>> numa_nodes_cpus()
+{
+	std::vector<std::vector<int>> nodes;
+	for (int node = 0; ; node++) {
+		const std::filesystem::path p = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+		std::ifstream cpulistfs(p);
+		if (!cpulistfs)
+			break;
+		std::string cpulist;
+		std::getline(cpulistfs, cpulist);
+		std::vector<int> cpus = parse_cpulist(cpulist);
+		if (cpus.size() > 0)
+			nodes.push_back(cpus);
+	}
+	return nodes;
+}
+
+bool pin_thread(pthread_t thread, const std::vector<int> &cpus)
+{
+	cpu_set_t cpuset;
+	CPU_ZERO(&cpuset);
+	for (int c : cpus)
+		CPU_SET(c, &cpuset);
+	return pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+/*
+ * replicas[k] is a copy of graph made on node k; the copy constructor of the
+ * Elasticfoundergraph of efg-locate re-targets the rank/select supports to
+ * the copied bitvectors
+ */
+template <class Graph>
+std::vector<std::unique_ptr<Graph>> replicate_on_nodes(const Graph &graph, const std::vector<std::vector<int>> &nodes)
+{
+	std::vector<std::unique_ptr<Graph>> replicas(nodes.size());
+	std::vector<std::thread> copiers;
+	for (int k = 0; k < nodes.size(); k++) {
+		copiers.push_back(std::thread([&graph, &replicas, &nodes, k]() {
+			pin_thread(pthread_self(), nodes[k]);
+			replicas[k] = std::make_unique<Graph>(graph);
+		}));
+	}
+	for (std::thread &t : copiers)
+		t.join();
+	return replicas;
+}
+
+} // Namespace efg_common
+
+#endif
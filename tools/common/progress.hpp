@@ -0,0 +1,281 @@
+#ifndef PROGRESS_HPP
+#define PROGRESS_HPP
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <unistd.h>
+
+/*
+ * progress reporting (--progress-interval, --status-file): each compute
+ * thread counts its reads, bases and seeds in its own cache line, the reader
+ * counts the input bytes and work (bases or seeds) it has read, and a
+ * reporter thread sums the counters every interval and prints a line on
+ * stderr. The completed fraction is the fraction of the input read, scaled by
+ * the fraction of the read work that is processed, or the fraction of the
+ * reads if they are all loaded beforehand.
+ *
+ * Each compute thread also adds the time it spends in each stage of a read
+ * (seeding, chaining, output) to its counters: the utilisation of a stage is
+ * its time over the time of all the compute threads, and the rest is idle
+ * time waiting for input. The stages are shared with the other tool of the
+ * pipeline (efg-locate seeds, chainx-block-graph chains, both output, and
+ * chainx-block-graph --seed-reads does all three in the same threads), so
+ * that the reports of the two processes of a pipeline show which one idles.
+ */
+namespace efg_common {
+
+enum Stage { STAGE_SEEDING, STAGE_CHAINING, STAGE_OUTPUT, STAGES };
+const char *stagenames[STAGES] = {"seeding", "chaining", "output"};
+
+struct alignas(64) WorkerProgress {
+	std::atomic<long> reads = 0;
+	std::atomic<long> bases = 0;
+	std::atomic<long> seeds = 0;
+	std::atomic<long> stagens[STAGES] = {}; // time in each stage, in nanoseconds
+};
+
+// resident set size in bytes, 0 if unknown
+long resident_memory()
+{
+	std::ifstream statmfs("/proc/self/statm");
+	long size, resident;
+	if (!(statmfs >> size >> resident))
+		return 0;
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+std::string format_duration(long seconds)
+{
+	std::ostringstream ss;
+	ss << std::setfill('0') << std::setw(2) << seconds / 3600 << ":" << std::setw(2) << (seconds / 60) % 60 << ":" << std::setw(2) << seconds % 60;
+	return ss.str();
+}
+
+class ProgressReporter {
+	private:
+		std::vector<std::unique_ptr<WorkerProgress>> workers;
+		std::vector<std::pair<std::string,std::function<long()>>> queues; // (name, depth)
+		double interval = 0;
+		std::filesystem::path statuspath;
+		std::thread reporter;
+		std::atomic<bool> stopped = false;
+		std::chrono::steady_clock::time_point start;
+
+		struct Totals {
+			long reads = 0, bases = 0, seeds = 0;
+			long stagens[STAGES] = {};
+		};
+
+		Totals sum() const
+		{
+			Totals t;
+			for (const auto &w : workers) {
+				t.reads += w->reads.load(std::memory_order_relaxed);
+				t.bases += w->bases.load(std::memory_order_relaxed);
+				t.seeds += w->seeds.load(std::memory_order_relaxed);
+				for (int s = 0; s < STAGES; s++)
+					t.stagens[s] += w->stagens[s].load(std::memory_order_relaxed);
+			}
+			return t;
+		}
+
+		// completed fraction of the input, < 0 if unknown
+		double fraction(const Totals &t) const
+		{
+			if (totalreads > 0)
+				return (double)t.reads / totalreads;
+			const long read = inputbytes.load(std::memory_order_relaxed);
+			const long readwork = inputwork.load(std::memory_order_relaxed);
+			if (totalbytes <= 0 or readwork <= 0)
+				return -1;
+			return std::min(1.0, ((double)read / totalbytes) * ((double)((seedwork) ? t.seeds : t.bases) / readwork));
+		}
+
+		// fraction of the time of the compute threads in each stage between last and t, over dt seconds
+		std::vector<double> utilisation(const Totals &t, const Totals &last, double dt) const
+		{
+			std::vector<double> u(STAGES, 0);
+			for (int s = 0; s < STAGES; s++)
+				u[s] = (t.stagens[s] - last.stagens[s]) / (dt * 1e9 * workers.size());
+			return u;
+		}
+
+		bool stages_used(const Totals &t) const
+		{
+			for (int s = 0; s < STAGES; s++) {
+				if (t.stagens[s] > 0)
+					return true;
+			}
+			return false;
+		}
+
+		void utilisation_to_stream(std::ostream &out, const Totals &t, const std::vector<double> &u) const
+		{
+			double idle = 1;
+			for (int s = 0; s < STAGES; s++) {
+				if (t.stagens[s] > 0) {
+					out << stagenames[s] << " " << u[s] * 100 << "% ";
+					idle -= u[s];
+				}
+			}
+			out << "idle " << std::max(0.0, idle) * 100 << "%";
+		}
+
+		void report(const Totals &t, const Totals &last, double elapsed, double dt) const
+		{
+			const double f = fraction(t);
+			const std::vector<double> u = utilisation(t, last, dt);
+			std::ostringstream line;
+			line << std::fixed << std::setprecision(1);
+			line << "progress: " << t.reads << " reads, " << (t.reads - last.reads) / dt << " reads/s, ";
+			line << (t.bases - last.bases) / dt / 1e6 << " Mbases/s, " << (t.seeds - last.seeds) / dt << " seeds/s";
+			for (const auto &q : queues)
+				line << ", " << q.first << " queue " << q.second();
+			if (stages_used(t)) {
+				line << ", ";
+				utilisation_to_stream(line, t, u);
+			}
+			line << ", RSS " << resident_memory() / 1e9 << " GB";
+			if (f > 0)
+				line << ", " << f * 100 << "%, ETA " << format_duration(elapsed * (1 - f) / f);
+			std::cerr << line.str() + "\n" << std::flush;
+
+			if (statuspath.empty())
+				return;
+			const std::filesystem::path tmppath = statuspath.string() + ".tmp";
+			{
+				std::ofstream statusfs(tmppath, std::ios::out | std::ios::trunc);
+				statusfs << "{\"elapsed_s\": " << elapsed << ", \"reads\": " << t.reads << ", \"bases\": " << t.bases << ", \"seeds\": " << t.seeds;
+				statusfs << ", \"reads_per_s\": " << (t.reads - last.reads) / dt << ", \"bases_per_s\": " << (t.bases - last.bases) / dt << ", \"seeds_per_s\": " << (t.seeds - last.seeds) / dt;
+				for (const auto &q : queues)
+					statusfs << ", \"" << q.first << "_queue\": " << q.second();
+				for (int s = 0; s < STAGES; s++) {
+					if (t.stagens[s] > 0)
+						statusfs << ", \"" << stagenames[s] << "_utilisation\": " << u[s];
+				}
+				statusfs << ", \"rss_bytes\": " << resident_memory();
+				statusfs << ", \"fraction\": " << ((f > 0) ? f : -1) << ", \"eta_s\": " << ((f > 0) ? elapsed * (1 - f) / f : -1) << "}\n";
+			}
+			std::error_code ec;
+			std::filesystem::rename(tmppath, statuspath, ec);
+		}
+
+		void run()
+		{
+			Totals last;
+			auto lasttime = start;
+			while (!stopped) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				const auto now = std::chrono::steady_clock::now();
+				const double dt = std::chrono::duration<double>(now - lasttime).count();
+				if (dt < interval and !stopped)
+					continue;
+				const Totals t = sum();
+				report(t, last, std::chrono::duration<double>(now - start).count(), dt);
+				last = t;
+				lasttime = now;
+			}
+		}
+
+	public:
+		std::atomic<long> inputbytes = 0; // read by the reader
+		std::atomic<long> inputwork = 0;
+		bool seedwork = false; // inputwork counts seeds instead of bases
+		long totalbytes = 0; // size of the input, 0 if unknown
+		long totalreads = 0; // number of reads, if they are loaded beforehand
+
+		void init(int nworkers)
+		{
+			workers.clear();
+			for (int i = 0; i < nworkers; i++)
+				workers.push_back(std::make_unique<WorkerProgress>());
+			start = std::chrono::steady_clock::now();
+		}
+
+		// called by compute thread i after each read
+		void inline count_read(int i, long bases, long seeds)
+		{
+			WorkerProgress &w = *workers[i];
+			w.reads.fetch_add(1, std::memory_order_relaxed);
+			w.bases.fetch_add(bases, std::memory_order_relaxed);
+			w.seeds.fetch_add(seeds, std::memory_order_relaxed);
+		}
+
+		// called by compute thread i, see StageTimer
+		void inline count_stage(int i, Stage stage, long ns)
+		{
+			workers[i]->stagens[stage].fetch_add(ns, std::memory_order_relaxed);
+		}
+
+		void add_queue(const std::string &name, std::function<long()> depth) { queues.push_back({name, depth}); }
+
+		// report every intervalsec seconds (at least 1) until stop()
+		void start_reporting(double intervalsec, const std::filesystem::path &status)
+		{
+			interval = std::max(1.0, intervalsec);
+			statuspath = status;
+			start = std::chrono::steady_clock::now();
+			reporter = std::thread(&ProgressReporter::run, this);
+		}
+
+		void stop()
+		{
+			if (!reporter.joinable())
+				return;
+			stopped = true;
+			reporter.join();
+		}
+
+		// utilisation of the compute threads since init, if they timed their stages
+		void report_utilisation(std::ostream &out) const
+		{
+			const Totals t = sum();
+			if (!stages_used(t))
+				return;
+			const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::ostringstream line;
+			line << std::fixed << std::setprecision(1);
+			line << "utilisation of " << workers.size() << " thread(s) over " << elapsed << " s: ";
+			utilisation_to_stream(line, t, utilisation(t, Totals(), elapsed));
+			out << line.str() << std::endl;
+		}
+};
+
+ProgressReporter progress;
+
+// adds the time of its scope (or until end()) to a stage of compute thread i
+class StageTimer {
+	private:
+		int worker;
+		Stage stage;
+		std::chrono::steady_clock::time_point begin;
+		bool running = true;
+
+	public:
+		StageTimer(int i, Stage stage) : worker(i), stage(stage), begin(std::chrono::steady_clock::now()) {}
+
+		void end()
+		{
+			if (!running)
+				return;
+			running = false;
+			progress.count_stage(worker, stage, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+		}
+
+		~StageTimer() { end(); }
+};
+
+} // Namespace efg_common
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+/*
+ * work-stealing scheduler for the compute threads: the readers push each
+ * task to the deque of the worker with the least pending work, measured in
+ * bases (efg-locate) or anchors (chainx-block-graph) rather than in tasks,
+ * each worker pops from the front of its own
+ * deque, and an idle worker steals from the back of the deque of the most
+ * loaded one. The scheduler also records when each worker completes its last
+ * task and exits, to report the tail time of the run.
+ */
+namespace efg_common {
+
+template <class Task>
+class WorkStealingScheduler {
+	private:
+		struct WorkerDeque {
+			std::mutex mut;
+			std::deque<std::pair<long,Task>> tasks; // (size, task)
+			std::atomic<long> pending = 0; // total size of the tasks
+		};
+		std::vector<std::unique_ptr<WorkerDeque>> deques;
+		std::atomic<long> queued = 0; // tasks in all deques
+		std::atomic<long> steals = 0;
+		long capacity = 0;
+		std::chrono::steady_clock::time_point start;
+		std::vector<double> lastcompletion, exittime; // seconds from start
+
+	public:
+		void init(int workers, long maxqueued)
+		{
+			deques.clear();
+			for (int i = 0; i < workers; i++)
+				deques.push_back(std::make_unique<WorkerDeque>());
+			capacity = maxqueued;
+			start = std::chrono::steady_clock::now();
+			lastcompletion.assign(workers, 0.0);
+			exittime.assign(workers, 0.0);
+		}
+
+		// blocks while there are too many queued tasks
+		void push(Task &&task, long size)
+		{
+			while (queued.load() >= capacity)
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+			int target = 0;
+			for (int i = 1; i < deques.size(); i++) {
+				if (deques[i]->pending.load() < deques[target]->pending.load())
+					target = i;
+			}
+			std::scoped_lock lck {deques[target]->mut};
+			deques[target]->tasks.push_back(std::pair<long,Task>(size, std::move(task)));
+			deques[target]->pending += size;
+			queued += 1;
+		}
+
+		bool pop(int worker, Task &task)
+		{
+			{
+				WorkerDeque &own = *deques[worker];
+				std::scoped_lock lck {own.mut};
+				if (own.tasks.size() > 0) {
+					task = std::move(own.tasks.front().second);
+					own.pending -= own.tasks.front().first;
+					own.tasks.pop_front();
+					queued -= 1;
+					return true;
+				}
+			}
+
+			// steal, retrying if the victim was emptied in the meantime
+			while (queued.load() > 0) {
+				int victim = -1;
+				for (int i = 0; i < deques.size(); i++) {
+					if (i != worker and deques[i]->pending.load() > 0 and
+							(victim == -1 or deques[i]->pending.load() > deques[victim]->pending.load()))
+						victim = i;
+				}
+				if (victim == -1)
+					return false;
+
+				WorkerDeque &other = *deques[victim];
+				std::scoped_lock lck {other.mut};
+				if (other.tasks.size() > 0) {
+					task = std::move(other.tasks.back().second);
+					other.pending -= other.tasks.back().first;
+					other.tasks.pop_back();
+					queued -= 1;
+					steals += 1;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void task_done(int worker)
+		{
+			lastcompletion[worker] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		void worker_exit(int worker)
+		{
+			exittime[worker] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		long get_steals() const { return steals.load(); }
+
+		long get_queued() const { return queued.load(); }
+
+		// gap between the completion of the last task and the exit of the median worker
+		double tail_time() const
+		{
+			if (exittime.size() == 0)
+				return 0;
+			std::vector<double> exits = exittime;
+			std::sort(exits.begin(), exits.end());
+			const double last = *std::max_element(lastcompletion.begin(), lastcompletion.end());
+			return std::max(0.0, last - exits[(exits.size() - 1) / 2]);
+		}
+};
+
+} // Namespace efg_common
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SHARDS_HPP
+#define SHARDS_HPP
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+ * sharded output: each compute thread writes to its own file
+ * <output>.shard<i> and the output file itself is a manifest listing the
+ * shards, e.g.
+ *
+ *   #sharded-gaf	2
+ *   seeds.gaf.shard0
+ *   seeds.gaf.shard1
+ *
+ * where the shard paths are relative to the directory of the manifest.
+ * The results of one read are always in a single shard, so the
+ * concatenation of the shards is equivalent to the unsharded output.
+ * The anchors file in input of chainx-block-graph can be such a manifest
+ * (e.g. written by efg-locate --sharded-output), in which case the shards
+ * are read directly.
+ */
+namespace efg_common {
+
+const std::string shard_manifest_header = "#sharded-gaf";
+
+std::filesystem::path shard_path(const std::filesystem::path &outputpath, int shard)
+{
+	std::filesystem::path p = outputpath;
+	p += ".shard" + std::to_string(shard);
+	return p;
+}
+
+bool open_shards(const std::filesystem::path &outputpath, int shards, bool overwrite, std::vector<std::ofstream> &shardfs)
+{
+	for (int i = 0; i < shards; i++) {
+		const std::filesystem::path p = shard_path(outputpath, i);
+		if (std::filesystem::exists(p) and !overwrite) {
+			std::cerr << "Error: shard file " << p << " already exists." << std::endl;
+			return false;
+		}
+		shardfs.push_back(std::ofstream(p, std::ios::out | std::ios::trunc));
+		if (!shardfs.back()) {
+			std::cerr << "Error opening shard file " << p << "." << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+void write_shard_manifest(std::ofstream &manifestfs, const std::filesystem::path &outputpath, int shards)
+{
+	manifestfs << shard_manifest_header << "\t" << shards << "\n";
+	for (int i = 0; i < shards; i++)
+		manifestfs << shard_path(outputpath, i).filename().string() << "\n";
+}
+
+/*
+ * paths of the shards if path is a shard manifest, {path} otherwise; only
+ * regular files are inspected, reading a pipe would consume its input
+ */
+std::vector<std::filesystem::path> read_shard_manifest(const std::filesystem::path &path)
+{
+	std::error_code ec;
+	if (!std::filesystem::is_regular_file(path, ec))
+		return {path};
+	std::ifstream manifestfs(path);
+	std::string line;
+	if (!manifestfs or !std::getline(manifestfs, line) or !line.starts_with(shard_manifest_header))
+		return {path};
+
+	std::vector<std::filesystem::path> shards;
+	while (std::getline(manifestfs, line)) {
+		if (line != "")
+			shards.push_back(path.parent_path() / line);
+	}
+	return shards;
+}
+
+} // Namespace efg_common
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+/*
+ * per-read tracing (--trace): each compute thread collects the spans of the
+ * read it is processing in a thread-local buffer, and the read is added to
+ * the trace only if its processing took at least the threshold, so that the
+ * trace holds the slowest reads only. The time a read waited in the input
+ * queue is an argument of its "read" span, since it overlaps the processing
+ * of the previous reads on the same thread. The trace is written in Chrome
+ * trace-event format, to be opened in chrome://tracing or Perfetto. When
+ * tracing is off, a span costs one branch.
+ */
+namespace efg_common {
+
+struct TraceEvent {
+	std::string name;
+	std::string read;
+	int tid;
+	double ts, dur; // microseconds from the start of the run
+	double queue = -1; // of a whole read, time spent in the input queue
+};
+
+class Tracer {
+	private:
+		std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+		std::mutex mut;
+		std::vector<TraceEvent> events;
+		std::atomic<int> nexttid = 0;
+		long tracedreads = 0;
+
+	public:
+		bool enabled = false;
+		double thresholdus = 0;
+
+		void init(double thresholdms)
+		{
+			enabled = true;
+			thresholdus = thresholdms * 1000;
+		}
+
+		double now_us() const
+		{
+			return std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now() - origin).count();
+		}
+
+		int new_tid() { return nexttid++; }
+
+		void add_read(std::vector<TraceEvent> &spans)
+		{
+			std::scoped_lock lck {mut};
+			events.insert(events.end(), spans.begin(), spans.end());
+			tracedreads += 1;
+		}
+
+		long get_traced_reads() const { return tracedreads; }
+
+		void write(std::ofstream &tracefs)
+		{
+			std::scoped_lock lck {mut};
+			tracefs << "{\"traceEvents\":[";
+			for (int i = 0; i < events.size(); i++) {
+				const TraceEvent &e = events[i];
+				tracefs << ((i == 0) ? "\n" : ",\n");
+				tracefs << "{\"name\":\"" << e.name << "\",\"cat\":\"read\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid;
+				tracefs << ",\"ts\":" << std::fixed << e.ts << ",\"dur\":" << e.dur << std::defaultfloat;
+				tracefs << ",\"args\":{\"read\":\"";
+				for (char c : e.read) {
+					if (c == '"' or c == '\\')
+						tracefs << '\\';
+					tracefs << c;
+				}
+				tracefs << "\"";
+				if (e.queue >= 0)
+					tracefs << ",\"queue_us\":" << std::fixed << e.queue << std::defaultfloat;
+				tracefs << "}}";
+			}
+			tracefs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		}
+};
+
+Tracer tracer;
+
+// read being processed by this thread
+struct ReadTrace {
+	bool active = false;
+	int tid = -1;
+	std::string read;
+	double start, queued;
+	std::vector<TraceEvent> spans;
+};
+thread_local ReadTrace readtrace;
+
+// queuedus is when the read entered the input queue, or < 0 if unknown
+void inline trace_read_begin(const std::string &read, double queuedus = -1)
+{
+	if (!tracer.enabled)
+		return;
+	if (readtrace.tid == -1)
+		readtrace.tid = tracer.new_tid();
+	readtrace.active = true;
+	readtrace.read = read;
+	readtrace.start = tracer.now_us();
+	readtrace.queued = queuedus;
+	readtrace.spans.clear();
+}
+
+void inline trace_read_end()
+{
+	if (!readtrace.active)
+		return;
+	readtrace.active = false;
+	const double dur = tracer.now_us() - readtrace.start;
+	if (dur < tracer.thresholdus)
+		return;
+	const double queue = (readtrace.queued >= 0) ? readtrace.start - readtrace.queued : -1;
+	readtrace.spans.push_back(TraceEvent {"read", readtrace.read, readtrace.tid, readtrace.start, dur, queue});
+	tracer.add_read(readtrace.spans);
+}
+
+// span from construction to end() or destruction, recorded only inside a traced read
+class TraceSpan {
+	private:
+		const char *name;
+		double start = -1;
+
+	public:
+		TraceSpan(const char *n) : name(n)
+		{
+			if (readtrace.active)
+				start = tracer.now_us();
+		}
+
+		void end()
+		{
+			if (start >= 0 and readtrace.active)
+				readtrace.spans.push_back(TraceEvent {name, readtrace.read, readtrace.tid, start, tracer.now_us() - start});
+			start = -1;
+		}
+
+		~TraceSpan() { end(); }
+};
+
+} // Namespace efg_common
+
+#endif
@@ -0,0 +1,1080 @@
+/*
+  File autogenerated by gengetopt version 2.23
+  generated with the following command:
+  gengetopt --input=./command-line-parsing/config.ggo --output-dir=./command-line-parsing/ --unnamed-opts 
+
+  The developers of gengetopt consider the fixed text that goes in all
+  gengetopt output files to be in the public domain:
+  we make no copyright claims on it.
+*/
+
+/* If we use autoconf.  */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef FIX_UNUSED
+#define FIX_UNUSED(X) (void) (X) /* avoid warnings for unused params */
+#endif
+
+#include <getopt.h>
+
+#include "cmdline.h"
+
+const char *gengetopt_args_info_purpose = "Program to generate random semi-repeat-free Elastic Founder Graphs and reads\nsampled from them.";
+
+const char *gengetopt_args_info_usage = "Usage: efg-generate graph.gfa [reads.fastq truth.gaf]";
+
+const char *gengetopt_args_info_versiontext = "";
+
+const char *gengetopt_args_info_description = "The program writes a random semi-repeat-free Elastic Founder Graph in xGFA\nformat and, if the read and ground truth paths are given, simulates reads from\nrandom paths of the graph, adding errors, and writes in GAF format the graph\npath each read was sampled from. The output only depends on the options and on\nthe seed.";
+
+const char *gengetopt_args_info_full_help[] = {
+  "  -h, --help                    Print help and exit",
+  "      --full-help               Print help, including hidden options, and exit",
+  "  -V, --version                 Print version and exit",
+  "  -b, --blocks=N                Number of blocks  (default=`1000')",
+  "      --min-height=H            Minimum number of nodes of a block\n                                  (default=`1')",
+  "      --max-height=H            Maximum number of nodes of a block\n                                  (default=`4')",
+  "      --min-label-length=L      Minimum length of a node label, resampled until\n                                  the graph is semi-repeat-free (should be at\n                                  least log4 of the graph length)\n                                  (default=`12')",
+  "      --max-label-length=L      Maximum length of a node label  (default=`40')",
+  "      --label-length-distribution=DIST\n                                Distribution of the label lengths in [min,max]:\n                                  uniform, or geometric with mean 2*min (short\n                                  labels common, long labels rare)\n                                  (default=`uniform')",
+  "      --edge-probability=P      Probability of an edge between two nodes of\n                                  adjacent blocks, in addition to the edges\n                                  connecting every node  (default=`0.2')",
+  "      --source-probability=P    Probability that a node not in the first block\n                                  has no incoming edges  (default=`0')",
+  "      --sink-probability=P      Probability that a node not in the last block\n                                  has no outgoing edges  (default=`0')",
+  "  -n, --reads=N                 Number of reads  (default=`1000')",
+  "      --read-type=TYPE          Defaults of the read options: long (mean length\n                                  10000, 10% errors, mostly indels) or short\n                                  (length 150, 1% substitutions)\n                                  (default=`long')",
+  "      --read-length=L           Mean read length (default from --read-type)",
+  "      --read-length-stdev=SD    Standard deviation of the read length, gamma\n                                  distributed (default from --read-type)",
+  "      --error-rate=P            Probability of an error at each base (default\n                                  from --read-type)",
+  "      --substitutions=W         Relative frequency of substitutions among\n                                  errors (default from --read-type)",
+  "      --insertions=W            Relative frequency of insertions among errors\n                                  (default from --read-type)",
+  "      --deletions=W             Relative frequency of deletions among errors\n                                  (default from --read-type)",
+  "      --reverse-probability=P   Probability that a read is the reverse\n                                  complement of its path  (default=`0.5')",
+  "      --resample-rounds=N       Maximum number of rounds resampling the labels\n                                  that break the semi-repeat-free property\n                                  (default=`100')",
+  "  -s, --seed=LONG               Random seed  (default=`42')",
+  "      --overwrite               Overwrite the output files, if they exist\n                                  (default=off)",
+    0
+};
+
+static void
+init_help_array(void)
+{
+  gengetopt_args_info_help[0] = gengetopt_args_info_full_help[0];
+  gengetopt_args_info_help[1] = gengetopt_args_info_full_help[1];
+  gengetopt_args_info_help[2] = gengetopt_args_info_full_help[2];
+  gengetopt_args_info_help[3] = gengetopt_args_info_full_help[3];
+  gengetopt_args_info_help[4] = gengetopt_args_info_full_help[4];
+  gengetopt_args_info_help[5] = gengetopt_args_info_full_help[5];
+  gengetopt_args_info_help[6] = gengetopt_args_info_full_help[6];
+  gengetopt_args_info_help[7] = gengetopt_args_info_full_help[7];
+  gengetopt_args_info_help[8] = gengetopt_args_info_full_help[8];
+  gengetopt_args_info_help[9] = gengetopt_args_info_full_help[9];
+  gengetopt_args_info_help[10] = gengetopt_args_info_full_help[10];
+  gengetopt_args_info_help[11] = gengetopt_args_info_full_help[11];
+  gengetopt_args_info_help[12] = gengetopt_args_info_full_help[12];
+  gengetopt_args_info_help[13] = gengetopt_args_info_full_help[13];
+  gengetopt_args_info_help[14] = gengetopt_args_info_full_help[14];
+  gengetopt_args_info_help[15] = gengetopt_args_info_full_help[15];
+  gengetopt_args_info_help[16] = gengetopt_args_info_full_help[16];
+  gengetopt_args_info_help[17] = gengetopt_args_info_full_help[17];
+  gengetopt_args_info_help[18] = gengetopt_args_info_full_help[18];
+  gengetopt_args_info_help[19] = gengetopt_args_info_full_help[19];
+  gengetopt_args_info_help[20] = gengetopt_args_info_full_help[20];
+  gengetopt_args_info_help[21] = gengetopt_args_info_full_help[22];
+  gengetopt_args_info_help[22] = gengetopt_args_info_full_help[23];
+  gengetopt_args_info_help[23] = 0; 
+  
+}
+
+const char *gengetopt_args_info_help[24];
+
+typedef enum {ARG_NO
+  , ARG_FLAG
+  , ARG_STRING
+  , ARG_INT
+  , ARG_LONG
+  , ARG_DOUBLE
+} cmdline_parser_arg_type;
+
+static
+void clear_given (struct gengetopt_args_info *args_info);
+static
+void clear_args (struct gengetopt_args_info *args_info);
+
+static int
+cmdline_parser_internal (int argc, char **argv, struct gengetopt_args_info *args_info,
+                        struct cmdline_parser_params *params, const char *additional_error);
+
+
+static char *
+gengetopt_strdup (const char *s);
+
+static
+void clear_given (struct gengetopt_args_info *args_info)
+{
+  args_info->help_given = 0 ;
+  args_info->full_help_given = 0 ;
+  args_info->version_given = 0 ;
+  args_info->blocks_given = 0 ;
+  args_info->min_height_given = 0 ;
+  args_info->max_height_given = 0 ;
+  args_info->min_label_length_given = 0 ;
+  args_info->max_label_length_given = 0 ;
+  args_info->label_length_distribution_given = 0 ;
+  args_info->edge_probability_given = 0 ;
+  args_info->source_probability_given = 0 ;
+  args_info->sink_probability_given = 0 ;
+  args_info->reads_given = 0 ;
+  args_info->read_type_given = 0 ;
+  args_info->read_length_given = 0 ;
+  args_info->read_length_stdev_given = 0 ;
+  args_info->error_rate_given = 0 ;
+  args_info->substitutions_given = 0 ;
+  args_info->insertions_given = 0 ;
+  args_info->deletions_given = 0 ;
+  args_info->reverse_probability_given = 0 ;
+  args_info->resample_rounds_given = 0 ;
+  args_info->seed_given = 0 ;
+  args_info->overwrite_given = 0 ;
+}
+
+static
+void clear_args (struct gengetopt_args_info *args_info)
+{
+  FIX_UNUSED (args_info);
+  args_info->blocks_arg = 1000;
+  args_info->blocks_orig = NULL;
+  args_info->min_height_arg = 1;
+  args_info->min_height_orig = NULL;
+  args_info->max_height_arg = 4;
+  args_info->max_height_orig = NULL;
+  args_info->min_label_length_arg = 12;
+  args_info->min_label_length_orig = NULL;
+  args_info->max_label_length_arg = 40;
+  args_info->max_label_length_orig = NULL;
+  args_info->label_length_distribution_arg = gengetopt_strdup ("uniform");
+  args_info->label_length_distribution_orig = NULL;
+  args_info->edge_probability_arg = 0.2;
+  args_info->edge_probability_orig = NULL;
+  args_info->source_probability_arg = 0;
+  args_info->source_probability_orig = NULL;
+  args_info->sink_probability_arg = 0;
+  args_info->sink_probability_orig = NULL;
+  args_info->reads_arg = 1000;
+  args_info->reads_orig = NULL;
+  args_info->read_type_arg = gengetopt_strdup ("long");
+  args_info->read_type_orig = NULL;
+  args_info->read_length_orig = NULL;
+  args_info->read_length_stdev_orig = NULL;
+  args_info->error_rate_orig = NULL;
+  args_info->substitutions_orig = NULL;
+  args_info->insertions_orig = NULL;
+  args_info->deletions_orig = NULL;
+  args_info->reverse_probability_arg = 0.5;
+  args_info->reverse_probability_orig = NULL;
+  args_info->resample_rounds_arg = 100;
+  args_info->resample_rounds_orig = NULL;
+  args_info->seed_arg = 42;
+  args_info->seed_orig = NULL;
+  args_info->overwrite_flag = 0;
+  
+}
+
+static
+void init_args_info(struct gengetopt_args_info *args_info)
+{
+
+  init_help_array(); 
+  args_info->help_help = gengetopt_args_info_full_help[0] ;
+  args_info->full_help_help = gengetopt_args_info_full_help[1] ;
+  args_info->version_help = gengetopt_args_info_full_help[2] ;
+  args_info->blocks_help = gengetopt_args_info_full_help[3] ;
+  args_info->min_height_help = gengetopt_args_info_full_help[4] ;
+  args_info->max_height_help = gengetopt_args_info_full_help[5] ;
+  args_info->min_label_length_help = gengetopt_args_info_full_help[6] ;
+  args_info->max_label_length_help = gengetopt_args_info_full_help[7] ;
+  args_info->label_length_distribution_help = gengetopt_args_info_full_help[8] ;
+  args_info->edge_probability_help = gengetopt_args_info_full_help[9] ;
+  args_info->source_probability_help = gengetopt_args_info_full_help[10] ;
+  args_info->sink_probability_help = gengetopt_args_info_full_help[11] ;
+  args_info->reads_help = gengetopt_args_info_full_help[12] ;
+  args_info->read_type_help = gengetopt_args_info_full_help[13] ;
+  args_info->read_length_help = gengetopt_args_info_full_help[14] ;
+  args_info->read_length_stdev_help = gengetopt_args_info_full_help[15] ;
+  args_info->error_rate_help = gengetopt_args_info_full_help[16] ;
+  args_info->substitutions_help = gengetopt_args_info_full_help[17] ;
+  args_info->insertions_help = gengetopt_args_info_full_help[18] ;
+  args_info->deletions_help = gengetopt_args_info_full_help[19] ;
+  args_info->reverse_probability_help = gengetopt_args_info_full_help[20] ;
+  args_info->resample_rounds_help = gengetopt_args_info_full_help[21] ;
+  args_info->seed_help = gengetopt_args_info_full_help[22] ;
+  args_info->overwrite_help = gengetopt_args_info_full_help[23] ;
+  
+}
+
+void
+cmdline_parser_print_version (void)
+{
+  printf ("%s %s\n",
+     (strlen(CMDLINE_PARSER_PACKAGE_NAME) ? CMDLINE_PARSER_PACKAGE_NAME : CMDLINE_PARSER_PACKAGE),
+     CMDLINE_PARSER_VERSION);
+
+  if (strlen(gengetopt_args_info_versiontext) > 0)
+    printf("\n%s\n", gengetopt_args_info_versiontext);
+}
+
+static void print_help_common(void)
+{
+	size_t len_purpose = strlen(gengetopt_args_info_purpose);
+	size_t len_usage = strlen(gengetopt_args_info_usage);
+
+	if (len_usage > 0) {
+		printf("%s\n", gengetopt_args_info_usage);
+	}
+	if (len_purpose > 0) {
+		printf("%s\n", gengetopt_args_info_purpose);
+	}
+
+	if (len_usage || len_purpose) {
+		printf("\n");
+	}
+
+	if (strlen(gengetopt_args_info_description) > 0) {
+		printf("%s\n\n", gengetopt_args_info_description);
+	}
+}
+
+void
+cmdline_parser_print_help (void)
+{
+  int i = 0;
+  print_help_common();
+  while (gengetopt_args_info_help[i])
+    printf("%s\n", gengetopt_args_info_help[i++]);
+}
+
+void
+cmdline_parser_print_full_help (void)
+{
+  int i = 0;
+  print_help_common();
+  while (gengetopt_args_info_full_help[i])
+    printf("%s\n", gengetopt_args_info_full_help[i++]);
+}
+
+void
+cmdline_parser_init (struct gengetopt_args_info *args_info)
+{
+  clear_given (args_info);
+  clear_args (args_info);
+  init_args_info (args_info);
+
+  args_info->inputs = 0;
+  args_info->inputs_num = 0;
+}
+
+void
+cmdline_parser_params_init(struct cmdline_parser_params *params)
+{
+  if (params)
+    { 
+      params->override = 0;
+      params->initialize = 1;
+      params->check_required = 1;
+      params->check_ambiguity = 0;
+      params->print_errors = 1;
+    }
+}
+
+struct cmdline_parser_params *
+cmdline_parser_params_create(void)
+{
+  struct cmdline_parser_params *params = 
+    (struct cmdline_parser_params *)malloc(sizeof(struct cmdline_parser_params));
+  cmdline_parser_params_init(params);  
+  return params;
+}
+
+static void
+free_string_field (char **s)
+{
+  if (*s)
+    {
+      free (*s);
+      *s = 0;
+    }
+}
+
+
+static void
+cmdline_parser_release (struct gengetopt_args_info *args_info)
+{
+  unsigned int i;
+  free_string_field (&(args_info->blocks_orig));
+  free_string_field (&(args_info->min_height_orig));
+  free_string_field (&(args_info->max_height_orig));
+  free_string_field (&(args_info->min_label_length_orig));
+  free_string_field (&(args_info->max_label_length_orig));
+  free_string_field (&(args_info->label_length_distribution_arg));
+  free_string_field (&(args_info->label_length_distribution_orig));
+  free_string_field (&(args_info->edge_probability_orig));
+  free_string_field (&(args_info->source_probability_orig));
+  free_string_field (&(args_info->sink_probability_orig));
+  free_string_field (&(args_info->reads_orig));
+  free_string_field (&(args_info->read_type_arg));
+  free_string_field (&(args_info->read_type_orig));
+  free_string_field (&(args_info->read_length_orig));
+  free_string_field (&(args_info->read_length_stdev_orig));
+  free_string_field (&(args_info->error_rate_orig));
+  free_string_field (&(args_info->substitutions_orig));
+  free_string_field (&(args_info->insertions_orig));
+  free_string_field (&(args_info->deletions_orig));
+  free_string_field (&(args_info->reverse_probability_orig));
+  free_string_field (&(args_info->resample_rounds_orig));
+  free_string_field (&(args_info->seed_orig));
+  
+  
+  for (i = 0; i < args_info->inputs_num; ++i)
+    free (args_info->inputs [i]);
+
+  if (args_info->inputs_num)
+    free (args_info->inputs);
+
+  clear_given (args_info);
+}
+
+
+static void
+write_into_file(FILE *outfile, const char *opt, const char *arg, const char *values[])
+{
+  FIX_UNUSED (values);
+  if (arg) {
+    fprintf(outfile, "%s=\"%s\"\n", opt, arg);
+  } else {
+    fprintf(outfile, "%s\n", opt);
+  }
+}
+
+
+int
+cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
+{
+  int i = 0;
+
+  if (!outfile)
+    {
+      fprintf (stderr, "%s: cannot dump options to stream\n", CMDLINE_PARSER_PACKAGE);
+      return EXIT_FAILURE;
+    }
+
+  if (args_info->help_given)
+    write_into_file(outfile, "help", 0, 0 );
+  if (args_info->full_help_given)
+    write_into_file(outfile, "full-help", 0, 0 );
+  if (args_info->version_given)
+    write_into_file(outfile, "version", 0, 0 );
+  if (args_info->blocks_given)
+    write_into_file(outfile, "blocks", args_info->blocks_orig, 0);
+  if (args_info->min_height_given)
+    write_into_file(outfile, "min-height", args_info->min_height_orig, 0);
+  if (args_info->max_height_given)
+    write_into_file(outfile, "max-height", args_info->max_height_orig, 0);
+  if (args_info->min_label_length_given)
+    write_into_file(outfile, "min-label-length", args_info->min_label_length_orig, 0);
+  if (args_info->max_label_length_given)
+    write_into_file(outfile, "max-label-length", args_info->max_label_length_orig, 0);
+  if (args_info->label_length_distribution_given)
+    write_into_file(outfile, "label-length-distribution", args_info->label_length_distribution_orig, 0);
+  if (args_info->edge_probability_given)
+    write_into_file(outfile, "edge-probability", args_info->edge_probability_orig, 0);
+  if (args_info->source_probability_given)
+    write_into_file(outfile, "source-probability", args_info->source_probability_orig, 0);
+  if (args_info->sink_probability_given)
+    write_into_file(outfile, "sink-probability", args_info->sink_probability_orig, 0);
+  if (args_info->reads_given)
+    write_into_file(outfile, "reads", args_info->reads_orig, 0);
+  if (args_info->read_type_given)
+    write_into_file(outfile, "read-type", args_info->read_type_orig, 0);
+  if (args_info->read_length_given)
+    write_into_file(outfile, "read-length", args_info->read_length_orig, 0);
+  if (args_info->read_length_stdev_given)
+    write_into_file(outfile, "read-length-stdev", args_info->read_length_stdev_orig, 0);
+  if (args_info->error_rate_given)
+    write_into_file(outfile, "error-rate", args_info->error_rate_orig, 0);
+  if (args_info->substitutions_given)
+    write_into_file(outfile, "substitutions", args_info->substitutions_orig, 0);
+  if (args_info->insertions_given)
+    write_into_file(outfile, "insertions", args_info->insertions_orig, 0);
+  if (args_info->deletions_given)
+    write_into_file(outfile, "deletions", args_info->deletions_orig, 0);
+  if (args_info->reverse_probability_given)
+    write_into_file(outfile, "reverse-probability", args_info->reverse_probability_orig, 0);
+  if (args_info->resample_rounds_given)
+    write_into_file(outfile, "resample-rounds", args_info->resample_rounds_orig, 0);
+  if (args_info->seed_given)
+    write_into_file(outfile, "seed", args_info->seed_orig, 0);
+  if (args_info->overwrite_given)
+    write_into_file(outfile, "overwrite", 0, 0 );
+  
+
+  i = EXIT_SUCCESS;
+  return i;
+}
+
+int
+cmdline_parser_file_save(const char *filename, struct gengetopt_args_info *args_info)
+{
+  FILE *outfile;
+  int i = 0;
+
+  outfile = fopen(filename, "w");
+
+  if (!outfile)
+    {
+      fprintf (stderr, "%s: cannot open file for writing: %s\n", CMDLINE_PARSER_PACKAGE, filename);
+      return EXIT_FAILURE;
+    }
+
+  i = cmdline_parser_dump(outfile, args_info);
+  fclose (outfile);
+
+  return i;
+}
+
+void
+cmdline_parser_free (struct gengetopt_args_info *args_info)
+{
+  cmdline_parser_release (args_info);
+}
+
+/** @brief replacement of strdup, which is not standard */
+char *
+gengetopt_strdup (const char *s)
+{
+  char *result = 0;
+  if (!s)
+    return result;
+
+  result = (char*)malloc(strlen(s) + 1);
+  if (result == (char*)0)
+    return (char*)0;
+  strcpy(result, s);
+  return result;
+}
+
+int
+cmdline_parser (int argc, char **argv, struct gengetopt_args_info *args_info)
+{
+  return cmdline_parser2 (argc, argv, args_info, 0, 1, 1);
+}
+
+int
+cmdline_parser_ext (int argc, char **argv, struct gengetopt_args_info *args_info,
+                   struct cmdline_parser_params *params)
+{
+  int result;
+  result = cmdline_parser_internal (argc, argv, args_info, params, 0);
+
+  if (result == EXIT_FAILURE)
+    {
+      cmdline_parser_free (args_info);
+      exit (EXIT_FAILURE);
+    }
+  
+  return result;
+}
+
+int
+cmdline_parser2 (int argc, char **argv, struct gengetopt_args_info *args_info, int override, int initialize, int check_required)
+{
+  int result;
+  struct cmdline_parser_params params;
+  
+  params.override = override;
+  params.initialize = initialize;
+  params.check_required = check_required;
+  params.check_ambiguity = 0;
+  params.print_errors = 1;
+
+  result = cmdline_parser_internal (argc, argv, args_info, &params, 0);
+
+  if (result == EXIT_FAILURE)
+    {
+      cmdline_parser_free (args_info);
+      exit (EXIT_FAILURE);
+    }
+  
+  return result;
+}
+
+int
+cmdline_parser_required (struct gengetopt_args_info *args_info, const char *prog_name)
+{
+  FIX_UNUSED (args_info);
+  FIX_UNUSED (prog_name);
+  return EXIT_SUCCESS;
+}
+
+
+static char *package_name = 0;
+
+/**
+ * @brief updates an option
+ * @param field the generic pointer to the field to update
+ * @param orig_field the pointer to the orig field
+ * @param field_given the pointer to the number of occurrence of this option
+ * @param prev_given the pointer to the number of occurrence already seen
+ * @param value the argument for this option (if null no arg was specified)
+ * @param possible_values the possible values for this option (if specified)
+ * @param default_value the default value (in case the option only accepts fixed values)
+ * @param arg_type the type of this option
+ * @param check_ambiguity @see cmdline_parser_params.check_ambiguity
+ * @param override @see cmdline_parser_params.override
+ * @param no_free whether to free a possible previous value
+ * @param multiple_option whether this is a multiple option
+ * @param long_opt the corresponding long option
+ * @param short_opt the corresponding short option (or '-' if none)
+ * @param additional_error possible further error specification
+ */
+static
+int update_arg(void *field, char **orig_field,
+               unsigned int *field_given, unsigned int *prev_given, 
+               char *value, const char *possible_values[],
+               const char *default_value,
+               cmdline_parser_arg_type arg_type,
+               int check_ambiguity, int override,
+               int no_free, int multiple_option,
+               const char *long_opt, char short_opt,
+               const char *additional_error)
+{
+  char *stop_char = 0;
+  const char *val = value;
+  int found;
+  char **string_field;
+  FIX_UNUSED (field);
+
+  stop_char = 0;
+  found = 0;
+
+  if (!multiple_option && prev_given && (*prev_given || (check_ambiguity && *field_given)))
+    {
+      if (short_opt != '-')
+        fprintf (stderr, "%s: `--%s' (`-%c') option given more than once%s\n", 
+               package_name, long_opt, short_opt,
+               (additional_error ? additional_error : ""));
+      else
+        fprintf (stderr, "%s: `--%s' option given more than once%s\n", 
+               package_name, long_opt,
+               (additional_error ? additional_error : ""));
+      return 1; /* failure */
+    }
+
+  FIX_UNUSED (default_value);
+    
+  if (field_given && *field_given && ! override)
+    return 0;
+  if (prev_given)
+    (*prev_given)++;
+  if (field_given)
+    (*field_given)++;
+  if (possible_values)
+    val = possible_values[found];
+
+  switch(arg_type) {
+  case ARG_FLAG:
+    *((int *)field) = !*((int *)field);
+    break;
+  case ARG_INT:
+    if (val) *((int *)field) = strtol (val, &stop_char, 0);
+    break;
+  case ARG_LONG:
+    if (val) *((long *)field) = (long)strtol (val, &stop_char, 0);
+    break;
+  case ARG_DOUBLE:
+    if (val) *((double *)field) = strtod (val, &stop_char);
+    break;
+  case ARG_STRING:
+    if (val) {
+      string_field = (char **)field;
+      if (!no_free && *string_field)
+        free (*string_field); /* free previous string */
+      *string_field = gengetopt_strdup (val);
+    }
+    break;
+  default:
+    break;
+  };
+
+  /* check numeric conversion */
+  switch(arg_type) {
+  case ARG_INT:
+  case ARG_LONG:
+  case ARG_DOUBLE:
+    if (val && !(stop_char && *stop_char == '\0')) {
+      fprintf(stderr, "%s: invalid numeric value: %s\n", package_name, val);
+      return 1; /* failure */
+    }
+    break;
+  default:
+    ;
+  };
+
+  /* store the original value */
+  switch(arg_type) {
+  case ARG_NO:
+  case ARG_FLAG:
+    break;
+  default:
+    if (value && orig_field) {
+      if (no_free) {
+        *orig_field = value;
+      } else {
+        if (*orig_field)
+          free (*orig_field); /* free previous string */
+        *orig_field = gengetopt_strdup (value);
+      }
+    }
+  };
+
+  return 0; /* OK */
+}
+
+
+int
+cmdline_parser_internal (
+  int argc, char **argv, struct gengetopt_args_info *args_info,
+                        struct cmdline_parser_params *params, const char *additional_error)
+{
+  int c;	/* Character of the parsed option.  */
+
+  int error_occurred = 0;
+  struct gengetopt_args_info local_args_info;
+  
+  int override;
+  int initialize;
+  int check_required;
+  int check_ambiguity;
+  
+  package_name = argv[0];
+  
+  /* TODO: Why is this here? It is not used anywhere. */
+  override = params->override;
+  FIX_UNUSED(override);
+
+  initialize = params->initialize;
+  check_required = params->check_required;
+
+  /* TODO: Why is this here? It is not used anywhere. */
+  check_ambiguity = params->check_ambiguity;
+  FIX_UNUSED(check_ambiguity);
+
+  if (initialize)
+    cmdline_parser_init (args_info);
+
+  cmdline_parser_init (&local_args_info);
+
+  optarg = 0;
+  optind = 0;
+  opterr = params->print_errors;
+  optopt = '?';
+
+  while (1)
+    {
+      int option_index = 0;
+
+      static struct option long_options[] = {
+        { "help",	0, NULL, 'h' },
+        { "full-help",	0, NULL, 0 },
+        { "version",	0, NULL, 'V' },
+        { "blocks",	1, NULL, 'b' },
+        { "min-height",	1, NULL, 0 },
+        { "max-height",	1, NULL, 0 },
+        { "min-label-length",	1, NULL, 0 },
+        { "max-label-length",	1, NULL, 0 },
+        { "label-length-distribution",	1, NULL, 0 },
+        { "edge-probability",	1, NULL, 0 },
+        { "source-probability",	1, NULL, 0 },
+        { "sink-probability",	1, NULL, 0 },
+        { "reads",	1, NULL, 'n' },
+        { "read-type",	1, NULL, 0 },
+        { "read-length",	1, NULL, 0 },
+        { "read-length-stdev",	1, NULL, 0 },
+        { "error-rate",	1, NULL, 0 },
+        { "substitutions",	1, NULL, 0 },
+        { "insertions",	1, NULL, 0 },
+        { "deletions",	1, NULL, 0 },
+        { "reverse-probability",	1, NULL, 0 },
+        { "resample-rounds",	1, NULL, 0 },
+        { "seed",	1, NULL, 's' },
+        { "overwrite",	0, NULL, 0 },
+        { 0,  0, 0, 0 }
+      };
+
+      c = getopt_long (argc, argv, "hVb:n:s:", long_options, &option_index);
+
+      if (c == -1) break;	/* Exit from `while (1)' loop.  */
+
+      switch (c)
+        {
+        case 'h':	/* Print help and exit.  */
+          cmdline_parser_print_help ();
+          cmdline_parser_free (&local_args_info);
+          exit (EXIT_SUCCESS);
+
+        case 'V':	/* Print version and exit.  */
+          cmdline_parser_print_version ();
+          cmdline_parser_free (&local_args_info);
+          exit (EXIT_SUCCESS);
+
+        case 'b':	/* Number of blocks.  */
+        
+        
+          if (update_arg( (void *)&(args_info->blocks_arg), 
+               &(args_info->blocks_orig), &(args_info->blocks_given),
+              &(local_args_info.blocks_given), optarg, 0, "1000", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "blocks", 'b',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 'n':	/* Number of reads.  */
+        
+        
+          if (update_arg( (void *)&(args_info->reads_arg), 
+               &(args_info->reads_orig), &(args_info->reads_given),
+              &(local_args_info.reads_given), optarg, 0, "1000", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "reads", 'n',
+              additional_error))
+            goto failure;
+        
+          break;
+        case 's':	/* Random seed.  */
+        
+        
+          if (update_arg( (void *)&(args_info->seed_arg), 
+               &(args_info->seed_orig), &(args_info->seed_given),
+              &(local_args_info.seed_given), optarg, 0, "42", ARG_LONG,
+              check_ambiguity, override, 0, 0,
+              "seed", 's',
+              additional_error))
+            goto failure;
+        
+          break;
+
+        case 0:	/* Long option with no short option */
+          if (strcmp (long_options[option_index].name, "full-help") == 0) {
+            cmdline_parser_print_full_help ();
+            cmdline_parser_free (&local_args_info);
+            exit (EXIT_SUCCESS);
+          }
+
+          /* Minimum number of nodes of a block.  */
+          if (strcmp (long_options[option_index].name, "min-height") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->min_height_arg), 
+                 &(args_info->min_height_orig), &(args_info->min_height_given),
+                &(local_args_info.min_height_given), optarg, 0, "1", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "min-height", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Maximum number of nodes of a block.  */
+          else if (strcmp (long_options[option_index].name, "max-height") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->max_height_arg), 
+                 &(args_info->max_height_orig), &(args_info->max_height_given),
+                &(local_args_info.max_height_given), optarg, 0, "4", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "max-height", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Minimum length of a node label, resampled until the graph is semi-repeat-free (should be at least log4 of the graph length).  */
+          else if (strcmp (long_options[option_index].name, "min-label-length") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->min_label_length_arg), 
+                 &(args_info->min_label_length_orig), &(args_info->min_label_length_given),
+                &(local_args_info.min_label_length_given), optarg, 0, "12", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "min-label-length", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Maximum length of a node label.  */
+          else if (strcmp (long_options[option_index].name, "max-label-length") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->max_label_length_arg), 
+                 &(args_info->max_label_length_orig), &(args_info->max_label_length_given),
+                &(local_args_info.max_label_length_given), optarg, 0, "40", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "max-label-length", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Distribution of the label lengths in [min,max]: uniform, or geometric with mean 2*min (short labels common, long labels rare).  */
+          else if (strcmp (long_options[option_index].name, "label-length-distribution") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->label_length_distribution_arg), 
+                 &(args_info->label_length_distribution_orig), &(args_info->label_length_distribution_given),
+                &(local_args_info.label_length_distribution_given), optarg, 0, "uniform", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "label-length-distribution", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Probability of an edge between two nodes of adjacent blocks, in addition to the edges connecting every node.  */
+          else if (strcmp (long_options[option_index].name, "edge-probability") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->edge_probability_arg), 
+                 &(args_info->edge_probability_orig), &(args_info->edge_probability_given),
+                &(local_args_info.edge_probability_given), optarg, 0, "0.2", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "edge-probability", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Probability that a node not in the first block has no incoming edges.  */
+          else if (strcmp (long_options[option_index].name, "source-probability") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->source_probability_arg), 
+                 &(args_info->source_probability_orig), &(args_info->source_probability_given),
+                &(local_args_info.source_probability_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "source-probability", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Probability that a node not in the last block has no outgoing edges.  */
+          else if (strcmp (long_options[option_index].name, "sink-probability") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->sink_probability_arg), 
+                 &(args_info->sink_probability_orig), &(args_info->sink_probability_given),
+                &(local_args_info.sink_probability_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "sink-probability", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Defaults of the read options: long (mean length 10000, 10% errors, mostly indels) or short (length 150, 1% substitutions).  */
+          else if (strcmp (long_options[option_index].name, "read-type") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->read_type_arg), 
+                 &(args_info->read_type_orig), &(args_info->read_type_given),
+                &(local_args_info.read_type_given), optarg, 0, "long", ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "read-type", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Mean read length (default from --read-type).  */
+          else if (strcmp (long_options[option_index].name, "read-length") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->read_length_arg), 
+                 &(args_info->read_length_orig), &(args_info->read_length_given),
+                &(local_args_info.read_length_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "read-length", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Standard deviation of the read length, gamma distributed (default from --read-type).  */
+          else if (strcmp (long_options[option_index].name, "read-length-stdev") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->read_length_stdev_arg), 
+                 &(args_info->read_length_stdev_orig), &(args_info->read_length_stdev_given),
+                &(local_args_info.read_length_stdev_given), optarg, 0, 0, ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "read-length-stdev", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Probability of an error at each base (default from --read-type).  */
+          else if (strcmp (long_options[option_index].name, "error-rate") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->error_rate_arg), 
+                 &(args_info->error_rate_orig), &(args_info->error_rate_given),
+                &(local_args_info.error_rate_given), optarg, 0, 0, ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "error-rate", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Relative frequency of substitutions among errors (default from --read-type).  */
+          else if (strcmp (long_options[option_index].name, "substitutions") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->substitutions_arg), 
+                 &(args_info->substitutions_orig), &(args_info->substitutions_given),
+                &(local_args_info.substitutions_given), optarg, 0, 0, ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "substitutions", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Relative frequency of insertions among errors (default from --read-type).  */
+          else if (strcmp (long_options[option_index].name, "insertions") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->insertions_arg), 
+                 &(args_info->insertions_orig), &(args_info->insertions_given),
+                &(local_args_info.insertions_given), optarg, 0, 0, ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "insertions", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Relative frequency of deletions among errors (default from --read-type).  */
+          else if (strcmp (long_options[option_index].name, "deletions") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->deletions_arg), 
+                 &(args_info->deletions_orig), &(args_info->deletions_given),
+                &(local_args_info.deletions_given), optarg, 0, 0, ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "deletions", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Probability that a read is the reverse complement of its path.  */
+          else if (strcmp (long_options[option_index].name, "reverse-probability") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->reverse_probability_arg), 
+                 &(args_info->reverse_probability_orig), &(args_info->reverse_probability_given),
+                &(local_args_info.reverse_probability_given), optarg, 0, "0.5", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "reverse-probability", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Maximum number of rounds resampling the labels that break the semi-repeat-free property.  */
+          else if (strcmp (long_options[option_index].name, "resample-rounds") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->resample_rounds_arg), 
+                 &(args_info->resample_rounds_orig), &(args_info->resample_rounds_given),
+                &(local_args_info.resample_rounds_given), optarg, 0, "100", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "resample-rounds", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Overwrite the output files, if they exist.  */
+          else if (strcmp (long_options[option_index].name, "overwrite") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->overwrite_flag), 0, &(args_info->overwrite_given),
+                &(local_args_info.overwrite_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "overwrite", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          
+          break;
+        case '?':	/* Invalid option.  */
+          /* `getopt_long' already printed an error message.  */
+          goto failure;
+
+        default:	/* bug: option not considered.  */
+          fprintf (stderr, "%s: option unknown: %c%s\n", CMDLINE_PARSER_PACKAGE, c, (additional_error ? additional_error : ""));
+          abort ();
+        } /* switch */
+    } /* while */
+
+
+
+	FIX_UNUSED(check_required);
+
+  cmdline_parser_release (&local_args_info);
+
+  if ( error_occurred )
+    return (EXIT_FAILURE);
+
+  if (optind < argc)
+    {
+      int i = 0 ;
+      int found_prog_name = 0;
+      /* whether program name, i.e., argv[0], is in the remaining args
+         (this may happen with some implementations of getopt,
+          but surely not with the one included by gengetopt) */
+
+      i = optind;
+      while (i < argc)
+        if (argv[i++] == argv[0]) {
+          found_prog_name = 1;
+          break;
+        }
+      i = 0;
+
+      args_info->inputs_num = argc - optind - found_prog_name;
+      args_info->inputs =
+        (char **)(malloc ((args_info->inputs_num)*sizeof(char *))) ;
+      while (optind < argc)
+        if (argv[optind++] != argv[0])
+          args_info->inputs[ i++ ] = gengetopt_strdup (argv[optind-1]) ;
+    }
+
+  return 0;
+
+failure:
+  
+  cmdline_parser_release (&local_args_info);
+  return (EXIT_FAILURE);
+}
+/* vim: set ft=c noet ts=8 sts=8 sw=8 tw=80 nojs spell : */
@@ -0,0 +1,266 @@
+/** @file cmdline.h
+ *  @brief The header file for the command line option parser
+ *  generated by GNU Gengetopt version 2.23
+ *  http://www.gnu.org/software/gengetopt.
+ *  DO NOT modify this file, since it can be overwritten
+ *  @author GNU Gengetopt */
+
+#ifndef CMDLINE_H
+#define CMDLINE_H
+
+/* If we use autoconf.  */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h> /* for FILE */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef CMDLINE_PARSER_PACKAGE
+/** @brief the program name (used for printing errors) */
+#define CMDLINE_PARSER_PACKAGE "efg-generate"
+#endif
+
+#ifndef CMDLINE_PARSER_PACKAGE_NAME
+/** @brief the complete program name (used for help and version) */
+#define CMDLINE_PARSER_PACKAGE_NAME "efg-generate"
+#endif
+
+#ifndef CMDLINE_PARSER_VERSION
+/** @brief the program version */
+#define CMDLINE_PARSER_VERSION "0.1"
+#endif
+
+/** @brief Where the command line options are stored */
+struct gengetopt_args_info
+{
+  const char *help_help; /**< @brief Print help and exit help description.  */
+  const char *full_help_help; /**< @brief Print help, including hidden options, and exit help description.  */
+  const char *version_help; /**< @brief Print version and exit help description.  */
+  long blocks_arg;	/**< @brief Number of blocks (default='1000').  */
+  char * blocks_orig;	/**< @brief Number of blocks original value given at command line.  */
+  const char *blocks_help; /**< @brief Number of blocks help description.  */
+  int min_height_arg;	/**< @brief Minimum number of nodes of a block (default='1').  */
+  char * min_height_orig;	/**< @brief Minimum number of nodes of a block original value given at command line.  */
+  const char *min_height_help; /**< @brief Minimum number of nodes of a block help description.  */
+  int max_height_arg;	/**< @brief Maximum number of nodes of a block (default='4').  */
+  char * max_height_orig;	/**< @brief Maximum number of nodes of a block original value given at command line.  */
+  const char *max_height_help; /**< @brief Maximum number of nodes of a block help description.  */
+  int min_label_length_arg;	/**< @brief Minimum length of a node label, resampled until the graph is semi-repeat-free (should be at least log4 of the graph length) (default='12').  */
+  char * min_label_length_orig;	/**< @brief Minimum length of a node label, resampled until the graph is semi-repeat-free (should be at least log4 of the graph length) original value given at command line.  */
+  const char *min_label_length_help; /**< @brief Minimum length of a node label, resampled until the graph is semi-repeat-free (should be at least log4 of the graph length) help description.  */
+  int max_label_length_arg;	/**< @brief Maximum length of a node label (default='40').  */
+  char * max_label_length_orig;	/**< @brief Maximum length of a node label original value given at command line.  */
+  const char *max_label_length_help; /**< @brief Maximum length of a node label help description.  */
+  char * label_length_distribution_arg;	/**< @brief Distribution of the label lengths in [min,max]: uniform, or geometric with mean 2*min (short labels common, long labels rare) (default='uniform').  */
+  char * label_length_distribution_orig;	/**< @brief Distribution of the label lengths in [min,max]: uniform, or geometric with mean 2*min (short labels common, long labels rare) original value given at command line.  */
+  const char *label_length_distribution_help; /**< @brief Distribution of the label lengths in [min,max]: uniform, or geometric with mean 2*min (short labels common, long labels rare) help description.  */
+  double edge_probability_arg;	/**< @brief Probability of an edge between two nodes of adjacent blocks, in addition to the edges connecting every node (default='0.2').  */
+  char * edge_probability_orig;	/**< @brief Probability of an edge between two nodes of adjacent blocks, in addition to the edges connecting every node original value given at command line.  */
+  const char *edge_probability_help; /**< @brief Probability of an edge between two nodes of adjacent blocks, in addition to the edges connecting every node help description.  */
+  double source_probability_arg;	/**< @brief Probability that a node not in the first block has no incoming edges (default='0').  */
+  char * source_probability_orig;	/**< @brief Probability that a node not in the first block has no incoming edges original value given at command line.  */
+  const char *source_probability_help; /**< @brief Probability that a node not in the first block has no incoming edges help description.  */
+  double sink_probability_arg;	/**< @brief Probability that a node not in the last block has no outgoing edges (default='0').  */
+  char * sink_probability_orig;	/**< @brief Probability that a node not in the last block has no outgoing edges original value given at command line.  */
+  const char *sink_probability_help; /**< @brief Probability that a node not in the last block has no outgoing edges help description.  */
+  long reads_arg;	/**< @brief Number of reads (default='1000').  */
+  char * reads_orig;	/**< @brief Number of reads original value given at command line.  */
+  const char *reads_help; /**< @brief Number of reads help description.  */
+  char * read_type_arg;	/**< @brief Defaults of the read options: long (mean length 10000, 10% errors, mostly indels) or short (length 150, 1% substitutions) (default='long').  */
+  char * read_type_orig;	/**< @brief Defaults of the read options: long (mean length 10000, 10% errors, mostly indels) or short (length 150, 1% substitutions) original value given at command line.  */
+  const char *read_type_help; /**< @brief Defaults of the read options: long (mean length 10000, 10% errors, mostly indels) or short (length 150, 1% substitutions) help description.  */
+  long read_length_arg;	/**< @brief Mean read length (default from --read-type).  */
+  char * read_length_orig;	/**< @brief Mean read length (default from --read-type) original value given at command line.  */
+  const char *read_length_help; /**< @brief Mean read length (default from --read-type) help description.  */
+  long read_length_stdev_arg;	/**< @brief Standard deviation of the read length, gamma distributed (default from --read-type).  */
+  char * read_length_stdev_orig;	/**< @brief Standard deviation of the read length, gamma distributed (default from --read-type) original value given at command line.  */
+  const char *read_length_stdev_help; /**< @brief Standard deviation of the read length, gamma distributed (default from --read-type) help description.  */
+  double error_rate_arg;	/**< @brief Probability of an error at each base (default from --read-type).  */
+  char * error_rate_orig;	/**< @brief Probability of an error at each base (default from --read-type) original value given at command line.  */
+  const char *error_rate_help; /**< @brief Probability of an error at each base (default from --read-type) help description.  */
+  double substitutions_arg;	/**< @brief Relative frequency of substitutions among errors (default from --read-type).  */
+  char * substitutions_orig;	/**< @brief Relative frequency of substitutions among errors (default from --read-type) original value given at command line.  */
+  const char *substitutions_help; /**< @brief Relative frequency of substitutions among errors (default from --read-type) help description.  */
+  double insertions_arg;	/**< @brief Relative frequency of insertions among errors (default from --read-type).  */
+  char * insertions_orig;	/**< @brief Relative frequency of insertions among errors (default from --read-type) original value given at command line.  */
+  const char *insertions_help; /**< @brief Relative frequency of insertions among errors (default from --read-type) help description.  */
+  double deletions_arg;	/**< @brief Relative frequency of deletions among errors (default from --read-type).  */
+  char * deletions_orig;	/**< @brief Relative frequency of deletions among errors (default from --read-type) original value given at command line.  */
+  const char *deletions_help; /**< @brief Relative frequency of deletions among errors (default from --read-type) help description.  */
+  double reverse_probability_arg;	/**< @brief Probability that a read is the reverse complement of its path (default='0.5').  */
+  char * reverse_probability_orig;	/**< @brief Probability that a read is the reverse complement of its path original value given at command line.  */
+  const char *reverse_probability_help; /**< @brief Probability that a read is the reverse complement of its path help description.  */
+  int resample_rounds_arg;	/**< @brief Maximum number of rounds resampling the labels that break the semi-repeat-free property (default='100').  */
+  char * resample_rounds_orig;	/**< @brief Maximum number of rounds resampling the labels that break the semi-repeat-free property original value given at command line.  */
+  const char *resample_rounds_help; /**< @brief Maximum number of rounds resampling the labels that break the semi-repeat-free property help description.  */
+  long seed_arg;	/**< @brief Random seed (default='42').  */
+  char * seed_orig;	/**< @brief Random seed original value given at command line.  */
+  const char *seed_help; /**< @brief Random seed help description.  */
+  int overwrite_flag;	/**< @brief Overwrite the output files, if they exist (default=off).  */
+  const char *overwrite_help; /**< @brief Overwrite the output files, if they exist help description.  */
+  
+  unsigned int help_given ;	/**< @brief Whether help was given.  */
+  unsigned int full_help_given ;	/**< @brief Whether full-help was given.  */
+  unsigned int version_given ;	/**< @brief Whether version was given.  */
+  unsigned int blocks_given ;	/**< @brief Whether blocks was given.  */
+  unsigned int min_height_given ;	/**< @brief Whether min-height was given.  */
+  unsigned int max_height_given ;	/**< @brief Whether max-height was given.  */
+  unsigned int min_label_length_given ;	/**< @brief Whether min-label-length was given.  */
+  unsigned int max_label_length_given ;	/**< @brief Whether max-label-length was given.  */
+  unsigned int label_length_distribution_given ;	/**< @brief Whether label-length-distribution was given.  */
+  unsigned int edge_probability_given ;	/**< @brief Whether edge-probability was given.  */
+  unsigned int source_probability_given ;	/**< @brief Whether source-probability was given.  */
+  unsigned int sink_probability_given ;	/**< @brief Whether sink-probability was given.  */
+  unsigned int reads_given ;	/**< @brief Whether reads was given.  */
+  unsigned int read_type_given ;	/**< @brief Whether read-type was given.  */
+  unsigned int read_length_given ;	/**< @brief Whether read-length was given.  */
+  unsigned int read_length_stdev_given ;	/**< @brief Whether read-length-stdev was given.  */
+  unsigned int error_rate_given ;	/**< @brief Whether error-rate was given.  */
+  unsigned int substitutions_given ;	/**< @brief Whether substitutions was given.  */
+  unsigned int insertions_given ;	/**< @brief Whether insertions was given.  */
+  unsigned int deletions_given ;	/**< @brief Whether deletions was given.  */
+  unsigned int reverse_probability_given ;	/**< @brief Whether reverse-probability was given.  */
+  unsigned int resample_rounds_given ;	/**< @brief Whether resample-rounds was given.  */
+  unsigned int seed_given ;	/**< @brief Whether seed was given.  */
+  unsigned int overwrite_given ;	/**< @brief Whether overwrite was given.  */
+
+  char **inputs ; /**< @brief unnamed options (options without names) */
+  unsigned inputs_num ; /**< @brief unnamed options number */
+} ;
+
+/** @brief The additional parameters to pass to parser functions */
+struct cmdline_parser_params
+{
+  int override; /**< @brief whether to override possibly already present options (default 0) */
+  int initialize; /**< @brief whether to initialize the option structure gengetopt_args_info (default 1) */
+  int check_required; /**< @brief whether to check that all required options were provided (default 1) */
+  int check_ambiguity; /**< @brief whether to check for options already specified in the option structure gengetopt_args_info (default 0) */
+  int print_errors; /**< @brief whether getopt_long should print an error message for a bad option (default 1) */
+} ;
+
+/** @brief the purpose string of the program */
+extern const char *gengetopt_args_info_purpose;
+/** @brief the usage string of the program */
+extern const char *gengetopt_args_info_usage;
+/** @brief the description string of the program */
+extern const char *gengetopt_args_info_description;
+/** @brief all the lines making the help output */
+extern const char *gengetopt_args_info_help[];
+/** @brief all the lines making the full help output (including hidden options) */
+extern const char *gengetopt_args_info_full_help[];
+
+/**
+ * The command line parser
+ * @param argc the number of command line options
+ * @param argv the command line options
+ * @param args_info the structure where option information will be stored
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser (int argc, char **argv,
+  struct gengetopt_args_info *args_info);
+
+/**
+ * The command line parser (version with additional parameters - deprecated)
+ * @param argc the number of command line options
+ * @param argv the command line options
+ * @param args_info the structure where option information will be stored
+ * @param override whether to override possibly already present options
+ * @param initialize whether to initialize the option structure my_args_info
+ * @param check_required whether to check that all required options were provided
+ * @return 0 if everything went fine, NON 0 if an error took place
+ * @deprecated use cmdline_parser_ext() instead
+ */
+int cmdline_parser2 (int argc, char **argv,
+  struct gengetopt_args_info *args_info,
+  int override, int initialize, int check_required);
+
+/**
+ * The command line parser (version with additional parameters)
+ * @param argc the number of command line options
+ * @param argv the command line options
+ * @param args_info the structure where option information will be stored
+ * @param params additional parameters for the parser
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser_ext (int argc, char **argv,
+  struct gengetopt_args_info *args_info,
+  struct cmdline_parser_params *params);
+
+/**
+ * Save the contents of the option struct into an already open FILE stream.
+ * @param outfile the stream where to dump options
+ * @param args_info the option struct to dump
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser_dump(FILE *outfile,
+  struct gengetopt_args_info *args_info);
+
+/**
+ * Save the contents of the option struct into a (text) file.
+ * This file can be read by the config file parser (if generated by gengetopt)
+ * @param filename the file where to save
+ * @param args_info the option struct to save
+ * @return 0 if everything went fine, NON 0 if an error took place
+ */
+int cmdline_parser_file_save(const char *filename,
+  struct gengetopt_args_info *args_info);
+
+/**
+ * Print the help
+ */
+void cmdline_parser_print_help(void);
+/**
+ * Print the full help (including hidden options)
+ */
+void cmdline_parser_print_full_help(void);
+/**
+ * Print the version
+ */
+void cmdline_parser_print_version(void);
+
+/**
+ * Initializes all the fields a cmdline_parser_params structure 
+ * to their default values
+ * @param params the structure to initialize
+ */
+void cmdline_parser_params_init(struct cmdline_parser_params *params);
+
+/**
+ * Allocates dynamically a cmdline_parser_params structure and initializes
+ * all its fields to their default values
+ * @return the created and initialized cmdline_parser_params structure
+ */
+struct cmdline_parser_params *cmdline_parser_params_create(void);
+
+/**
+ * Initializes the passed gengetopt_args_info structure's fields
+ * (also set default values for options that have a default)
+ * @param args_info the structure to initialize
+ */
+void cmdline_parser_init (struct gengetopt_args_info *args_info);
+/**
+ * Deallocates the string fields of the gengetopt_args_info structure
+ * (but does not deallocate the structure itself)
+ * @param args_info the structure to deallocate
+ */
+void cmdline_parser_free (struct gengetopt_args_info *args_info);
+
+/**
+ * Checks that all the required options were specified
+ * @param args_info the structure to check
+ * @param prog_name the name of the program that will be used to print
+ *   possible errors
+ * @return
+ */
+int cmdline_parser_required (struct gengetopt_args_info *args_info,
+  const char *prog_name);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* CMDLINE_H */
@@ -0,0 +1,478 @@
+/**
+ * Program to generate random semi-repeat-free Elastic Founder Graphs and
+ * reads sampled from their paths, with ground truth.
+ * See output of ./efg-generate --help or command-line-parsing/config.ggo
+**/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <filesystem>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+#include "command-line-parsing/cmdline.h" // gengetopt-generated parser
+
+using std::vector, std::string;
+
+struct GraphParams {
+	long blocks;
+	int minheight, maxheight;
+	int minlength, maxlength;
+	bool geometric;
+	double edgeprob, sourceprob, sinkprob;
+	int rounds;
+};
+
+struct ReadParams {
+	long reads;
+	long length, stdev;
+	double errorrate;
+	double substitutions, insertions, deletions; // relative weights
+	double reverseprob;
+};
+
+const char bases[] = "ACGT";
+
+int base_code(char c)
+{
+	switch (c) {
+		case 'A': return 0;
+		case 'C': return 1;
+		case 'G': return 2;
+		default: return 3;
+	}
+}
+
+char complement(char c)
+{
+	switch (c) {
+		case 'A': return 'T';
+		case 'C': return 'G';
+		case 'G': return 'C';
+		default: return 'A';
+	}
+}
+
+class RandomEfg {
+	private:
+		const GraphParams &params;
+		std::mt19937_64 &rng;
+
+		int random_length()
+		{
+			if (params.geometric) {
+				// mean 2*min, truncated to max
+				std::geometric_distribution<int> extra(1.0 / (params.minlength + 1));
+				return std::min(params.maxlength, params.minlength + extra(rng));
+			}
+			return std::uniform_int_distribution<int>(params.minlength, params.maxlength)(rng);
+		}
+
+		string random_label()
+		{
+			string label(random_length(), 'A');
+			for (char &c : label)
+				c = bases[rng() % 4];
+			return label;
+		}
+
+		/*
+		 * nodes whose label can occur elsewhere than at the start of a node of
+		 * their block, or equal to another label of the block. It is enough to
+		 * check the prefixes of k = min(minlength, 32) bases: each occurrence
+		 * of a k-mer starts inside a node and ends in it or in its successor.
+		 */
+		vector<long> violating_nodes() const
+		{
+			const int k = std::min(params.minlength, 32);
+			const uint64_t mask = (k == 32) ? ~0ULL : (1ULL << (2 * k)) - 1;
+			auto encode = [&](const string &s, int start) {
+				uint64_t kmer = 0;
+				for (int i = start; i < start + k; i++)
+					kmer = (kmer << 2) | base_code(s[i]);
+				return kmer;
+			};
+
+			std::unordered_map<uint64_t,long> prefixblock; // -1 if the k-mer is repeated
+			prefixblock.reserve(labels.size());
+			vector<bool> filter(1 << 26, false); // most k-mers are not prefixes, skip the hash table lookup
+			auto filterbit = [](uint64_t kmer) { return (kmer * 0x9E3779B97F4A7C15ULL) >> (64 - 26); };
+			for (long v = 0; v < labels.size(); v++) {
+				const uint64_t kmer = encode(labels[v], 0);
+				filter[filterbit(kmer)] = true;
+				auto it = prefixblock.find(kmer);
+				if (it == prefixblock.end())
+					prefixblock[kmer] = block[v];
+				else if (it->second != block[v])
+					it->second = -1;
+			}
+
+			auto repeated = [&](uint64_t kmer) {
+				if (!filter[filterbit(kmer)])
+					return;
+				auto it = prefixblock.find(kmer);
+				if (it != prefixblock.end())
+					it->second = -1;
+			};
+			for (long u = 0; u < labels.size(); u++) {
+				const string &label = labels[u];
+				uint64_t kmer = encode(label, 0);
+				for (int i = k; i < label.size(); i++) {
+					kmer = ((kmer << 2) | base_code(label[i])) & mask;
+					repeated(kmer);
+				}
+				// k-mers across the edges to the successors
+				for (long v : out[u]) {
+					uint64_t edgekmer = kmer;
+					for (int i = 0; i < k - 1; i++) {
+						edgekmer = ((edgekmer << 2) | base_code(labels[v][i])) & mask;
+						repeated(edgekmer);
+					}
+				}
+			}
+
+			vector<long> violating;
+			for (long b = 0; b < blocks.size(); b++) {
+				for (int i = 0; i < blocks[b].size(); i++) {
+					const long v = blocks[b][i];
+					bool bad = prefixblock.at(encode(labels[v], 0)) == -1;
+					for (int j = 0; j < i and !bad; j++)
+						bad = labels[blocks[b][j]] == labels[v];
+					if (bad)
+						violating.push_back(v);
+				}
+			}
+			return violating;
+		}
+
+		void connect(long b)
+		{
+			const vector<long> &cur = blocks[b], &next = blocks[b+1];
+			std::bernoulli_distribution sink(params.sinkprob), source(params.sourceprob), edge(params.edgeprob);
+			vector<long> from, to;
+			for (long u : cur)
+				if (!sink(rng))
+					from.push_back(u);
+			for (long v : next)
+				if (!source(rng))
+					to.push_back(v);
+			if (from.empty())
+				from.push_back(cur[rng() % cur.size()]);
+			if (to.empty())
+				to.push_back(next[rng() % next.size()]);
+
+			vector<bool> reached(next.size(), false); // nodes of a block have consecutive indices
+			auto add_edge = [&](long u, long v) {
+				if (std::find(out[u].begin(), out[u].end(), v) == out[u].end())
+					out[u].push_back(v);
+				reached[v - next[0]] = true;
+			};
+			for (long u : from)
+				add_edge(u, to[rng() % to.size()]);
+			for (long v : to)
+				if (!reached[v - next[0]])
+					add_edge(from[rng() % from.size()], v);
+			for (long u : from)
+				for (long v : to)
+					if (edge(rng))
+						add_edge(u, v);
+			for (long u : from)
+				std::sort(out[u].begin(), out[u].end());
+		}
+
+	public:
+		vector<vector<long>> blocks; // node indices of each block
+		vector<long> block; // block of each node
+		vector<string> labels;
+		vector<vector<long>> out; // adjacency lists, to the next block only
+
+		RandomEfg(const GraphParams &p, std::mt19937_64 &r) : params(p), rng(r)
+		{
+			std::uniform_int_distribution<int> height(params.minheight, params.maxheight);
+			for (long b = 0; b < params.blocks; b++) {
+				blocks.push_back({});
+				for (int i = 0, h = height(rng); i < h; i++) {
+					blocks.back().push_back(labels.size());
+					block.push_back(b);
+					labels.push_back(random_label());
+				}
+			}
+			out.resize(labels.size());
+			for (long b = 0; b + 1 < blocks.size(); b++)
+				connect(b);
+		}
+
+		/*
+		 * resample the violating labels until there are none, false if the
+		 * rounds are not enough or the violations stop decreasing
+		 */
+		bool make_semi_repeat_free()
+		{
+			long fewest = labels.size() + 1;
+			for (int round = 0, stalled = 0; round < params.rounds and stalled < 5; round++) {
+				const vector<long> violating = violating_nodes();
+				if (violating.empty())
+					return true;
+				stalled = (violating.size() < fewest) ? 0 : stalled + 1;
+				fewest = std::min(fewest, (long)violating.size());
+				for (long v : violating)
+					labels[v] = random_label();
+			}
+			return false;
+		}
+
+		long length() const
+		{
+			long l = 0;
+			for (const string &label : labels)
+				l += label.size();
+			return l;
+		}
+
+		void to_stream(std::ostream *out) const
+		{
+			// cuts of an alignment where each block is as wide as its longest label
+			*out << "X";
+			for (long b = 0, col = 0; b < blocks.size(); b++) {
+				*out << "\t" << col;
+				long width = 0;
+				for (long v : blocks[b])
+					width = std::max(width, (long)labels[v].size());
+				col += width;
+			}
+			*out << "\n";
+
+			*out << "B";
+			for (const vector<long> &b : blocks)
+				*out << "\t" << b.size();
+			*out << "\n";
+
+			for (long v = 0; v < labels.size(); v++)
+				*out << "S\t" << v + 1 << "\t" << labels[v] << "\n";
+
+			for (long u = 0; u < labels.size(); u++)
+				for (long v : this->out[u])
+					*out << "L\t" << u + 1 << "\t+\t" << v + 1 << "\t+\t0M\n";
+		}
+};
+
+class ReadSimulator {
+	private:
+		const RandomEfg &graph;
+		const ReadParams &params;
+		std::mt19937_64 &rng;
+		vector<long> cumulative; // cumulative[v] = bases of the nodes before v
+
+		long random_length()
+		{
+			if (params.stdev <= 0)
+				return params.length;
+			// gamma with the given mean and standard deviation
+			const double shape = (double)params.length * params.length / ((double)params.stdev * params.stdev);
+			std::gamma_distribution<double> gamma(shape, (double)params.length / shape);
+			return std::max(1L, std::lround(gamma(rng)));
+		}
+
+		// random path spelling length bases (or less if it reaches a sink), starting at offset
+		vector<long> random_path(long length, long &offset, long &spelled)
+		{
+			const long pos = std::uniform_int_distribution<long>(0, cumulative.back() - 1)(rng);
+			long v = std::upper_bound(cumulative.begin(), cumulative.end(), pos) - cumulative.begin() - 1;
+			offset = pos - cumulative[v];
+			vector<long> path({v});
+			spelled = graph.labels[v].size() - offset;
+			while (spelled < length and !graph.out[v].empty()) {
+				v = graph.out[v][rng() % graph.out[v].size()];
+				path.push_back(v);
+				spelled += graph.labels[v].size();
+			}
+			spelled = std::min(spelled, length);
+			return path;
+		}
+
+	public:
+		ReadSimulator(const RandomEfg &g, const ReadParams &p, std::mt19937_64 &r) : graph(g), params(p), rng(r)
+		{
+			cumulative.push_back(0);
+			for (const string &label : graph.labels)
+				cumulative.push_back(cumulative.back() + label.size());
+		}
+
+		/*
+		 * simulate read i, write it in FASTQ format and its path in GAF format,
+		 * with the number of errors in tag NM
+		 */
+		void simulate(long i, std::ostream *readsout, std::ostream *truthout)
+		{
+			const long length = random_length();
+			long offset, spelled;
+			vector<long> path;
+			for (int attempt = 0; attempt < 10; attempt++) { // prefer paths not reaching a sink
+				path = random_path(length, offset, spelled);
+				if (spelled == length)
+					break;
+			}
+
+			string original;
+			for (long v : path)
+				original += graph.labels[v];
+			original = original.substr(offset, spelled);
+
+			std::bernoulli_distribution error(params.errorrate);
+			std::discrete_distribution<int> errortype({params.substitutions, params.insertions, params.deletions});
+			string read;
+			read.reserve(original.size() + original.size() / 8);
+			long matches = 0, edits = 0, insertions = 0;
+			for (char c : original) {
+				if (!error(rng)) {
+					read.push_back(c);
+					matches++;
+					continue;
+				}
+				edits++;
+				switch (errortype(rng)) {
+					case 0: // substitution
+						read.push_back(bases[(base_code(c) + 1 + rng() % 3) % 4]);
+						break;
+					case 1: // insertion before the base
+						read.push_back(bases[rng() % 4]);
+						read.push_back(c);
+						matches++;
+						insertions++;
+						break;
+					case 2: // deletion
+						break;
+				}
+			}
+			if (read.empty()) {
+				read.push_back(original[0]);
+				matches++;
+				edits--;
+			}
+
+			const bool reverse = std::bernoulli_distribution(params.reverseprob)(rng);
+			if (reverse) {
+				std::reverse(read.begin(), read.end());
+				for (char &c : read)
+					c = complement(c);
+			}
+
+			const int phred = std::clamp((int)std::lround(-10 * std::log10(std::max(params.errorrate, 1e-4))), 1, 40);
+			*readsout << "@read" << i << "\n" << read << "\n+\n" << string(read.size(), (char)('!' + phred)) << "\n";
+
+			long pathlength = 0;
+			*truthout << "read" << i << "\t" << read.size() << "\t0\t" << read.size() << "\t" << ((reverse) ? "-" : "+") << "\t";
+			for (long v : path) {
+				*truthout << ">" << v + 1;
+				pathlength += graph.labels[v].size();
+			}
+			*truthout << "\t" << pathlength << "\t" << offset << "\t" << offset + spelled << "\t" << matches;
+			*truthout << "\t" << spelled + insertions << "\t60\tNM:i:" << edits << "\n";
+		}
+};
+
+// open path for writing, or exit if it exists and overwrite is false
+std::ofstream open_output(const std::filesystem::path &path, bool overwrite)
+{
+	if (std::filesystem::exists(path) and !overwrite) {
+		std::cerr << "Error: output file " << path << " already exists." << std::endl;
+		exit(1);
+	}
+	std::ofstream fs(path, std::ios::out | std::ios::trunc);
+	if (!fs) {
+		std::cerr << "Error opening file " << path << "." << std::endl;
+		exit(1);
+	}
+	return fs;
+}
+
+int main(int argc, char* argv[])
+{
+	gengetopt_args_info argsinfo;
+	if (cmdline_parser(argc, argv, &argsinfo) != 0) exit(1);
+
+	if (argsinfo.inputs_num == 0)
+		{std::cerr << argv[0] << ": missing output graph path" << std::endl; exit(1);};
+	if (argsinfo.inputs_num == 2)
+		{std::cerr << argv[0] << ": missing ground truth path" << std::endl; exit(1);};
+	if (argsinfo.inputs_num > 3)
+		{std::cerr << argv[0] << ": too many arguments" << std::endl; exit(1);};
+
+	GraphParams gparams;
+	gparams.blocks = argsinfo.blocks_arg;
+	gparams.minheight = argsinfo.min_height_arg;
+	gparams.maxheight = argsinfo.max_height_arg;
+	gparams.minlength = argsinfo.min_label_length_arg;
+	gparams.maxlength = argsinfo.max_label_length_arg;
+	gparams.edgeprob = argsinfo.edge_probability_arg;
+	gparams.sourceprob = argsinfo.source_probability_arg;
+	gparams.sinkprob = argsinfo.sink_probability_arg;
+	gparams.rounds = argsinfo.resample_rounds_arg;
+	if (string(argsinfo.label_length_distribution_arg) == "uniform")
+		gparams.geometric = false;
+	else if (string(argsinfo.label_length_distribution_arg) == "geometric")
+		gparams.geometric = true;
+	else
+		{std::cerr << argv[0] << ": unknown label length distribution " << argsinfo.label_length_distribution_arg << std::endl; exit(1);};
+	if (gparams.blocks < 1 or gparams.minheight < 1 or gparams.maxheight < gparams.minheight)
+		{std::cerr << argv[0] << ": invalid number of blocks or block heights" << std::endl; exit(1);};
+	if (gparams.minlength < 1 or gparams.maxlength < gparams.minlength)
+		{std::cerr << argv[0] << ": invalid label lengths" << std::endl; exit(1);};
+
+	ReadParams rparams;
+	if (string(argsinfo.read_type_arg) == "long")
+		rparams = ReadParams {0, 10000, 5000, 0.1, 0.2, 0.4, 0.4, 0};
+	else if (string(argsinfo.read_type_arg) == "short")
+		rparams = ReadParams {0, 150, 0, 0.01, 1, 0, 0, 0};
+	else
+		{std::cerr << argv[0] << ": unknown read type " << argsinfo.read_type_arg << std::endl; exit(1);};
+	rparams.reads = argsinfo.reads_arg;
+	rparams.reverseprob = argsinfo.reverse_probability_arg;
+	if (argsinfo.read_length_given)
+		rparams.length = argsinfo.read_length_arg;
+	if (argsinfo.read_length_stdev_given)
+		rparams.stdev = argsinfo.read_length_stdev_arg;
+	if (argsinfo.error_rate_given)
+		rparams.errorrate = argsinfo.error_rate_arg;
+	if (argsinfo.substitutions_given)
+		rparams.substitutions = argsinfo.substitutions_arg;
+	if (argsinfo.insertions_given)
+		rparams.insertions = argsinfo.insertions_arg;
+	if (argsinfo.deletions_given)
+		rparams.deletions = argsinfo.deletions_arg;
+	if (rparams.length < 1 or rparams.substitutions + rparams.insertions + rparams.deletions <= 0)
+		{std::cerr << argv[0] << ": invalid read length or error weights" << std::endl; exit(1);};
+
+	std::ofstream graphfs = open_output(argsinfo.inputs[0], argsinfo.overwrite_flag);
+	std::ofstream readsfs, truthfs;
+	if (argsinfo.inputs_num == 3) {
+		readsfs = open_output(argsinfo.inputs[1], argsinfo.overwrite_flag);
+		truthfs = open_output(argsinfo.inputs[2], argsinfo.overwrite_flag);
+	}
+
+	std::mt19937_64 rng(argsinfo.seed_arg);
+
+	std::cerr << "Generating the graph..." << std::flush;
+	RandomEfg graph(gparams, rng);
+	if (!graph.make_semi_repeat_free()) {
+		std::cerr << std::endl << "Error: could not make the graph semi-repeat-free by resampling the labels, increase --min-label-length." << std::endl;
+		exit(1);
+	}
+	graph.to_stream(&graphfs);
+	std::cerr << " done (" << graph.labels.size() << " nodes, " << graph.length() << " bases)." << std::endl;
+
+	if (argsinfo.inputs_num == 3) {
+		std::cerr << "Simulating the reads..." << std::flush;
+		ReadSimulator simulator(graph, rparams, rng);
+		for (long i = 0; i < rparams.reads; i++)
+			simulator.simulate(i + 1, &readsfs, &truthfs);
+		std::cerr << " done." << std::endl;
+	}
+
+	cmdline_parser_free(&argsinfo);
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "../efg-locate.hpp"
+#include "../efg.hpp"
+#include "../seeding.hpp"
+#include "../../common/microbench.hpp"
+
+/*
+ * microbenchmarks of the search kernels of efg-locate on a fixed random
+ * graph (make bench), see microbench.hpp for the arguments
+ */
+
+using namespace efg_locate;
+using microbench::do_not_optimize;
+
+// state of efg_backward_search after first_search and simple_search
+struct SearchState {
+	string pattern;
+	int f;
+	size_type f_l, f_r;
+	int simpleq;
+	vector<int> path;
+	int first_node_pos, y, u_k;
+};
+
+int main(int argc, char *argv[])
+{
+	microbench::Args args(argc, argv);
+	microbench::Suite suite(args.filter);
+
+	const microbench::SyntheticEfg synthetic(20000, 4, 12, 40, 42);
+	std::istringstream graphss(synthetic.to_xgfa());
+	Elasticfoundergraph graph(graphss);
+	graph.init_pattern_matching_support();
+	const csa_type &edge_index = graph.get_edge_index();
+
+	std::mt19937 rng(7);
+	vector<string> shortpatterns, longpatterns;
+	for (int i = 0; i < 1000; i++) {
+		const string s = synthetic.spell(synthetic.random_path(rng, rng() % (synthetic.blocks.size() - 200), 400));
+		const int start = rng() % 100;
+		shortpatterns.push_back(s.substr(start, std::min<size_t>(150, s.size() - start)));
+	}
+	for (int i = 0; i < 100; i++)
+		longpatterns.push_back(synthetic.spell(synthetic.random_path(rng, rng() % (synthetic.blocks.size() - 1000), 10000)));
+
+	vector<SearchState> states;
+	for (const string &pattern : shortpatterns) {
+		SearchState s;
+		s.pattern = pattern;
+		int q = pattern.size() - 1;
+		size_type lastq_l, lastq_r;
+		first_search(graph, pattern, q, lastq_l, lastq_r, s.f, s.f_l, s.f_r);
+		if (q == -1 or s.f == -1)
+			continue;
+		s.simpleq = q = s.f - 1;
+		simple_search(graph, pattern, q, s.path, s.first_node_pos, s.y, s.u_k);
+		if (q == -1)
+			states.push_back(s);
+	}
+
+	Params params;
+	vector<GAFAnchor> anchors;
+	for (const string &pattern : longpatterns) {
+		vector<GAFAnchor> matches;
+		efg_backward_search(graph, "read", pattern, params, matches);
+		anchors.insert(anchors.end(), matches.begin(), matches.end());
+	}
+	std::cout << "graph with " << synthetic.labels.size() << " nodes, " << states.size() << " search states, ";
+	std::cout << anchors.size() << " anchors" << std::endl << std::endl;
+
+	suite.run("backward_search (per step)", [&]() {
+		long steps = 0;
+		for (const string &pattern : shortpatterns) {
+			size_type l = 0, r = edge_index.size() - 1;
+			for (int q = pattern.size() - 1; q >= 0 and backward_search(edge_index, l, r, pattern[q], l, r) > 0; q--)
+				steps++;
+			do_not_optimize(l);
+		}
+		return steps;
+	});
+
+	suite.run("first_search", [&]() {
+		for (const string &pattern : shortpatterns) {
+			int q = pattern.size() - 1, f;
+			size_type lastq_l, lastq_r, f_l, f_r;
+			first_search(graph, pattern, q, lastq_l, lastq_r, f, f_l, f_r);
+			do_not_optimize(f_l);
+		}
+		return (long)shortpatterns.size();
+	});
+
+	suite.run("simple_search", [&]() {
+		vector<int> path;
+		for (const SearchState &s : states) {
+			int q = s.simpleq, first_node_pos, y, u_k;
+			path.clear();
+			simple_search(graph, s.pattern, q, path, first_node_pos, y, u_k);
+			do_not_optimize(y);
+		}
+		return (long)states.size();
+	});
+
+	suite.run("find_connecting_vertex", [&]() {
+		vector<int> path;
+		for (const SearchState &s : states) {
+			int pos;
+			path = s.path;
+			do_not_optimize(find_connecting_vertex(graph, s.pattern, s.y, s.f, s.f_l, s.f_r, s.pattern.size() - 1, path, pos));
+		}
+		return (long)states.size();
+	});
+
+	suite.run("locate_edge", [&]() {
+		std::mt19937 r(1);
+		for (int i = 0; i < 10000; i++)
+			do_not_optimize(graph.locate_edge(r() % edge_index.size()));
+		return 10000L;
+	});
+
+	suite.run("locate_edge_and_position", [&]() {
+		std::mt19937 r(1);
+		for (int i = 0; i < 10000; i++)
+			do_not_optimize(graph.locate_edge_and_position(r() % edge_index.size()));
+		return 10000L;
+	});
+
+	suite.run("GAFAnchor::split_single", [&]() {
+		for (const GAFAnchor &a : anchors) {
+			const vector<GAFAnchor> split = a.split_single(graph);
+			do_not_optimize(split.data());
+		}
+		return (long)anchors.size();
+	});
+
+	suite.run("GAF formatting (per anchor)", [&]() {
+		std::ostringstream out;
+		anchors_to_stream(&out, graph, anchors);
+		do_not_optimize(out.str().size());
+		return (long)anchors.size();
+	});
+
+	suite.run("GAF formatting split (per anchor)", [&]() {
+		std::ostringstream out;
+		anchors_to_stream_split_single(&out, graph, anchors, false);
+		do_not_optimize(out.str().size());
+		return (long)anchors.size();
+	});
+
+	return args.finish(suite);
+}
@@ -0,0 +1,159 @@
+#ifndef BUDGET_HPP
+#define BUDGET_HPP
+
+#include <fstream>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+/*
+ * per-read work budget in approximate mode (--max-lf-steps, --read-timeout):
+ * the compute thread counts the backward steps of the read it is seeding in
+ * a thread-local budget, and once the budget is exhausted the greedy loop
+ * stops at its next restart and find_connecting_vertex gives up, so that the
+ * read keeps the seeds found so far. The clock is read every
+ * BUDGET_CLOCK_STEPS steps only. The reads exceeding the budget are counted
+ * and, with --deferred, written to a FASTA file to be seeded again with a
+ * larger budget. When no budget is set, a step costs one branch.
+ */
+namespace efg_locate {
+
+const long BUDGET_CLOCK_STEPS = 4096;
+
+enum BudgetExceeded { BUDGET_OK = 0, BUDGET_STEPS, BUDGET_TIME };
+
+class WorkBudget {
+	private:
+		std::mutex mut;
+		std::ofstream deferredfs;
+		std::atomic<long> stepsexceeded = 0;
+		std::atomic<long> timeexceeded = 0;
+
+	public:
+		bool enabled = false;
+		long maxsteps = 0; // 0 for no limit
+		double timeoutms = 0;
+		bool deferred = false;
+
+		void init(long steps, double ms)
+		{
+			maxsteps = std::max(0L, steps);
+			timeoutms = std::max(0.0, ms);
+			enabled = maxsteps > 0 or timeoutms > 0;
+		}
+
+		bool open_deferred(const std::string &path)
+		{
+			deferredfs = std::ofstream(path, std::ios::out | std::ios::trunc);
+			deferred = (bool)deferredfs;
+			return deferred;
+		}
+
+		void count(BudgetExceeded reason, const std::string &id, const std::string &sequence)
+		{
+			if (reason == BUDGET_STEPS)
+				stepsexceeded++;
+			else
+				timeexceeded++;
+			if (deferred) {
+				std::scoped_lock lck {mut};
+				deferredfs << ">" << id << "\n" << sequence << "\n";
+			}
+		}
+
+		long get_steps_exceeded() const { return stepsexceeded; }
+		long get_time_exceeded() const { return timeexceeded; }
+};
+
+WorkBudget budget;
+
+// budget of the read being seeded by this thread
+struct ReadBudget {
+	bool active = false;
+	long maxsteps = 0;
+	long steps = 0;
+	long nextclock = 0; // steps at the next reading of the clock
+	bool hasdeadline = false;
+	std::chrono::steady_clock::time_point deadline;
+	BudgetExceeded exceeded = BUDGET_OK;
+};
+thread_local ReadBudget readbudget;
+
+void inline budget_read_begin()
+{
+	if (!budget.enabled)
+		return;
+	readbudget = ReadBudget();
+	readbudget.active = true;
+	readbudget.maxsteps = budget.maxsteps;
+	readbudget.nextclock = BUDGET_CLOCK_STEPS;
+	if (budget.timeoutms > 0) {
+		readbudget.hasdeadline = true;
+		readbudget.deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((long)(budget.timeoutms * 1000));
+	}
+}
+
+/*
+ * budget for a thread seeding part of the read of parent, with the same
+ * deadline and a share of the remaining steps
+ */
+void inline budget_read_share(const ReadBudget &parent, int shares)
+{
+	readbudget = parent;
+	if (!parent.active)
+		return;
+	readbudget.steps = 0;
+	readbudget.nextclock = BUDGET_CLOCK_STEPS;
+	if (parent.maxsteps > 0)
+		readbudget.maxsteps = std::max(1L, (parent.maxsteps - parent.steps) / shares);
+}
+
+// steps and exhaustion of a sharing thread, added to the budget of this thread
+void inline budget_read_join(const ReadBudget &shared)
+{
+	if (!readbudget.active)
+		return;
+	readbudget.steps += shared.steps;
+	if (readbudget.exceeded == BUDGET_OK)
+		readbudget.exceeded = shared.exceeded;
+}
+
+void inline budget_step(long n = 1)
+{
+	if (readbudget.active)
+		readbudget.steps += n;
+}
+
+bool inline budget_exhausted()
+{
+	if (!readbudget.active)
+		return false;
+	if (readbudget.exceeded != BUDGET_OK)
+		return true;
+	if (readbudget.maxsteps > 0 and readbudget.steps > readbudget.maxsteps) {
+		readbudget.exceeded = BUDGET_STEPS;
+	} else if (readbudget.hasdeadline and readbudget.steps >= readbudget.nextclock) {
+		readbudget.nextclock = readbudget.steps + BUDGET_CLOCK_STEPS;
+		if (std::chrono::steady_clock::now() >= readbudget.deadline)
+			readbudget.exceeded = BUDGET_TIME;
+	}
+	return readbudget.exceeded != BUDGET_OK;
+}
+
+// count the read if it exceeded its budget, and return whether it did
+bool inline budget_read_end(const std::string &id, const std::string &sequence)
+{
+	if (!readbudget.active)
+		return false;
+	readbudget.active = false;
+	if (readbudget.exceeded == BUDGET_OK)
+		return false;
+	budget.count(readbudget.exceeded, id, sequence);
+	return true;
+}
+
+} // Namespace efg_locate
+
+#endif
@@ -43,6 +43,12 @@ const char *gengetopt_args_info_full_help[] = {
   "      --approximate-edge-match-longest=COUNT\n                                Consider the COUNT longest substrings of the\n                                  pattern appearing in the edges valid\n                                  (default=`0')",
   "      --approximate-edge-match-longest-max-count=COUNT\n                                Consider the COUNT longest substrings valid\n                                  only if they appear less than N times in the\n                                  edges  (default=`1000')",
   "      --approximate-min-coverage=PERC\n                                Consider approximate occurrences as valid if\n                                  they cover at least PERC % of the pattern\n                                  (default=`0')",
+  "      --approximate-window-length=L\n                                In approximate mode, seed the patterns of at\n                                  least 2L bases in windows of L bases on\n                                  parallel threads, with the same result as\n                                  sequential seeding (0 to disable, not used\n                                  with --ignore-chars)  (default=`0')",
+  "      --approximate-window-overlap=OVERLAP\n                                With --approximate-window-length, start seeding\n                                  each window OVERLAP bases after its end, to\n                                  synchronize with the seeding of the next\n                                  window  (default=`1000')",
+  "      --approximate-window-threads=THREADNUM\n                                With --approximate-window-length, number of\n                                  threads seeding the windows of one pattern:\n                                  the compute thread of the pattern and helpers\n                                  shared by all the compute threads, at most\n                                  THREADNUM-1 and no more than the cores left\n                                  free by --threads  (default=`4')",
+  "      --max-lf-steps=N          In approximate mode, stop seeding a pattern\n                                  after N backward steps in the index and\n                                  output the seeds found so far (0 for no\n                                  limit)  (default=`0')",
+  "      --read-timeout=MS         In approximate mode, stop seeding a pattern\n                                  after MS milliseconds and output the seeds\n                                  found so far (0 for no limit)  (default=`0')",
+  "      --deferred=FILE           Write to FILE in FASTA format the patterns\n                                  exceeding --max-lf-steps or --read-timeout,\n                                  to seed them again with a larger budget",
   "      --approximate-stats       Output statistics for each read in stdout\n                                  (default=off)",
   "      --reverse-complement      Match also the reverse complement of the\n                                  patterns and output the results as a reverse\n                                  graph path  (default=off)",
   "      --rename-reverse-complement\n                                When matching the reverse complement of\n                                  patterns, consider them as a distinct\n                                  patterns by prepending 'rev_' to its name\n                                  (default=off)",
@@ -50,6 +56,18 @@ const char *gengetopt_args_info_full_help[] = {
   "      --split-output-matches-graphaligner\n                                Same as --split-output-matches, but filter out\n                                  node matches of length 1 (for use with\n                                  GraphAligner --extend)  (default=off)",
   "      --split-keep-edge-matches In approximate mode and using option\n                                  --split-output-matches or\n                                  --split-output-matches-graphaligner, do not\n                                  split edge matches  (default=off)",
   "  -t, --threads=THREADNUM       Number of compute threads  (default=`-1')",
+  "      --schedule-window=N       Schedule the patterns in windows of N patterns,\n                                  longest first  (default=`256')",
+  "      --task-bases=B            Group the patterns of a window into tasks of at\n                                  least B bases for the compute threads, which\n                                  steal tasks from each other when idle\n                                  (default=`50000')",
+  "      --ordered-output          When using compute threads, write the results\n                                  in the same order as the input patterns\n                                  (default=off)",
+  "      --ordered-output-window=N With --ordered-output, let the compute threads\n                                  work at most N patterns ahead of the first\n                                  pattern whose results are not written yet\n                                  (default=`1024')",
+  "      --sharded-output          Let each compute thread write its results to\n                                  its own shard file OUTPUT.shardI, and write\n                                  to the output file a manifest listing the\n                                  shards (incompatible with --ordered-output)\n                                  (default=off)",
+  "      --numa-pin                Pin each compute thread to the CPUs of a NUMA\n                                  node, assigning the threads to the nodes\n                                  round robin (Linux only)  (default=off)",
+  "      --numa-replicate          With --numa-pin, give each NUMA node its own\n                                  copy of the graph index (uses one more copy\n                                  of the index memory per node)  (default=off)",
+  "      --profile=FILE            Write to FILE a JSON report of the wall-clock\n                                  time of each phase and, if compiled with make\n                                  PROFILE=1, of the hot-path counters",
+  "      --trace=FILE              Write to FILE a per-read trace of the compute\n                                  threads in Chrome trace-event JSON format\n                                  (chrome://tracing, Perfetto)",
+  "      --trace-threshold=MS      With --trace, trace only the patterns whose\n                                  processing takes at least MS milliseconds\n                                  (default=`0')",
+  "      --progress-interval=SEC   Print a progress line on stderr every SEC\n                                  seconds (0 to disable)  (default=`30')",
+  "      --status-file=FILE        With progress reporting, also write the\n                                  progress to FILE in JSON format, replacing it\n                                  at every update",
   "      --overwrite               Overwrite the output file, if it exists\n                                  (default=off)",
     0
 };
@@ -73,17 +91,36 @@ init_help_array(void)
   gengetopt_args_info_help[13] = gengetopt_args_info_full_help[14];
   gengetopt_args_info_help[14] = gengetopt_args_info_full_help[15];
   gengetopt_args_info_help[15] = gengetopt_args_info_full_help[16];
-  gengetopt_args_info_help[16] = 0; 
+  gengetopt_args_info_help[16] = gengetopt_args_info_full_help[17];
+  gengetopt_args_info_help[17] = gengetopt_args_info_full_help[18];
+  gengetopt_args_info_help[18] = gengetopt_args_info_full_help[19];
+  gengetopt_args_info_help[19] = gengetopt_args_info_full_help[20];
+  gengetopt_args_info_help[20] = gengetopt_args_info_full_help[21];
+  gengetopt_args_info_help[21] = gengetopt_args_info_full_help[22];
+  gengetopt_args_info_help[22] = gengetopt_args_info_full_help[23];
+  gengetopt_args_info_help[23] = gengetopt_args_info_full_help[24];
+  gengetopt_args_info_help[24] = gengetopt_args_info_full_help[25];
+  gengetopt_args_info_help[25] = gengetopt_args_info_full_help[26];
+  gengetopt_args_info_help[26] = gengetopt_args_info_full_help[27];
+  gengetopt_args_info_help[27] = gengetopt_args_info_full_help[28];
+  gengetopt_args_info_help[28] = gengetopt_args_info_full_help[29];
+  gengetopt_args_info_help[29] = gengetopt_args_info_full_help[30];
+  gengetopt_args_info_help[30] = gengetopt_args_info_full_help[31];
+  gengetopt_args_info_help[31] = gengetopt_args_info_full_help[32];
+  gengetopt_args_info_help[32] = gengetopt_args_info_full_help[33];
+  gengetopt_args_info_help[33] = gengetopt_args_info_full_help[34];
+  gengetopt_args_info_help[34] = 0; 
   
 }
 
-const char *gengetopt_args_info_help[17];
+const char *gengetopt_args_info_help[35];
 
 typedef enum {ARG_NO
   , ARG_FLAG
   , ARG_STRING
   , ARG_INT
   , ARG_LONG
+  , ARG_DOUBLE
 } cmdline_parser_arg_type;
 
 static
@@ -111,6 +148,12 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->approximate_edge_match_longest_given = 0 ;
   args_info->approximate_edge_match_longest_max_count_given = 0 ;
   args_info->approximate_min_coverage_given = 0 ;
+  args_info->approximate_window_length_given = 0 ;
+  args_info->approximate_window_overlap_given = 0 ;
+  args_info->approximate_window_threads_given = 0 ;
+  args_info->max_lf_steps_given = 0 ;
+  args_info->read_timeout_given = 0 ;
+  args_info->deferred_given = 0 ;
   args_info->approximate_stats_given = 0 ;
   args_info->reverse_complement_given = 0 ;
   args_info->rename_reverse_complement_given = 0 ;
@@ -118,6 +161,18 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->split_output_matches_graphaligner_given = 0 ;
   args_info->split_keep_edge_matches_given = 0 ;
   args_info->threads_given = 0 ;
+  args_info->schedule_window_given = 0 ;
+  args_info->task_bases_given = 0 ;
+  args_info->ordered_output_given = 0 ;
+  args_info->ordered_output_window_given = 0 ;
+  args_info->sharded_output_given = 0 ;
+  args_info->numa_pin_given = 0 ;
+  args_info->numa_replicate_given = 0 ;
+  args_info->profile_given = 0 ;
+  args_info->trace_given = 0 ;
+  args_info->trace_threshold_given = 0 ;
+  args_info->progress_interval_given = 0 ;
+  args_info->status_file_given = 0 ;
   args_info->overwrite_given = 0 ;
 }
 
@@ -136,6 +191,18 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->approximate_edge_match_longest_max_count_orig = NULL;
   args_info->approximate_min_coverage_arg = 0;
   args_info->approximate_min_coverage_orig = NULL;
+  args_info->approximate_window_length_arg = 0;
+  args_info->approximate_window_length_orig = NULL;
+  args_info->approximate_window_overlap_arg = 1000;
+  args_info->approximate_window_overlap_orig = NULL;
+  args_info->approximate_window_threads_arg = 4;
+  args_info->approximate_window_threads_orig = NULL;
+  args_info->max_lf_steps_arg = 0;
+  args_info->max_lf_steps_orig = NULL;
+  args_info->read_timeout_arg = 0;
+  args_info->read_timeout_orig = NULL;
+  args_info->deferred_arg = NULL;
+  args_info->deferred_orig = NULL;
   args_info->approximate_stats_flag = 0;
   args_info->reverse_complement_flag = 0;
   args_info->rename_reverse_complement_flag = 0;
@@ -144,6 +211,26 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->split_keep_edge_matches_flag = 0;
   args_info->threads_arg = -1;
   args_info->threads_orig = NULL;
+  args_info->schedule_window_arg = 256;
+  args_info->schedule_window_orig = NULL;
+  args_info->task_bases_arg = 50000;
+  args_info->task_bases_orig = NULL;
+  args_info->ordered_output_flag = 0;
+  args_info->ordered_output_window_arg = 1024;
+  args_info->ordered_output_window_orig = NULL;
+  args_info->sharded_output_flag = 0;
+  args_info->numa_pin_flag = 0;
+  args_info->numa_replicate_flag = 0;
+  args_info->profile_arg = NULL;
+  args_info->profile_orig = NULL;
+  args_info->trace_arg = NULL;
+  args_info->trace_orig = NULL;
+  args_info->trace_threshold_arg = 0;
+  args_info->trace_threshold_orig = NULL;
+  args_info->progress_interval_arg = 30;
+  args_info->progress_interval_orig = NULL;
+  args_info->status_file_arg = NULL;
+  args_info->status_file_orig = NULL;
   args_info->overwrite_flag = 0;
   
 }
@@ -162,14 +249,32 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->approximate_edge_match_longest_help = gengetopt_args_info_full_help[6] ;
   args_info->approximate_edge_match_longest_max_count_help = gengetopt_args_info_full_help[7] ;
   args_info->approximate_min_coverage_help = gengetopt_args_info_full_help[8] ;
-  args_info->approximate_stats_help = gengetopt_args_info_full_help[9] ;
-  args_info->reverse_complement_help = gengetopt_args_info_full_help[10] ;
-  args_info->rename_reverse_complement_help = gengetopt_args_info_full_help[11] ;
-  args_info->split_output_matches_help = gengetopt_args_info_full_help[12] ;
-  args_info->split_output_matches_graphaligner_help = gengetopt_args_info_full_help[13] ;
-  args_info->split_keep_edge_matches_help = gengetopt_args_info_full_help[14] ;
-  args_info->threads_help = gengetopt_args_info_full_help[15] ;
-  args_info->overwrite_help = gengetopt_args_info_full_help[16] ;
+  args_info->approximate_window_length_help = gengetopt_args_info_full_help[9] ;
+  args_info->approximate_window_overlap_help = gengetopt_args_info_full_help[10] ;
+  args_info->approximate_window_threads_help = gengetopt_args_info_full_help[11] ;
+  args_info->max_lf_steps_help = gengetopt_args_info_full_help[12] ;
+  args_info->read_timeout_help = gengetopt_args_info_full_help[13] ;
+  args_info->deferred_help = gengetopt_args_info_full_help[14] ;
+  args_info->approximate_stats_help = gengetopt_args_info_full_help[15] ;
+  args_info->reverse_complement_help = gengetopt_args_info_full_help[16] ;
+  args_info->rename_reverse_complement_help = gengetopt_args_info_full_help[17] ;
+  args_info->split_output_matches_help = gengetopt_args_info_full_help[18] ;
+  args_info->split_output_matches_graphaligner_help = gengetopt_args_info_full_help[19] ;
+  args_info->split_keep_edge_matches_help = gengetopt_args_info_full_help[20] ;
+  args_info->threads_help = gengetopt_args_info_full_help[21] ;
+  args_info->schedule_window_help = gengetopt_args_info_full_help[22] ;
+  args_info->task_bases_help = gengetopt_args_info_full_help[23] ;
+  args_info->ordered_output_help = gengetopt_args_info_full_help[24] ;
+  args_info->ordered_output_window_help = gengetopt_args_info_full_help[25] ;
+  args_info->sharded_output_help = gengetopt_args_info_full_help[26] ;
+  args_info->numa_pin_help = gengetopt_args_info_full_help[27] ;
+  args_info->numa_replicate_help = gengetopt_args_info_full_help[28] ;
+  args_info->profile_help = gengetopt_args_info_full_help[29] ;
+  args_info->trace_help = gengetopt_args_info_full_help[30] ;
+  args_info->trace_threshold_help = gengetopt_args_info_full_help[31] ;
+  args_info->progress_interval_help = gengetopt_args_info_full_help[32] ;
+  args_info->status_file_help = gengetopt_args_info_full_help[33] ;
+  args_info->overwrite_help = gengetopt_args_info_full_help[34] ;
   
 }
 
@@ -277,7 +382,25 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_string_field (&(args_info->approximate_edge_match_longest_orig));
   free_string_field (&(args_info->approximate_edge_match_longest_max_count_orig));
   free_string_field (&(args_info->approximate_min_coverage_orig));
+  free_string_field (&(args_info->approximate_window_length_orig));
+  free_string_field (&(args_info->approximate_window_overlap_orig));
+  free_string_field (&(args_info->approximate_window_threads_orig));
+  free_string_field (&(args_info->max_lf_steps_orig));
+  free_string_field (&(args_info->read_timeout_orig));
+  free_string_field (&(args_info->deferred_arg));
+  free_string_field (&(args_info->deferred_orig));
   free_string_field (&(args_info->threads_orig));
+  free_string_field (&(args_info->schedule_window_orig));
+  free_string_field (&(args_info->task_bases_orig));
+  free_string_field (&(args_info->ordered_output_window_orig));
+  free_string_field (&(args_info->profile_arg));
+  free_string_field (&(args_info->profile_orig));
+  free_string_field (&(args_info->trace_arg));
+  free_string_field (&(args_info->trace_orig));
+  free_string_field (&(args_info->trace_threshold_orig));
+  free_string_field (&(args_info->progress_interval_orig));
+  free_string_field (&(args_info->status_file_arg));
+  free_string_field (&(args_info->status_file_orig));
   
   
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -331,6 +454,18 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "approximate-edge-match-longest-max-count", args_info->approximate_edge_match_longest_max_count_orig, 0);
   if (args_info->approximate_min_coverage_given)
     write_into_file(outfile, "approximate-min-coverage", args_info->approximate_min_coverage_orig, 0);
+  if (args_info->approximate_window_length_given)
+    write_into_file(outfile, "approximate-window-length", args_info->approximate_window_length_orig, 0);
+  if (args_info->approximate_window_overlap_given)
+    write_into_file(outfile, "approximate-window-overlap", args_info->approximate_window_overlap_orig, 0);
+  if (args_info->approximate_window_threads_given)
+    write_into_file(outfile, "approximate-window-threads", args_info->approximate_window_threads_orig, 0);
+  if (args_info->max_lf_steps_given)
+    write_into_file(outfile, "max-lf-steps", args_info->max_lf_steps_orig, 0);
+  if (args_info->read_timeout_given)
+    write_into_file(outfile, "read-timeout", args_info->read_timeout_orig, 0);
+  if (args_info->deferred_given)
+    write_into_file(outfile, "deferred", args_info->deferred_orig, 0);
   if (args_info->approximate_stats_given)
     write_into_file(outfile, "approximate-stats", 0, 0 );
   if (args_info->reverse_complement_given)
@@ -345,6 +480,30 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "split-keep-edge-matches", 0, 0 );
   if (args_info->threads_given)
     write_into_file(outfile, "threads", args_info->threads_orig, 0);
+  if (args_info->schedule_window_given)
+    write_into_file(outfile, "schedule-window", args_info->schedule_window_orig, 0);
+  if (args_info->task_bases_given)
+    write_into_file(outfile, "task-bases", args_info->task_bases_orig, 0);
+  if (args_info->ordered_output_given)
+    write_into_file(outfile, "ordered-output", 0, 0 );
+  if (args_info->ordered_output_window_given)
+    write_into_file(outfile, "ordered-output-window", args_info->ordered_output_window_orig, 0);
+  if (args_info->sharded_output_given)
+    write_into_file(outfile, "sharded-output", 0, 0 );
+  if (args_info->numa_pin_given)
+    write_into_file(outfile, "numa-pin", 0, 0 );
+  if (args_info->numa_replicate_given)
+    write_into_file(outfile, "numa-replicate", 0, 0 );
+  if (args_info->profile_given)
+    write_into_file(outfile, "profile", args_info->profile_orig, 0);
+  if (args_info->trace_given)
+    write_into_file(outfile, "trace", args_info->trace_orig, 0);
+  if (args_info->trace_threshold_given)
+    write_into_file(outfile, "trace-threshold", args_info->trace_threshold_orig, 0);
+  if (args_info->progress_interval_given)
+    write_into_file(outfile, "progress-interval", args_info->progress_interval_orig, 0);
+  if (args_info->status_file_given)
+    write_into_file(outfile, "status-file", args_info->status_file_orig, 0);
   if (args_info->overwrite_given)
     write_into_file(outfile, "overwrite", 0, 0 );
   
@@ -522,6 +681,9 @@ int update_arg(void *field, char **orig_field,
   case ARG_LONG:
     if (val) *((long *)field) = (long)strtol (val, &stop_char, 0);
     break;
+  case ARG_DOUBLE:
+    if (val) *((double *)field) = strtod (val, &stop_char);
+    break;
   case ARG_STRING:
     if (val) {
       string_field = (char **)field;
@@ -538,6 +700,7 @@ int update_arg(void *field, char **orig_field,
   switch(arg_type) {
   case ARG_INT:
   case ARG_LONG:
+  case ARG_DOUBLE:
     if (val && !(stop_char && *stop_char == '\0')) {
       fprintf(stderr, "%s: invalid numeric value: %s\n", package_name, val);
       return 1; /* failure */
@@ -620,6 +783,12 @@ cmdline_parser_internal (
         { "approximate-edge-match-longest",	1, NULL, 0 },
         { "approximate-edge-match-longest-max-count",	1, NULL, 0 },
         { "approximate-min-coverage",	1, NULL, 0 },
+        { "approximate-window-length",	1, NULL, 0 },
+        { "approximate-window-overlap",	1, NULL, 0 },
+        { "approximate-window-threads",	1, NULL, 0 },
+        { "max-lf-steps",	1, NULL, 0 },
+        { "read-timeout",	1, NULL, 0 },
+        { "deferred",	1, NULL, 0 },
         { "approximate-stats",	0, NULL, 0 },
         { "reverse-complement",	0, NULL, 0 },
         { "rename-reverse-complement",	0, NULL, 0 },
@@ -627,6 +796,18 @@ cmdline_parser_internal (
         { "split-output-matches-graphaligner",	0, NULL, 0 },
         { "split-keep-edge-matches",	0, NULL, 0 },
         { "threads",	1, NULL, 't' },
+        { "schedule-window",	1, NULL, 0 },
+        { "task-bases",	1, NULL, 0 },
+        { "ordered-output",	0, NULL, 0 },
+        { "ordered-output-window",	1, NULL, 0 },
+        { "sharded-output",	0, NULL, 0 },
+        { "numa-pin",	0, NULL, 0 },
+        { "numa-replicate",	0, NULL, 0 },
+        { "profile",	1, NULL, 0 },
+        { "trace",	1, NULL, 0 },
+        { "trace-threshold",	1, NULL, 0 },
+        { "progress-interval",	1, NULL, 0 },
+        { "status-file",	1, NULL, 0 },
         { "overwrite",	0, NULL, 0 },
         { 0,  0, 0, 0 }
       };
@@ -748,6 +929,90 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* In approximate mode, seed the patterns of at least 2L bases in windows of L bases on parallel threads, with the same result as sequential seeding (0 to disable, not used with --ignore-chars).  */
+          else if (strcmp (long_options[option_index].name, "approximate-window-length") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->approximate_window_length_arg), 
+                 &(args_info->approximate_window_length_orig), &(args_info->approximate_window_length_given),
+                &(local_args_info.approximate_window_length_given), optarg, 0, "0", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "approximate-window-length", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --approximate-window-length, start seeding each window OVERLAP bases after its end, to synchronize with the seeding of the next window.  */
+          else if (strcmp (long_options[option_index].name, "approximate-window-overlap") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->approximate_window_overlap_arg), 
+                 &(args_info->approximate_window_overlap_orig), &(args_info->approximate_window_overlap_given),
+                &(local_args_info.approximate_window_overlap_given), optarg, 0, "1000", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "approximate-window-overlap", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --approximate-window-length, number of threads seeding the windows of one pattern: the compute thread of the pattern and helpers shared by all the compute threads, at most THREADNUM-1 and no more than the cores left free by --threads.  */
+          else if (strcmp (long_options[option_index].name, "approximate-window-threads") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->approximate_window_threads_arg), 
+                 &(args_info->approximate_window_threads_orig), &(args_info->approximate_window_threads_given),
+                &(local_args_info.approximate_window_threads_given), optarg, 0, "4", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "approximate-window-threads", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* In approximate mode, stop seeding a pattern after N backward steps in the index and output the seeds found so far (0 for no limit).  */
+          else if (strcmp (long_options[option_index].name, "max-lf-steps") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->max_lf_steps_arg), 
+                 &(args_info->max_lf_steps_orig), &(args_info->max_lf_steps_given),
+                &(local_args_info.max_lf_steps_given), optarg, 0, "0", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "max-lf-steps", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* In approximate mode, stop seeding a pattern after MS milliseconds and output the seeds found so far (0 for no limit).  */
+          else if (strcmp (long_options[option_index].name, "read-timeout") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->read_timeout_arg), 
+                 &(args_info->read_timeout_orig), &(args_info->read_timeout_given),
+                &(local_args_info.read_timeout_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "read-timeout", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Write to FILE in FASTA format the patterns exceeding --max-lf-steps or --read-timeout, to seed them again with a larger budget.  */
+          else if (strcmp (long_options[option_index].name, "deferred") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->deferred_arg), 
+                 &(args_info->deferred_orig), &(args_info->deferred_given),
+                &(local_args_info.deferred_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "deferred", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* Output statistics for each read in stdout.  */
           else if (strcmp (long_options[option_index].name, "approximate-stats") == 0)
@@ -820,6 +1085,166 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
           
+          }
+          /* Schedule the patterns in windows of N patterns, longest first.  */
+          else if (strcmp (long_options[option_index].name, "schedule-window") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->schedule_window_arg), 
+                 &(args_info->schedule_window_orig), &(args_info->schedule_window_given),
+                &(local_args_info.schedule_window_given), optarg, 0, "256", ARG_INT,
+                check_ambiguity, override, 0, 0,
+                "schedule-window", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Group the patterns of a window into tasks of at least B bases for the compute threads, which steal tasks from each other when idle.  */
+          else if (strcmp (long_options[option_index].name, "task-bases") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->task_bases_arg), 
+                 &(args_info->task_bases_orig), &(args_info->task_bases_given),
+                &(local_args_info.task_bases_given), optarg, 0, "50000", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "task-bases", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* When using compute threads, write the results in the same order as the input patterns.  */
+          else if (strcmp (long_options[option_index].name, "ordered-output") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->ordered_output_flag), 0, &(args_info->ordered_output_given),
+                &(local_args_info.ordered_output_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "ordered-output", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --ordered-output, let the compute threads work at most N patterns ahead of the first pattern whose results are not written yet.  */
+          else if (strcmp (long_options[option_index].name, "ordered-output-window") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->ordered_output_window_arg), 
+                 &(args_info->ordered_output_window_orig), &(args_info->ordered_output_window_given),
+                &(local_args_info.ordered_output_window_given), optarg, 0, "1024", ARG_LONG,
+                check_ambiguity, override, 0, 0,
+                "ordered-output-window", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Let each compute thread write its results to its own shard file OUTPUT.shardI, and write to the output file a manifest listing the shards (incompatible with --ordered-output).  */
+          else if (strcmp (long_options[option_index].name, "sharded-output") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->sharded_output_flag), 0, &(args_info->sharded_output_given),
+                &(local_args_info.sharded_output_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "sharded-output", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Pin each compute thread to the CPUs of a NUMA node, assigning the threads to the nodes round robin (Linux only).  */
+          else if (strcmp (long_options[option_index].name, "numa-pin") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->numa_pin_flag), 0, &(args_info->numa_pin_given),
+                &(local_args_info.numa_pin_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "numa-pin", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --numa-pin, give each NUMA node its own copy of the graph index (uses one more copy of the index memory per node).  */
+          else if (strcmp (long_options[option_index].name, "numa-replicate") == 0)
+          {
+          
+          
+            if (update_arg((void *)&(args_info->numa_replicate_flag), 0, &(args_info->numa_replicate_given),
+                &(local_args_info.numa_replicate_given), optarg, 0, 0, ARG_FLAG,
+                check_ambiguity, override, 1, 0, "numa-replicate", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Write to FILE a JSON report of the wall-clock time of each phase and, if compiled with make PROFILE=1, of the hot-path counters.  */
+          else if (strcmp (long_options[option_index].name, "profile") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->profile_arg), 
+                 &(args_info->profile_orig), &(args_info->profile_given),
+                &(local_args_info.profile_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "profile", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Write to FILE a per-read trace of the compute threads in Chrome trace-event JSON format (chrome://tracing, Perfetto).  */
+          else if (strcmp (long_options[option_index].name, "trace") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->trace_arg), 
+                 &(args_info->trace_orig), &(args_info->trace_given),
+                &(local_args_info.trace_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "trace", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With --trace, trace only the patterns whose processing takes at least MS milliseconds.  */
+          else if (strcmp (long_options[option_index].name, "trace-threshold") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->trace_threshold_arg), 
+                 &(args_info->trace_threshold_orig), &(args_info->trace_threshold_given),
+                &(local_args_info.trace_threshold_given), optarg, 0, "0", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "trace-threshold", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* Print a progress line on stderr every SEC seconds (0 to disable).  */
+          else if (strcmp (long_options[option_index].name, "progress-interval") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->progress_interval_arg), 
+                 &(args_info->progress_interval_orig), &(args_info->progress_interval_given),
+                &(local_args_info.progress_interval_given), optarg, 0, "30", ARG_DOUBLE,
+                check_ambiguity, override, 0, 0,
+                "progress-interval", '-',
+                additional_error))
+              goto failure;
+          
+          }
+          /* With progress reporting, also write the progress to FILE in JSON format, replacing it at every update.  */
+          else if (strcmp (long_options[option_index].name, "status-file") == 0)
+          {
+          
+          
+            if (update_arg( (void *)&(args_info->status_file_arg), 
+                 &(args_info->status_file_orig), &(args_info->status_file_given),
+                &(local_args_info.status_file_given), optarg, 0, 0, ARG_STRING,
+                check_ambiguity, override, 0, 0,
+                "status-file", '-',
+                additional_error))
+              goto failure;
+          
           }
           /* Overwrite the output file, if it exists.  */
           else if (strcmp (long_options[option_index].name, "overwrite") == 0)
@@ -57,6 +57,24 @@ struct gengetopt_args_info
   int approximate_min_coverage_arg;	/**< @brief Consider approximate occurrences as valid if they cover at least PERC % of the pattern (default='0').  */
   char * approximate_min_coverage_orig;	/**< @brief Consider approximate occurrences as valid if they cover at least PERC % of the pattern original value given at command line.  */
   const char *approximate_min_coverage_help; /**< @brief Consider approximate occurrences as valid if they cover at least PERC % of the pattern help description.  */
+  int approximate_window_length_arg;	/**< @brief In approximate mode, seed the patterns of at least 2L bases in windows of L bases on parallel threads, with the same result as sequential seeding (0 to disable, not used with --ignore-chars) (default='0').  */
+  char * approximate_window_length_orig;	/**< @brief In approximate mode, seed the patterns of at least 2L bases in windows of L bases on parallel threads, with the same result as sequential seeding (0 to disable, not used with --ignore-chars) original value given at command line.  */
+  const char *approximate_window_length_help; /**< @brief In approximate mode, seed the patterns of at least 2L bases in windows of L bases on parallel threads, with the same result as sequential seeding (0 to disable, not used with --ignore-chars) help description.  */
+  int approximate_window_overlap_arg;	/**< @brief With --approximate-window-length, start seeding each window OVERLAP bases after its end, to synchronize with the seeding of the next window (default='1000').  */
+  char * approximate_window_overlap_orig;	/**< @brief With --approximate-window-length, start seeding each window OVERLAP bases after its end, to synchronize with the seeding of the next window original value given at command line.  */
+  const char *approximate_window_overlap_help; /**< @brief With --approximate-window-length, start seeding each window OVERLAP bases after its end, to synchronize with the seeding of the next window help description.  */
+  int approximate_window_threads_arg;	/**< @brief With --approximate-window-length, number of threads seeding the windows of one pattern: the compute thread of the pattern and helpers shared by all the compute threads, at most THREADNUM-1 and no more than the cores left free by --threads (default='4').  */
+  char * approximate_window_threads_orig;	/**< @brief With --approximate-window-length, number of threads seeding the windows of one pattern: the compute thread of the pattern and helpers shared by all the compute threads, at most THREADNUM-1 and no more than the cores left free by --threads original value given at command line.  */
+  const char *approximate_window_threads_help; /**< @brief With --approximate-window-length, number of threads seeding the windows of one pattern: the compute thread of the pattern and helpers shared by all the compute threads, at most THREADNUM-1 and no more than the cores left free by --threads help description.  */
+  long max_lf_steps_arg;	/**< @brief In approximate mode, stop seeding a pattern after N backward steps in the index and output the seeds found so far (0 for no limit) (default='0').  */
+  char * max_lf_steps_orig;	/**< @brief In approximate mode, stop seeding a pattern after N backward steps in the index and output the seeds found so far (0 for no limit) original value given at command line.  */
+  const char *max_lf_steps_help; /**< @brief In approximate mode, stop seeding a pattern after N backward steps in the index and output the seeds found so far (0 for no limit) help description.  */
+  double read_timeout_arg;	/**< @brief In approximate mode, stop seeding a pattern after MS milliseconds and output the seeds found so far (0 for no limit) (default='0').  */
+  char * read_timeout_orig;	/**< @brief In approximate mode, stop seeding a pattern after MS milliseconds and output the seeds found so far (0 for no limit) original value given at command line.  */
+  const char *read_timeout_help; /**< @brief In approximate mode, stop seeding a pattern after MS milliseconds and output the seeds found so far (0 for no limit) help description.  */
+  char * deferred_arg;	/**< @brief Write to FILE in FASTA format the patterns exceeding --max-lf-steps or --read-timeout, to seed them again with a larger budget.  */
+  char * deferred_orig;	/**< @brief Write to FILE in FASTA format the patterns exceeding --max-lf-steps or --read-timeout, to seed them again with a larger budget original value given at command line.  */
+  const char *deferred_help; /**< @brief Write to FILE in FASTA format the patterns exceeding --max-lf-steps or --read-timeout, to seed them again with a larger budget help description.  */
   int approximate_stats_flag;	/**< @brief Output statistics for each read in stdout (default=off).  */
   const char *approximate_stats_help; /**< @brief Output statistics for each read in stdout help description.  */
   int reverse_complement_flag;	/**< @brief Match also the reverse complement of the patterns and output the results as a reverse graph path (default=off).  */
@@ -72,6 +90,38 @@ struct gengetopt_args_info
   long threads_arg;	/**< @brief Number of compute threads (default='-1').  */
   char * threads_orig;	/**< @brief Number of compute threads original value given at command line.  */
   const char *threads_help; /**< @brief Number of compute threads help description.  */
+  int schedule_window_arg;	/**< @brief Schedule the patterns in windows of N patterns, longest first (default='256').  */
+  char * schedule_window_orig;	/**< @brief Schedule the patterns in windows of N patterns, longest first original value given at command line.  */
+  const char *schedule_window_help; /**< @brief Schedule the patterns in windows of N patterns, longest first help description.  */
+  long task_bases_arg;	/**< @brief Group the patterns of a window into tasks of at least B bases for the compute threads, which steal tasks from each other when idle (default='50000').  */
+  char * task_bases_orig;	/**< @brief Group the patterns of a window into tasks of at least B bases for the compute threads, which steal tasks from each other when idle original value given at command line.  */
+  const char *task_bases_help; /**< @brief Group the patterns of a window into tasks of at least B bases for the compute threads, which steal tasks from each other when idle help description.  */
+  int ordered_output_flag;	/**< @brief When using compute threads, write the results in the same order as the input patterns (default=off).  */
+  const char *ordered_output_help; /**< @brief When using compute threads, write the results in the same order as the input patterns help description.  */
+  long ordered_output_window_arg;	/**< @brief With --ordered-output, let the compute threads work at most N patterns ahead of the first pattern whose results are not written yet (default='1024').  */
+  char * ordered_output_window_orig;	/**< @brief With --ordered-output, let the compute threads work at most N patterns ahead of the first pattern whose results are not written yet original value given at command line.  */
+  const char *ordered_output_window_help; /**< @brief With --ordered-output, let the compute threads work at most N patterns ahead of the first pattern whose results are not written yet help description.  */
+  int sharded_output_flag;	/**< @brief Let each compute thread write its results to its own shard file OUTPUT.shardI, and write to the output file a manifest listing the shards (incompatible with --ordered-output) (default=off).  */
+  const char *sharded_output_help; /**< @brief Let each compute thread write its results to its own shard file OUTPUT.shardI, and write to the output file a manifest listing the shards (incompatible with --ordered-output) help description.  */
+  int numa_pin_flag;	/**< @brief Pin each compute thread to the CPUs of a NUMA node, assigning the threads to the nodes round robin (Linux only) (default=off).  */
+  const char *numa_pin_help; /**< @brief Pin each compute thread to the CPUs of a NUMA node, assigning the threads to the nodes round robin (Linux only) help description.  */
+  int numa_replicate_flag;	/**< @brief With --numa-pin, give each NUMA node its own copy of the graph index (uses one more copy of the index memory per node) (default=off).  */
+  const char *numa_replicate_help; /**< @brief With --numa-pin, give each NUMA node its own copy of the graph index (uses one more copy of the index memory per node) help description.  */
+  char * profile_arg;	/**< @brief Write to FILE a JSON report of the wall-clock time of each phase and, if compiled with make PROFILE=1, of the hot-path counters.  */
+  char * profile_orig;	/**< @brief Write to FILE a JSON report of the wall-clock time of each phase and, if compiled with make PROFILE=1, of the hot-path counters original value given at command line.  */
+  const char *profile_help; /**< @brief Write to FILE a JSON report of the wall-clock time of each phase and, if compiled with make PROFILE=1, of the hot-path counters help description.  */
+  char * trace_arg;	/**< @brief Write to FILE a per-read trace of the compute threads in Chrome trace-event JSON format (chrome://tracing, Perfetto).  */
+  char * trace_orig;	/**< @brief Write to FILE a per-read trace of the compute threads in Chrome trace-event JSON format (chrome://tracing, Perfetto) original value given at command line.  */
+  const char *trace_help; /**< @brief Write to FILE a per-read trace of the compute threads in Chrome trace-event JSON format (chrome://tracing, Perfetto) help description.  */
+  double trace_threshold_arg;	/**< @brief With --trace, trace only the patterns whose processing takes at least MS milliseconds (default='0').  */
+  char * trace_threshold_orig;	/**< @brief With --trace, trace only the patterns whose processing takes at least MS milliseconds original value given at command line.  */
+  const char *trace_threshold_help; /**< @brief With --trace, trace only the patterns whose processing takes at least MS milliseconds help description.  */
+  double progress_interval_arg;	/**< @brief Print a progress line on stderr every SEC seconds (0 to disable) (default='30').  */
+  char * progress_interval_orig;	/**< @brief Print a progress line on stderr every SEC seconds (0 to disable) original value given at command line.  */
+  const char *progress_interval_help; /**< @brief Print a progress line on stderr every SEC seconds (0 to disable) help description.  */
+  char * status_file_arg;	/**< @brief With progress reporting, also write the progress to FILE in JSON format, replacing it at every update.  */
+  char * status_file_orig;	/**< @brief With progress reporting, also write the progress to FILE in JSON format, replacing it at every update original value given at command line.  */
+  const char *status_file_help; /**< @brief With progress reporting, also write the progress to FILE in JSON format, replacing it at every update help description.  */
   int overwrite_flag;	/**< @brief Overwrite the output file, if it exists (default=off).  */
   const char *overwrite_help; /**< @brief Overwrite the output file, if it exists help description.  */
   
@@ -84,6 +134,12 @@ struct gengetopt_args_info
   unsigned int approximate_edge_match_longest_given ;	/**< @brief Whether approximate-edge-match-longest was given.  */
   unsigned int approximate_edge_match_longest_max_count_given ;	/**< @brief Whether approximate-edge-match-longest-max-count was given.  */
   unsigned int approximate_min_coverage_given ;	/**< @brief Whether approximate-min-coverage was given.  */
+  unsigned int approximate_window_length_given ;	/**< @brief Whether approximate-window-length was given.  */
+  unsigned int approximate_window_overlap_given ;	/**< @brief Whether approximate-window-overlap was given.  */
+  unsigned int approximate_window_threads_given ;	/**< @brief Whether approximate-window-threads was given.  */
+  unsigned int max_lf_steps_given ;	/**< @brief Whether max-lf-steps was given.  */
+  unsigned int read_timeout_given ;	/**< @brief Whether read-timeout was given.  */
+  unsigned int deferred_given ;	/**< @brief Whether deferred was given.  */
   unsigned int approximate_stats_given ;	/**< @brief Whether approximate-stats was given.  */
   unsigned int reverse_complement_given ;	/**< @brief Whether reverse-complement was given.  */
   unsigned int rename_reverse_complement_given ;	/**< @brief Whether rename-reverse-complement was given.  */
@@ -91,6 +147,18 @@ struct gengetopt_args_info
   unsigned int split_output_matches_graphaligner_given ;	/**< @brief Whether split-output-matches-graphaligner was given.  */
   unsigned int split_keep_edge_matches_given ;	/**< @brief Whether split-keep-edge-matches was given.  */
   unsigned int threads_given ;	/**< @brief Whether threads was given.  */
+  unsigned int schedule_window_given ;	/**< @brief Whether schedule-window was given.  */
+  unsigned int task_bases_given ;	/**< @brief Whether task-bases was given.  */
+  unsigned int ordered_output_given ;	/**< @brief Whether ordered-output was given.  */
+  unsigned int ordered_output_window_given ;	/**< @brief Whether ordered-output-window was given.  */
+  unsigned int sharded_output_given ;	/**< @brief Whether sharded-output was given.  */
+  unsigned int numa_pin_given ;	/**< @brief Whether numa-pin was given.  */
+  unsigned int numa_replicate_given ;	/**< @brief Whether numa-replicate was given.  */
+  unsigned int profile_given ;	/**< @brief Whether profile was given.  */
+  unsigned int trace_given ;	/**< @brief Whether trace was given.  */
+  unsigned int trace_threshold_given ;	/**< @brief Whether trace-threshold was given.  */
+  unsigned int progress_interval_given ;	/**< @brief Whether progress-interval was given.  */
+  unsigned int status_file_given ;	/**< @brief Whether status-file was given.  */
   unsigned int overwrite_given ;	/**< @brief Whether overwrite was given.  */
 
   char **inputs ; /**< @brief unnamed options (options without names) */
@@ -6,10 +6,17 @@
 #include <vector>
 #include <cassert>
 #include <unordered_map>
+#include <chrono>
 
 #include "efg-locate.hpp"
 #include "command-line-parsing/cmdline.h" // gengetopt-generated parser
 #include "efg.hpp"
+#include "../common/shards.hpp"
+#include "../common/numa.hpp"
+#include "profile.hpp"
+#include "../common/trace.hpp"
+#include "../common/progress.hpp"
+#include "budget.hpp"
 #include "algo.cpp"
 
 //#define LOCATE_DEBUG
@@ -44,6 +51,19 @@ int main(int argc, char* argv[])
 	params.edgemincount = argsinfo.approximate_edge_match_min_count_arg;
 	params.edgelongestcount = argsinfo.approximate_edge_match_longest_arg;
 	params.edgelongestcountmax = argsinfo.approximate_edge_match_longest_max_count_arg;
+	params.windowlength = max(0, argsinfo.approximate_window_length_arg);
+	params.windowoverlap = max(0, argsinfo.approximate_window_overlap_arg);
+	params.windowthreads = argsinfo.approximate_window_threads_arg;
+	params.schedulewindow = max(1, argsinfo.schedule_window_arg);
+	params.taskbases = argsinfo.task_bases_arg;
+	params.orderedoutput = argsinfo.ordered_output_flag;
+	params.orderedoutputwindow = max(1L, argsinfo.ordered_output_window_arg);
+	params.shardedoutput = argsinfo.sharded_output_flag;
+	params.numapin = argsinfo.numa_pin_flag or argsinfo.numa_replicate_flag;
+	params.numareplicate = argsinfo.numa_replicate_flag;
+
+	if (params.orderedoutput and params.shardedoutput)
+		{std::cerr << argv[0] << ": --ordered-output and --sharded-output are incompatible" << std::endl; exit(1);};
 
 	// open graph file
 	std::filesystem::path graphpath {argsinfo.inputs[0]};
@@ -63,14 +83,63 @@ int main(int argc, char* argv[])
 		params.outputfs = std::ofstream(outputpath);
 	}
 	if (!params.outputfs) {std::cerr << "Error opening output file " << outputpath << "." << std::endl; exit(1);};
+	if (params.shardedoutput) {
+		if (!open_shards(outputpath, max(1, params.threads), argsinfo.overwrite_flag, params.shardfs))
+			exit(1);
+		write_shard_manifest(params.outputfs, outputpath, params.shardfs.size());
+	}
+
+	// open profile file, written at exit, see profile.hpp
+	std::ofstream profilefs;
+	if (argsinfo.profile_given) {
+		profilefs = std::ofstream(argsinfo.profile_arg, std::ios::out | std::ios::trunc);
+		if (!profilefs) {std::cerr << "Error opening profile file " << argsinfo.profile_arg << "." << std::endl; exit(1);};
+	}
+	// per-read work budget and deferred patterns file, see budget.hpp
+	budget.init(argsinfo.max_lf_steps_arg, argsinfo.read_timeout_arg);
+	if (argsinfo.deferred_given and !budget.open_deferred(argsinfo.deferred_arg))
+		{std::cerr << "Error opening deferred patterns file " << argsinfo.deferred_arg << "." << std::endl; exit(1);};
+	// open trace file, see trace.hpp
+	std::ofstream tracefs;
+	if (argsinfo.trace_given) {
+		tracefs = std::ofstream(argsinfo.trace_arg, std::ios::out | std::ios::trunc);
+		if (!tracefs) {std::cerr << "Error opening trace file " << argsinfo.trace_arg << "." << std::endl; exit(1);};
+		tracer.init(argsinfo.trace_threshold_arg);
+	}
+	vector<std::pair<string,double>> phases;
+	auto phasestart = std::chrono::steady_clock::now();
+	auto end_phase = [&phases, &phasestart](const string &name) {
+		const auto now = std::chrono::steady_clock::now();
+		phases.push_back(std::pair<string,double>(name, std::chrono::duration<double>(now - phasestart).count()));
+		phasestart = now;
+	};
 
 	std::cerr << "Reading the graph..." << std::flush;
 	Elasticfoundergraph graph(params.graphfs);
 	std::cerr << " done." << std::endl;
+	end_phase("graph_parse");
 
 	std::cerr << "Indexing the graph..." << std::flush;
 	graph.init_pattern_matching_support();
 	std::cerr << " done." << std::endl;
+	end_phase("index_build");
+
+	// NUMA placement of the compute threads, see numa.hpp
+	vector<vector<int>> numanodes;
+	vector<std::unique_ptr<Elasticfoundergraph>> replicas;
+	if (params.numapin and params.threads > 0) {
+		numanodes = numa_nodes_cpus();
+		if (numanodes.size() == 0)
+			std::cerr << "Warning: cannot read the NUMA topology, compute threads are not pinned." << std::endl;
+		else
+			std::cerr << "Pinning the compute threads to " << numanodes.size() << " NUMA node(s)." << std::endl;
+		if (numanodes.size() > 0 and params.numareplicate) {
+			std::cerr << "Replicating the graph index on each NUMA node..." << std::flush;
+			replicas = replicate_on_nodes(graph, numanodes);
+			std::cerr << " done." << std::endl;
+			end_phase("numa_replicate");
+		}
+	}
 
 #ifdef LOCATE_DEBUG 
 	std::cerr << "DEBUG graph is " << std::endl;
@@ -82,16 +151,26 @@ int main(int argc, char* argv[])
 	params.patternsfs = std::ifstream {patternspath};
 	if (!params.patternsfs) {std::cerr << "Error opening patterns file " << patternspath << "." << std::endl; exit(1);};
 
+	// progress reporting, see progress.hpp
+	progress.init(max(1, params.threads));
+	std::error_code ec;
+	progress.totalbytes = std::filesystem::is_regular_file(patternspath, ec) ? std::filesystem::file_size(patternspath, ec) : 0;
+	progress.add_queue("input", []() { return scheduler.get_queued(); });
+	progress.add_queue("output", []() { return (long)outputqueue.size_approx(); });
+
 	std::atomic<bool> input_done = false;
 	std::thread inputworker;
 	vector<string> pattern_ids, patterns;
 	if ((argsinfo.approximate_flag and params.threads > 0) or (!argsinfo.approximate_flag)) {
 		std::cerr << "Locate" << std::endl;
-		inputworker = std::thread(reader_worker, std::ref(params.patternsfs), std::ref(input_done));
+		scheduler.init(max(1, params.threads), 4 * max(1, params.threads) + 16);
+		inputworker = std::thread(reader_worker, std::ref(params.patternsfs), std::ref(input_done), std::ref(params));
 	} else {
 		std::cerr << "Reading the patterns..." << std::flush;
 		std::tie(pattern_ids, patterns) = read_patterns(params.patternsfs);
+		progress.totalreads = patterns.size();
 		std::cerr << " done." << std::endl;
+		end_phase("pattern_read");
 	}
 
 #ifdef LOCATE_DEBUG 
@@ -101,57 +180,118 @@ int main(int argc, char* argv[])
 	}
 #endif
 
+	if (argsinfo.progress_interval_arg > 0)
+		progress.start_reporting(argsinfo.progress_interval_arg, (argsinfo.status_file_given) ? argsinfo.status_file_arg : "");
+
 	int returnvalue = 0;
 	// exact pattern matching
 	if (!argsinfo.approximate_flag) {
 		std::atomic<bool> workers_done = false;
 		std::thread outputworker(writer_worker, std::ref(workers_done), std::ref(params));
 		vector<std::thread> workers;
-		for (int i = 0; i < max(1,params.threads); i++)
-			workers.push_back(std::thread(exact_worker, std::ref(graph), std::ref(pattern_ids), std::ref(patterns), std::ref(params), std::ref(input_done)));
+		for (int i = 0; i < max(1,params.threads); i++) {
+			const Elasticfoundergraph &g = (replicas.size() > 0) ? *replicas[i % replicas.size()] : graph;
+			workers.push_back(std::thread(exact_worker, std::ref(g), std::ref(pattern_ids), std::ref(patterns), std::ref(params), std::ref(input_done), i));
+			if (numanodes.size() > 0)
+				pin_thread(workers.back().native_handle(), numanodes[i % numanodes.size()]);
+		}
 		for (int i = 0; i < workers.size(); i++)
 			workers[i].join();
+		progress.stop();
+		end_phase("seeding");
 		workers_done = true;
 		inputworker.join();
+		std::cerr << "tail time is " << scheduler.tail_time() << " s (" << scheduler.get_steals() << " tasks stolen)" << std::endl;
+		progress.report_utilisation(std::cerr);
 		outputworker.join();
 		// sanity check?
 		outputworker = std::thread(writer_worker, std::ref(workers_done), std::ref(params));
 		outputworker.join();
+		end_phase("output");
+		if (argsinfo.profile_given)
+			write_profile(profilefs, phases);
+		if (argsinfo.trace_given) {
+			tracer.write(tracefs);
+			std::cerr << "Traced " << tracer.get_traced_reads() << " pattern(s)." << std::endl;
+		}
 		return 0;
 	}
 
 	if (argsinfo.approximate_flag) {
+		// helpers seeding the windows of long patterns, only on the cores left free by the compute threads
+		if (params.windowlength > 0 and params.windowthreads > 1) {
+			const int freecores = max(0, (int)std::thread::hardware_concurrency() - max(1, params.threads));
+			windowpool.start(std::min(params.windowthreads - 1, freecores));
+			std::cerr << "Seeding windows with " << windowpool.size() << " helper thread(s)." << std::endl;
+		}
 		if (params.threads > 0) {
 			std::atomic<bool> workers_done = false;
 			std::thread outputworker(writer_worker, std::ref(workers_done), std::ref(params));
 			vector<std::thread> workers;
-			for (int i = 0; i < params.threads; i++)
-				workers.push_back(std::thread(approx_worker, std::ref(graph), std::ref(pattern_ids), std::ref(patterns), std::ref(params), std::ref(input_done)));
+			for (int i = 0; i < params.threads; i++) {
+				const Elasticfoundergraph &g = (replicas.size() > 0) ? *replicas[i % replicas.size()] : graph;
+				workers.push_back(std::thread(approx_worker, std::ref(g), std::ref(pattern_ids), std::ref(patterns), std::ref(params), std::ref(input_done), i));
+				if (numanodes.size() > 0)
+					pin_thread(workers.back().native_handle(), numanodes[i % numanodes.size()]);
+			}
 			for (int i = 0; i < workers.size(); i++)
 				workers[i].join();
+			progress.stop();
+			end_phase("seeding");
 			workers_done = true;
 			inputworker.join();
+			std::cerr << "tail time is " << scheduler.tail_time() << " s (" << scheduler.get_steals() << " tasks stolen)" << std::endl;
+			progress.report_utilisation(std::cerr);
 			outputworker.join();
 			// sanity check?
 			outputworker = std::thread(writer_worker, std::ref(workers_done), std::ref(params));
 			outputworker.join();
+			end_phase("output");
 		} else {
+			// seeding and output are interleaved, the output time is accumulated apart
+			std::ofstream &outputfs = (params.shardedoutput) ? params.shardfs[0] : params.outputfs;
+			double outputtime = 0;
 			for (int p = 0; p < patterns.size(); p++) {
 				vector<GAFAnchor> matches;
 
-				if (approx_efg_backward_search(graph, pattern_ids[p], patterns[p], params, matches) != 0) {
-					if (params.splitoutputmatches)
-						anchors_to_stream_split_single(&params.outputfs, graph, matches, params.splitkeepedgematches);
-					else if (params.splitoutputmatchesgraphaligner)
-						anchors_to_stream_split_single_graphaligner(&params.outputfs, graph, matches, params.splitkeepedgematches);
-					else
-						anchors_to_stream(&params.outputfs, graph, matches);
+				trace_read_begin(pattern_ids[p]);
+				PROFILE_ONLY(const unsigned long long restarts = profile_local().greedyrestarts);
+				budget_read_begin();
+				const int found = approx_efg_backward_search(graph, pattern_ids[p], patterns[p], params, matches);
+				budget_read_end(pattern_ids[p], patterns[p]);
+				PROFILE_ADD(patterns, 1);
+				PROFILE_ONLY(profile_local().maxgreedyrestarts = std::max(profile_local().maxgreedyrestarts, profile_local().greedyrestarts - restarts));
+				if (found != 0) {
+					const auto outputstart = std::chrono::steady_clock::now();
+					format_matches(&outputfs, graph, matches, params);
+					outputtime += std::chrono::duration<double>(std::chrono::steady_clock::now() - outputstart).count();
 				} else {
 					cerr << "Cannot find any semi-repeat-free match of " << pattern_ids[p] << std::endl;
 				}
+				progress.count_read(0, patterns[p].size(), (found != 0) ? matches.size() : 0);
+				trace_read_end();
 			}
+			progress.stop();
+			outputfs.flush();
+			end_phase("seeding");
+			phases.back().second -= outputtime;
+			phases.push_back(std::pair<string,double>("output", outputtime));
 		}
+		windowpool.stop();
 
+		if (budget.enabled) {
+			std::cerr << budget.get_steps_exceeded() + budget.get_time_exceeded() << " pattern(s) exceeded the work budget (";
+			std::cerr << budget.get_steps_exceeded() << " LF steps, " << budget.get_time_exceeded() << " time)";
+			if (budget.deferred)
+				std::cerr << ", written to " << argsinfo.deferred_arg;
+			std::cerr << "." << std::endl;
+		}
+		if (argsinfo.profile_given)
+			write_profile(profilefs, phases);
+		if (argsinfo.trace_given) {
+			tracer.write(tracefs);
+			std::cerr << "Traced " << tracer.get_traced_reads() << " pattern(s)." << std::endl;
+		}
 		return 0;
 	}
 
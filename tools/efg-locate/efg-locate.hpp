@@ -3,10 +3,16 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 using std::string, std::ifstream, std::ofstream;
 
+// headers shared with chainx-block-graph, see ../common
+namespace efg_common {}
+
 namespace efg_locate {
+using namespace efg_common;
+
 struct Params {
 	ifstream graphfs;
 	ifstream patternsfs;
@@ -23,6 +29,25 @@ struct Params {
 	int edgemincount;
 	int edgelongestcount;
 	int edgelongestcountmax;
+	int windowlength;
+	int windowoverlap;
+	int windowthreads;
+	int schedulewindow;
+	long taskbases;
+	bool orderedoutput;
+	int orderedoutputwindow;
+	bool shardedoutput;
+	std::vector<ofstream> shardfs; // with --sharded-output, one per compute thread
+	bool numapin;
+	bool numareplicate;
+};
+
+// input pattern, numbered by its position in the patterns file
+struct InputPattern {
+	long seq;
+	string id;
+	string sequence;
+	double queued; // time of reading in microseconds, with --trace (see trace.hpp)
 };
 }
 
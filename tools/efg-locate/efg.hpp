@@ -64,7 +64,7 @@ class Elasticfoundergraph {
 
 
 	public:
-		Elasticfoundergraph(std::ifstream &graphstream)
+		Elasticfoundergraph(std::istream &graphstream)
 		{
 			int nodes = 0;
 
@@ -157,6 +157,27 @@ class Elasticfoundergraph {
 			return true;
 		}
 
+		// deep copy (e.g. a per-NUMA-node replica): the rank/select supports
+		// must point to the copied bitvectors, not to those of other
+		Elasticfoundergraph(const Elasticfoundergraph &other) :
+			m(other.m), n(other.n),
+			cuts(other.cuts), heights(other.heights), cumulative_height(other.cumulative_height),
+			ordered_node_ids(other.ordered_node_ids),
+			node_indexes(other.node_indexes),
+			ordered_node_labels(other.ordered_node_labels),
+			edges(other.edges),
+			is_source(other.is_source),
+			edge_index(other.edge_index),
+			node_leaders(other.node_leaders), edge_leaders(other.edge_leaders),
+			node_leaders_rank_support(other.node_leaders_rank_support), edge_leaders_rank_support(other.edge_leaders_rank_support),
+			node_leaders_select_support(other.node_leaders_select_support), edge_leaders_select_support(other.edge_leaders_select_support)
+		{
+			node_leaders_rank_support.set_vector(&node_leaders);
+			node_leaders_select_support.set_vector(&node_leaders);
+			edge_leaders_rank_support.set_vector(&edge_leaders);
+			edge_leaders_select_support.set_vector(&edge_leaders);
+		}
+
 		int get_node(const string node_id) const
 		{
 			//TODO: warn the user
@@ -189,6 +210,42 @@ class Elasticfoundergraph {
 			return ordered_node_labels[node].size();
 		}
 
+		// the parsed graph, for ChainX-block-graph --seed-reads in the same process
+		int get_rows() const
+		{
+			return m;
+		}
+
+		int get_columns() const
+		{
+			return n;
+		}
+
+		const vector<int> &get_cuts() const
+		{
+			return cuts;
+		}
+
+		const vector<int> &get_heights() const
+		{
+			return heights;
+		}
+
+		const vector<string> &get_ids() const
+		{
+			return ordered_node_ids;
+		}
+
+		const vector<string> &get_labels() const
+		{
+			return ordered_node_labels;
+		}
+
+		const map<int,vector<int>> &get_edges() const
+		{
+			return edges;
+		}
+
 		void init_pattern_matching_support()
 		{
 			is_source = bit_vector(ordered_node_ids.size() + 1, true);
@@ -333,6 +390,12 @@ class Elasticfoundergraph {
 			}
 		}
 
+		// for the microbenchmarks of the search kernels
+		const csa_type &get_edge_index() const
+		{
+			return edge_index;
+		}
+
 		std::pair<int,int> locate_edge(size_type lex_rank) const
 		{
 			int startnode = node_leaders_rank_support(edge_index[lex_rank]+1)-1;
@@ -582,6 +645,37 @@ class GAFAnchor {
 			return path.size();
 		}
 
+		// the other GAF fields, for ChainX-block-graph --seed-reads
+		int get_query_length() const
+		{
+			return qlength;
+		}
+
+		int get_query_end() const
+		{
+			return qend;
+		}
+
+		const vector<int> &get_path() const
+		{
+			return path;
+		}
+
+		int get_path_bases() const
+		{
+			return plength;
+		}
+
+		int get_path_start() const
+		{
+			return pstart;
+		}
+
+		int get_path_end() const
+		{
+			return pend;
+		}
+
 		int get_length() const
 		{
 			return qend - qstart;
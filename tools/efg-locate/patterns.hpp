@@ -0,0 +1,90 @@
+#ifndef PATTERNS_HPP
+#define PATTERNS_HPP
+
+#include <istream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+
+#include "efg-locate.hpp" // InputPattern
+#include "profile.hpp"
+#include "../common/trace.hpp"
+#include "../common/progress.hpp"
+
+/*
+ * reading of the patterns (FASTA) in windows, scheduled longest first on a
+ * WorkStealingScheduler of groups of patterns (see ../common/scheduler.hpp);
+ * used by the reader of efg-locate (algo.cpp) and by chainx-block-graph
+ * --seed-reads
+ */
+namespace efg_locate {
+
+/*
+ * schedule a window of patterns longest first: patterns are sorted by
+ * decreasing length and packed into tasks of at least taskbases bases,
+ * so that long patterns are tasks on their own and are started early
+ */
+template <class Scheduler>
+void schedule_longest_first(std::vector<InputPattern> &window, Scheduler &scheduler, const long taskbases)
+{
+	std::stable_sort(window.begin(), window.end(), [](const InputPattern &p1, const InputPattern &p2)
+			{
+			return p1.sequence.size() > p2.sequence.size();
+			});
+	std::vector<InputPattern> task;
+	long bases = 0;
+	for (InputPattern &p : window) {
+		bases += p.sequence.size();
+		task.push_back(std::move(p));
+		if (bases >= taskbases) {
+			PROFILE_ONLY(const auto waitstart = std::chrono::steady_clock::now());
+			scheduler.push(std::move(task), bases);
+			PROFILE_ADD(readerwaitns, profile_elapsed_ns(waitstart));
+			task = std::vector<InputPattern>();
+			bases = 0;
+		}
+	}
+	if (task.size() > 0) {
+		PROFILE_ONLY(const auto waitstart = std::chrono::steady_clock::now());
+		scheduler.push(std::move(task), bases);
+		PROFILE_ADD(readerwaitns, profile_elapsed_ns(waitstart));
+	}
+	window.clear();
+}
+
+/*
+ * read the patterns, numbered from 0, and pass each window of windowsize
+ * patterns (the last one possibly smaller or empty) to schedule(window)
+ */
+template <class Schedule>
+void read_pattern_windows(std::istream &patternsfs, const int windowsize, Schedule schedule)
+{
+	std::vector<InputPattern> window;
+	//TODO proper FASTA parsing
+	long seq = 0;
+	std::string patternid, pattern;
+	for (std::string line; getline(patternsfs, line);) {
+		progress.inputbytes.fetch_add(line.size() + 1, std::memory_order_relaxed);
+		if (line.size() >= 1 and line[0] == '>') {
+			if (pattern.size() > 0) {
+				window.push_back(InputPattern {seq++, patternid, std::move(pattern), (tracer.enabled) ? tracer.now_us() : -1});
+				if (window.size() >= windowsize)
+					schedule(window);
+				pattern.clear();
+			}
+			patternid = line.substr(1);
+		} else if (line.size() >= 1 and line[0] != '>') {
+			pattern += line;
+			progress.inputwork.fetch_add(line.size(), std::memory_order_relaxed);
+		}
+	}
+	if (pattern.size() > 0)
+		window.push_back(InputPattern {seq++, patternid, std::move(pattern), (tracer.enabled) ? tracer.now_us() : -1});
+	schedule(window);
+}
+
+} // Namespace efg_locate
+
+#endif
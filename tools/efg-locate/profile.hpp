@@ -0,0 +1,120 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+/*
+ * hot-path counters for --profile, compiled in only with -DEFG_LOCATE_PROFILE
+ * (make PROFILE=1): PROFILE_ADD and PROFILE_ONLY expand to nothing otherwise.
+ * Each thread counts in its own copy, registered on first use and summed at
+ * exit by profile_counters(), so no atomics are needed on the hot path
+ */
+#ifdef EFG_LOCATE_PROFILE
+#define PROFILE_ADD(counter, n) (efg_locate::profile_local().counter += (n))
+#define PROFILE_ONLY(code) code
+#else
+#define PROFILE_ADD(counter, n) ((void)0)
+#define PROFILE_ONLY(code)
+#endif
+
+namespace efg_locate {
+
+struct ProfileCounters {
+	unsigned long long lfstepsfirstsearch = 0; // backward steps on pattern chars in first_search
+	unsigned long long lfstepssimplesearch = 0; // backward steps on pattern chars in simple_search
+	unsigned long long separatorprobes = 0; // backward steps on the edge separator '#'
+	unsigned long long locateedge = 0; // locate_edge and locate_edge_and_position calls
+	unsigned long long connectingiterations = 0; // iterations of find_connecting_vertex over x
+	unsigned long long connectingcandidates = 0; // candidate connecting vertices tested
+	unsigned long long edgecountoccurrences = 0; // anchors emitted by output_edge_count_matches
+	unsigned long long greedyrestarts = 0; // calls of efg_backward_search_greedy
+	unsigned long long maxgreedyrestarts = 0; // max over the patterns
+	unsigned long long patterns = 0;
+	unsigned long long inputwaitns = 0; // compute threads waiting for tasks
+	unsigned long long outputwaitns = 0; // compute threads waiting for the output queue
+	unsigned long long readerwaitns = 0; // reader waiting for the scheduler or the reorder window
+};
+
+std::mutex profilemutex;
+std::vector<std::unique_ptr<ProfileCounters>> profileregistry; // owns the counters of all threads
+
+ProfileCounters &profile_local()
+{
+	thread_local ProfileCounters *local = nullptr;
+	if (local == nullptr) {
+		std::scoped_lock lck {profilemutex};
+		profileregistry.push_back(std::make_unique<ProfileCounters>());
+		local = profileregistry.back().get();
+	}
+	return *local;
+}
+
+unsigned long long inline profile_elapsed_ns(const std::chrono::steady_clock::time_point &start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+ProfileCounters profile_counters()
+{
+	std::scoped_lock lck {profilemutex};
+	ProfileCounters s;
+	for (const auto &c : profileregistry) {
+		s.lfstepsfirstsearch += c->lfstepsfirstsearch;
+		s.lfstepssimplesearch += c->lfstepssimplesearch;
+		s.separatorprobes += c->separatorprobes;
+		s.locateedge += c->locateedge;
+		s.connectingiterations += c->connectingiterations;
+		s.connectingcandidates += c->connectingcandidates;
+		s.edgecountoccurrences += c->edgecountoccurrences;
+		s.greedyrestarts += c->greedyrestarts;
+		s.maxgreedyrestarts = std::max(s.maxgreedyrestarts, c->maxgreedyrestarts);
+		s.patterns += c->patterns;
+		s.inputwaitns += c->inputwaitns;
+		s.outputwaitns += c->outputwaitns;
+		s.readerwaitns += c->readerwaitns;
+	}
+	return s;
+}
+
+// phases are (name, wall-clock seconds) in execution order
+void write_profile(std::ofstream &profilefs, const std::vector<std::pair<std::string,double>> &phases)
+{
+	profilefs << "{\n";
+	profilefs << "\t\"phases\": {";
+	for (int i = 0; i < phases.size(); i++)
+		profilefs << ((i == 0) ? "\n" : ",\n") << "\t\t\"" << phases[i].first << "\": " << phases[i].second;
+	profilefs << "\n\t},\n";
+#ifdef EFG_LOCATE_PROFILE
+	const ProfileCounters c = profile_counters();
+	profilefs << "\t\"counters\": {\n";
+	profilefs << "\t\t\"lf_steps_first_search\": " << c.lfstepsfirstsearch << ",\n";
+	profilefs << "\t\t\"lf_steps_simple_search\": " << c.lfstepssimplesearch << ",\n";
+	profilefs << "\t\t\"separator_probes\": " << c.separatorprobes << ",\n";
+	profilefs << "\t\t\"locate_edge_calls\": " << c.locateedge << ",\n";
+	profilefs << "\t\t\"find_connecting_vertex_iterations\": " << c.connectingiterations << ",\n";
+	profilefs << "\t\t\"find_connecting_vertex_candidates\": " << c.connectingcandidates << ",\n";
+	profilefs << "\t\t\"edge_count_occurrences\": " << c.edgecountoccurrences << ",\n";
+	profilefs << "\t\t\"patterns\": " << c.patterns << ",\n";
+	profilefs << "\t\t\"greedy_restarts\": " << c.greedyrestarts << ",\n";
+	profilefs << "\t\t\"greedy_restarts_per_pattern_avg\": " << ((c.patterns > 0) ? (double)c.greedyrestarts / c.patterns : 0) << ",\n";
+	profilefs << "\t\t\"greedy_restarts_per_pattern_max\": " << c.maxgreedyrestarts << ",\n";
+	profilefs << "\t\t\"input_queue_wait_s\": " << c.inputwaitns / 1e9 << ",\n";
+	profilefs << "\t\t\"output_queue_wait_s\": " << c.outputwaitns / 1e9 << ",\n";
+	profilefs << "\t\t\"reader_wait_s\": " << c.readerwaitns / 1e9 << "\n";
+	profilefs << "\t}\n";
+#else
+	profilefs << "\t\"counters\": null\n";
+#endif
+	profilefs << "}\n";
+}
+
+} // Namespace efg_locate
+
+#endif
@@ -0,0 +1,1130 @@
+#ifndef SEEDING_HPP
+#define SEEDING_HPP
+
+#include <vector>
+#include <iostream>
+#include <string>
+#include <sdsl/csa_wt.hpp>
+#include <sdsl/suffix_arrays.hpp>
+#include <syncstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+
+#include "efg-locate.hpp" // input parameters (Param)
+#include "efg.hpp"
+#include "profile.hpp"
+#include "budget.hpp"
+#include "../common/trace.hpp"
+
+//#define ALGO_DEBUG
+
+/*
+ * search of the patterns in the graph: exact matches (efg_backward_search)
+ * and semi-repeat-free seeds (approx_efg_backward_search), and their output in
+ * GAF format; used by the workers of efg-locate (algo.cpp) and by
+ * chainx-block-graph --seed-reads
+ */
+namespace efg_locate {
+
+using std::vector, std::cerr, std::endl, sdsl::backward_search, std::tie;
+typedef sdsl::csa_wt<>::size_type size_type;
+
+struct exactedgematch {
+	// compact description of substring Q[qstart..qend] (0-indexed) in graph edges
+	int qstart;
+	int qend;
+	// lex range [l..r] of efg index
+	size_type l;
+	size_type r;
+};
+
+// TODO: find a better place for these
+char complement(const char n)
+{
+	switch(n)
+	{   
+		case 'A':
+			return 'T';
+		case 'T':
+			return 'A';
+		case 'G':
+			return 'C';
+		case 'C':
+			return 'G';
+		case 'N':
+			return 'N';
+	}
+	return 'N';
+}
+string reverse_complement(const string &s)
+{
+	string reverse_pattern(s.size(),0);
+	for (int i = 0; i < s.size(); i++)
+		reverse_pattern[i] = complement(s[s.size()-1-i]);
+	return reverse_pattern;
+}
+
+/*
+ * update a vector v of exactedgematch with a new element. Replace the element
+ * of v of shortest length with the new element, if the new element is a
+ * longer substring of the pattern. Size of v is not changed.
+ */
+void update_longest_match(vector<exactedgematch> &v, int qstart, int qend, size_type l, size_type r)
+{
+	assert(v.size() > 0);
+	int minpos = 0;
+	int minqstart = v[0].qstart;
+	int minqend = v[0].qend;
+
+	for (int i = 1; i < v.size(); i++) {
+		if (v[i].qend - v[i].qstart < minqend - minqstart) {
+			minpos = i;
+			minqstart = v[i].qstart;
+			minqend = v[i].qend;
+		}
+	}
+
+	if (qend - qstart > minqend - minqstart) {
+#ifdef ALGO_DEBUG
+		cerr << "DEBUG: substituting longest match Q[" << v[minpos].qstart << ".." << v[minpos].qend << "] ([" << v[minpos].l << ".." << v[minpos].r << " with longer match Q[" << qstart << ".." << qend << "] ([" << l << ".." << r << "\n";
+#endif
+		v[minpos].qstart = qstart;
+		v[minpos].qend = qend;
+		v[minpos].l = l;
+		v[minpos].r = r;
+	}
+}
+
+/*
+ * find longest suffix pattern[f..q] of pattern[0..q] that is prefix of some
+ * edge label l(u)l(v). If f exists, then f_l and f_r are the lex range of
+ * pattern[f..q] in the edge index, otherwise f = -1. lastq_l lastq_r are the lex range of
+ * pattern[q'+1..q] where q' is the final state of q': pattern[q'+1..q] is
+ * longest suffix of pattern[0..q] that does not contain chars in ignorechars
+ * and occurs in some edge label
+ */
+void inline first_search(
+	const Elasticfoundergraph &efg,
+	const string &pattern,
+	int &q,
+	size_type &lastq_l,
+	size_type &lastq_r,
+	int &f,
+	size_type &f_l,
+	size_type &f_r,
+	const string &ignorechars = "")
+{
+	const csa_type &edge_index = efg.edge_index;
+	lastq_l = 0; // lex bounds in edge_index
+	lastq_r = edge_index.size() - 1;
+	size_type l_res, r_res; // temporary results
+
+	f = -1;
+	while (q >= 0 and ignorechars.find(pattern[q]) == std::string::npos) {
+		const int res = backward_search(edge_index, lastq_l, lastq_r, pattern[q], l_res, r_res);
+		PROFILE_ADD(lfstepsfirstsearch, 1);
+		budget_step();
+
+		if (res == 0) { // no match
+			break;
+		} else {
+			lastq_l = l_res;
+			lastq_r = r_res;
+			q -= 1;
+
+			// test if we can read the edge separator char '#' from [lastq_l..lastq_r]
+			PROFILE_ADD(separatorprobes, 1);
+			if (backward_search(edge_index, lastq_l, lastq_r, '#', l_res, r_res) != 0) {
+				f = q + 1;
+				f_l = lastq_l;
+				f_r = lastq_r;
+			}
+		}
+	}
+}
+/*
+ * version of the above first_search that additionally finds the shortest suffix
+ * pattern[qq..q] of pattern[0..q] occurring at most count times in the
+ * edge index. If such suffix exists, qq_l and qq_r correspond to the lex
+ * range of pattern[qq..q], otherwise qq = -1
+ */
+void inline first_search(
+	const Elasticfoundergraph &efg,
+	const string &pattern,
+	const int count,
+	int &q,
+	size_type &lastq_l,
+	size_type &lastq_r,
+	int &f,
+	size_type &f_l,
+	size_type &f_r,
+	int &qq,
+	size_type &qq_l,
+	size_type &qq_r,
+	const string &ignorechars = "")
+{
+	const csa_type &edge_index = efg.edge_index;
+	lastq_l = 0; // lex bounds in edge_index
+	lastq_r = edge_index.size() - 1;
+	size_type l_res, r_res; // temporary results
+
+	f = -1;
+	qq = -1;
+	while (q >= 0 and ignorechars.find(pattern[q]) == std::string::npos) {
+		const int res = backward_search(edge_index, lastq_l, lastq_r, pattern[q], l_res, r_res);
+		PROFILE_ADD(lfstepsfirstsearch, 1);
+		budget_step();
+
+		if (res == 0) { // no match
+			break;
+		} else {
+			lastq_l = l_res;
+			lastq_r = r_res;
+			q -= 1;
+
+			if (qq == -1 and lastq_l <= lastq_r and count >= 1 and lastq_r - lastq_l + 1 <= count) {
+				qq = q + 1;
+				qq_l = lastq_l;
+				qq_r = lastq_r;
+			}
+
+			// test if we can read the edge separator char '#' from [lastq_l..lastq_r]
+			PROFILE_ADD(separatorprobes, 1);
+			if (backward_search(edge_index, lastq_l, lastq_r, '#', l_res, r_res) != 0) {
+				f = q + 1;
+				f_l = lastq_l;
+				f_r = lastq_r;
+			}
+		}
+	}
+}
+
+/*
+ * find ONE match in iEFG efg of the longest suffix of pattern[0..q] that does
+ * not contain any char of ignorechars and that ends at a node boundary, i.e. it
+ * is a suffix of l(u_1)...l(u_k) with u_1, ... , u_k a path in efg. After the
+ * execution q holds value q' such that pattern[q'+1..q] is such suffix, path
+ * contains nodes u_1, ..., u_k-1, first_node_pos is such that
+ * u_1[first_node_pos..] is the matched part of u_1, y is such that
+ * pattern[y..q] corresponds to the matched part of u_k.
+ * If no such suffix exists, q' = q, y = -1, and first_node_pos = -1.
+ *
+ * Prerequisites:
+ * efg.init_pattern_matching_support() must have been called
+ *
+ * Completeness:
+ * to simplify edge cases, we assume that pattern[0..q] cannot occur in efg
+ * starting from a source of the graph by adding a supersource in efg with a
+ * dummy node label in init_pattern_matching_support() TODO
+ */
+void inline simple_search(
+	const Elasticfoundergraph &efg,
+	const string &pattern,
+	int &q,
+	vector<int> &path,
+	int &first_node_pos,
+	int &y,
+	int &u_k,
+	const string &ignorechars = "")
+{
+	const csa_type &edge_index = efg.edge_index;
+	const int startq = q;
+
+	path.clear(); // path will be filled in backwards (thus reverse) order
+	size_type lastq_l = 0; // lex bounds in edge_index
+	size_type lastq_r = edge_index.size() - 1;
+	size_type l_res, r_res; // temporary results
+	first_node_pos = -1;
+	y = -1;
+	int last_edge_boundary = -1;
+
+	backward_search(edge_index, 0, edge_index.size() - 1, '#', lastq_l, lastq_r);
+	PROFILE_ADD(separatorprobes, 1);
+	while (q >= 0 and ignorechars.find(pattern[q]) == std::string::npos) {
+		const int res = backward_search(edge_index, lastq_l, lastq_r, pattern[q], l_res, r_res);
+		PROFILE_ADD(lfstepssimplesearch, 1);
+		budget_step();
+		if (res == 0) {
+#ifdef ALGO_DEBUG
+			cerr << "DEBUG: simple search failed at index " << q << " and after collecting " << path.size() << "(+1) nodes\n";
+#endif
+			break;
+		}
+
+		lastq_l = l_res;
+		lastq_r = r_res;
+		q -= 1;
+
+		// test if we can read the edge separator char '#' from [lastq_l..lastq_r]
+		PROFILE_ADD(separatorprobes, 1);
+		if (backward_search(edge_index, lastq_l, lastq_r, '#', l_res, r_res) != 0) {
+			// full edge matched, first node is thus unique
+			int startnode, endnode;
+			tie(startnode, endnode) = efg.locate_edge(lastq_l);
+			PROFILE_ADD(locateedge, 1);
+#ifdef ALGO_DEBUG
+			cerr << "DEBUG: read full edge " << efg.get_label(startnode) << " -> " << efg.get_label(endnode) << "in pattern[" << q+1 << ".." << startq << "]\n";
+#endif
+
+			path.push_back(startnode);
+			last_edge_boundary = q + 1;
+			q += efg.get_label_length(startnode);
+			if (y == -1) {
+				u_k = endnode;
+				y = q + 1;
+			}
+			backward_search(edge_index, 0, edge_index.size() - 1, '#', lastq_l, lastq_r);
+			PROFILE_ADD(separatorprobes, 1);
+		}
+	}
+
+	if (q == startq) {
+		// no suffix of pattern[0..q] ends at some node label l(u)
+		assert(y == -1);
+		assert(first_node_pos == -1);
+		return;
+	}
+
+	if (path.size() == 0) {
+		// no full edge was identified
+		int startnode, endnode, position;
+		tie(startnode, endnode, position) = efg.locate_edge_and_position(lastq_l);
+		PROFILE_ADD(locateedge, 1);
+
+		if (position < efg.get_label_length(startnode)) {
+			// full node endnode was matched
+			y = q + 1 + efg.get_label_length(startnode) - position;
+			path.push_back(startnode);
+			u_k = endnode;
+			first_node_pos = position;
+		} else {
+			// no full node was matched
+			y = q + 1;
+		}
+	} else if (q + 1 < last_edge_boundary) { // path.size() > 0
+		// some full edges were identified, and pattern[q+1..qstart] starts with a suffix of l(u_1)
+		int startnode, endnode, position;
+		tie(startnode, endnode, position) = efg.locate_edge_and_position(lastq_l);
+		PROFILE_ADD(locateedge, 1);
+
+		assert(path.back() == endnode);
+		path.push_back(startnode);
+		first_node_pos = position;
+	} else { // path.size() > 0 and q + 1 >= last_edge_boundary
+		// pattern[q+1..qstart] starts with a full edge
+		first_node_pos = 0;
+		assert(q + 1 == last_edge_boundary);
+	}
+
+	std::reverse(path.begin(), path.end());
+}
+
+/*
+ * find ONE connecting vertex v such that l(v) = pattern[f..x] is a proper prefix of pattern[f..qstart]
+ * and suffix of pattern[y..x]; if one such vertex exists, append the resulting nodes u v w to path and store in first_node_pos the matched part of l(u), and return value 1; otherwise return value 0 and first_node_pos contains an undefined value
+ *
+ * Prerequisites:
+ * efg.init_pattern_matching_support() must have been called
+ *
+ * Completeness:
+ * to simplify edge cases, we assume that pattern[0..q] cannot occur in efg
+ * starting from a source of the graph by adding a supersource in efg with a
+ * dummy node label in init_pattern_matching_support()
+ */
+int inline find_connecting_vertex(
+	const Elasticfoundergraph &efg,
+	const string &pattern,
+	const int y,
+	const int f,
+	const int f_l,
+	const int f_r,
+	const int qstart,
+	vector<int> &path,
+	int &first_node_pos)
+{
+	const csa_type &edge_index = efg.edge_index;
+
+	std::unordered_set<int> middle_block;
+	std::unordered_map<int,int> middle_edges; // just one candidate last edge
+
+	int q = qstart;
+	size_type l = 0; // lex bounds in edge_index
+	size_type r = edge_index.size() - 1;
+	size_type l_res, r_res; // temporary results
+
+	// if it is a semi-repeat-free match, all occurrences of pattern[f..qstart] must be prefix of some l(u)l(v)
+	// TODO is this correct for sources?
+	backward_search(edge_index, f_l, f_r, '#', l_res, r_res);
+	PROFILE_ADD(separatorprobes, 1);
+	if (f_r - f_l != r_res - l_res)
+		return 0;
+
+	for (int x = f; x < qstart; x++) {
+		// out of budget, give up as if there was no connecting vertex
+		if (budget_exhausted())
+			return 0;
+		PROFILE_ADD(connectingiterations, 1);
+		// 1. check if pattern[y..x] is suffix of some l(u)l(v)
+		backward_search(edge_index, 0, edge_index.size() - 1, '#', l, r);
+		PROFILE_ADD(separatorprobes, 1);
+		q = x;
+		while (q >= y and backward_search(edge_index, l, r, pattern[q], l_res, r_res) != 0) {
+			l = l_res;
+			r = r_res;
+			q -= 1;
+		}
+		budget_step(x - q + 1);
+		if (q != y - 1) // l(v) is not suffix of l(u)l(v) = pattern[y..x]
+			continue;
+
+		// 2. check if pattern[f..x] contains a full node label
+		/*backward_search(edge_index, 0, edge_index.size() - 1, '#', l, r);
+		q = x;
+		while (q >= f and backward_search(edge_index, l, r, pattern[q], l_res, r_res) != 0) {
+			l = l_res;
+			r = r_res;
+			q -= 1;
+		}
+		if (q != f - 1) // cannot be node full label
+			continue;*/
+
+		int startnode, endnode, position;
+		tie(startnode, endnode, position) = efg.locate_edge_and_position(l);
+		PROFILE_ADD(locateedge, 1);
+		if (f - y != efg.get_label_length(startnode) - position) // pattern[f..x] is not full node label
+			continue;
+		const int v = endnode;
+		PROFILE_ADD(connectingcandidates, 1);
+#ifdef ALGO_DEBUG
+		cerr << "DEBUG: found candidate node " << efg.get_id(v) << "(pattern[" << y << ".." << x << "] as connecting vertex, testing\n";
+#endif
+
+		if (middle_block.size() == 0) {
+			// find all nodes l(vv) such that l(vv) is prefix of pattern[f..qstart] (<= H^2)
+			l = f_l;
+			r = f_r;
+			for (size_type k = l; k <= r; k++) {
+				int snode, enode;
+				tie(snode, enode) = efg.locate_edge(k);
+				PROFILE_ADD(locateedge, 1);
+
+				middle_block.insert(snode);
+				if (snode == v and f + efg.get_label_length(v) - 1 < qstart) { // TODO investigate
+					// connecting vertex is v
+					path.push_back(startnode); // u
+					first_node_pos = position;
+					path.push_back(v);
+					assert(f + efg.get_label_length(v) - 1 < qstart); // this edge case should not be possible
+					path.push_back(enode); // w
+					return 1;
+				}
+
+				if (!middle_edges.contains(snode)) {
+					middle_edges[snode] = enode;
+				}
+			}
+		} else if (middle_block.contains(v)) {
+			path.push_back(startnode);
+			first_node_pos = position;
+			path.push_back(v);
+			assert(f + efg.get_label_length(v) - 1 < qstart); // this edge case should not be possible
+			path.push_back(middle_edges[v]);
+			return 1;
+		}
+	}
+
+	// no connecting vertex
+	return 0;
+}
+
+void inline output_edge_count_matches(const Elasticfoundergraph &efg, const string &pattern, const string &pattern_id, const int qq, const int startq, const int qq_l, const int qq_r, vector<GAFAnchor> &match)
+{
+		// output all edge-count matches
+		for (int i = qq_l; i <= qq_r; i++) {
+			int startnode, endnode, position;
+			tie(startnode, endnode, position) = efg.locate_edge_and_position(i);
+			PROFILE_ADD(locateedge, 1);
+			PROFILE_ADD(edgecountoccurrences, 1);
+
+			match.push_back(GAFAnchor(
+						efg,
+						pattern_id,
+						pattern.size(),
+						qq,
+						startq+1,
+						std::vector({startnode,endnode}),
+						efg.get_label_length(startnode) + efg.get_label_length(endnode),
+						position,
+						position + (startq+1-qq)));
+			//assert(match.back().check(efg, pattern)); // TODO implement faster sanity check
+		}
+}
+
+
+/*
+ * Find ONE occurrence of pattern in iEFG efg. If successful, return value is
+ * >0 and matches contains at least one GAFAnchor match
+ *
+ * Prerequisites:
+ * efg.init_pattern_matching_support() must have been called
+ *
+ * Note: 
+ * The implementation follow a "simplified" version of the algorithms in
+ * https://doi.org/10.1016/j.tcs.2023.114269 working in
+ * O(|Q| + min(|Q|,L)^2 + H^2) time, where L is the maximum node label
+ * length and H is the maximum block height of the graph. 
+ */
+int efg_backward_search(const Elasticfoundergraph &efg, const string &pattern_id, const string &pattern, Params &params, vector<GAFAnchor> &matches, const string &ignorechars = "")
+{
+	TraceSpan span("exact search");
+	matches.clear();
+	vector<int> path;
+	int q = pattern.size() - 1, f;
+	size_type lastq_l, lastq_r, f_l, f_r;
+
+	// find largest suffix pattern[f..q] of pattern[..q] that is prefix of some edge label l(u)l(v)
+	first_search(efg, pattern, q, lastq_l, lastq_r, f, f_l, f_r, ignorechars);
+
+	// case 1a: pattern occurs in some edge label l(u)l(v)
+	if (q == -1) {
+		// pick arbitrary occurrence
+		output_edge_count_matches(efg, pattern, pattern_id, 0, pattern.size()-1, lastq_l, lastq_r, matches);
+		return 1;
+	}
+
+	// case 1b: pattern does not occur in some edge and f is not well-defined
+	if (f == -1)
+		return 0;
+
+#ifdef ALGO_DEBUG
+	cerr << "DEBUG: pattern[f..] is pattern[" << f << "..]" << endl;
+#endif
+
+	int first_node_pos, y, u_k;
+	q = f - 1;
+	simple_search(efg, pattern, q, path, first_node_pos, y, u_k, ignorechars);
+
+	// case 2a: no match of pattern[0..f-1] in efg ending at node boundary
+	if (q != -1)
+		return 0;
+
+#ifdef ALGO_DEBUG
+	cerr << "DEBUG: simple_search matched pattern[" << q+1 << ".." << f - 1 << "] and found nodes ";
+	for (auto n : path) {
+		cerr << efg.get_id(n) << ",";
+	}
+	cerr << ", first_node_pos is " << first_node_pos << ", y is " << y << "\n";
+#endif
+
+	if (path.size() == 0) {
+		// case 3a: pattern occurs in efg spanning 3 nodes
+		if (find_connecting_vertex(efg, pattern, y, f, f_l, f_r, pattern.size()-1, path, first_node_pos) > 0) {
+			assert(first_node_pos >= 0);
+			int pathlength = 0;
+			for (int i : path)
+				pathlength += efg.get_label_length(i);
+			matches.push_back(GAFAnchor(
+						pattern_id,
+						pattern.size(),
+						0,
+						pattern.size(),
+						path,
+						pathlength,
+						first_node_pos,
+						first_node_pos + (pattern.size()-(q+1))));
+			//assert(match.back().check(efg, pattern));
+			return 1;
+		}
+	} else {
+		// case 3b: pattern occurs in efg spanning 3 nodes
+		int u_node_pos;
+		if (find_connecting_vertex(efg, pattern, y, f, f_l, f_r, pattern.size()-1, path, u_node_pos) > 0) {
+			assert(u_node_pos == 0);
+			assert(first_node_pos >= 0);
+			int pathlength = 0;
+			for (int i : path)
+				pathlength += efg.get_label_length(i);
+
+			matches.push_back(GAFAnchor(
+						pattern_id,
+						pattern.size(),
+						0,
+						pattern.size(),
+						path,
+						pathlength,
+						first_node_pos,
+						first_node_pos + (pattern.size()-(q+1))));
+			//assert(match.back().check(efg, pattern));
+			return 1;
+		}
+	}
+	// case 3c: no connecting vertex
+	return 0;
+}
+
+/*
+ * copy of efg_backward_search that matches pattern[0..q] until failure, saves result in a GAFAnchor, and updates q such that pattern[0..q] is the rest of the pattern that was not matched
+ */
+int efg_backward_search_greedy(const Elasticfoundergraph &efg, const string &pattern_id, const string &pattern, const int edgemincount, const int edgelongestcount, int &q, vector<GAFAnchor> &match, vector<exactedgematch> &longest, const string &ignorechars = "")
+{
+	const int startq = q;
+	int f, qq;
+	size_type lastq_l, lastq_r, f_l, f_r, qq_l, qq_r;
+	PROFILE_ADD(greedyrestarts, 1);
+
+	// find largest suffix pattern[f..q] of pattern[..q] that is prefix of some edge label l(u)l(v)
+	first_search(efg, pattern, edgemincount, q, lastq_l, lastq_r, f, f_l, f_r, qq, qq_l, qq_r, ignorechars);
+
+	// case 1a: the whole pattern occurs in some edge label l(u)l(v)
+	if (q == -1) {
+		if (qq == -1) { // prioritize edgemincount matches to avoid duplicates, TODO check
+			// policy 1: do nothing
+			// policy 2: f
+			//q = std::max(q, f - 1);
+			if (edgelongestcount > 0)
+				update_longest_match(longest, q+1, startq, lastq_l, lastq_r);
+			return 0;
+		} else {
+			output_edge_count_matches(efg, pattern, pattern_id, qq, startq, qq_l, qq_r, match);
+			// fake updating the longest match to avoid overlaps/duplicates
+			if (edgelongestcount > 0)
+				update_longest_match(longest, q+1, startq, 0, 0);
+			// policy 1: do nothing
+			// policy 2: f
+			//q = std::max(q, f - 1);
+			return 1;
+		}
+	}
+
+	// case 1b: pattern does not occur in some edge and f is not well-defined
+	if (f == -1) {
+		if (q == startq)
+			q -= 1;
+		if (qq == -1) { // not a semi-repeat-free (probably) or edge-count match
+			// policy 1: do nothing
+			// policy 2: f, do nothing in this case
+			return 0;
+		} else {
+			//std::cerr << "case 1b and after is " << q;
+			output_edge_count_matches(efg, pattern, pattern_id, qq, startq, qq_l, qq_r, match);
+			// fake updating the longest match to avoid overlaps/duplicates
+			if (edgelongestcount > 0)
+				update_longest_match(longest, q+1, startq, 0, 0);
+			// policy 1: do nothing
+			// policy 2: f, do nothing in this case
+			return 1;
+		}
+	}
+
+	const int first_search_q = q;
+
+	int first_node_pos, y, u_k;
+	vector<int> path;
+	q = f - 1;
+	simple_search(efg, pattern, q, path, first_node_pos, y, u_k, ignorechars);
+
+	// case 2a: no suffix of pattern[0..f-1] is a suffix of some edge label l(u)l(v)
+	if (q == f - 1) {
+		if (qq == -1) { // not a semi-repeat-free (probably) or edge-count match
+			// policy 1: do nothing
+			// policy 2: f
+			//q = std::max(q, f - 1);
+			if (edgelongestcount > 0)
+				update_longest_match(longest, first_search_q+1, startq, lastq_l, lastq_r);
+			return 0;
+		} else {
+			output_edge_count_matches(efg, pattern, pattern_id, qq, startq, qq_l, qq_r, match);
+			// fake updating the longest match to avoid overlaps/duplicates
+			if (edgelongestcount > 0)
+				update_longest_match(longest, q+1, startq, 0, 0);
+			// policy 1: we consumed pattern[qq..]
+			q = std::min(q, qq);
+			// policy 2: f
+			//q = std::max(q, f - 1);
+			return 1;
+		}
+	}
+
+#ifdef ALGO_DEBUG
+	cerr << "DEBUG: simple_search matched pattern[" << q+1 << ".." << f - 1 << "] and found nodes ";
+	for (auto n : path) {
+		cerr << efg.get_id(n) << ",";
+	}
+	cerr << ", first_node_pos is " << first_node_pos << ", y is " << y << "\n";
+#endif
+
+	if (path.size() == 0 and find_connecting_vertex(efg, pattern, y, f, f_l, f_r, startq, path, first_node_pos) > 0) {
+		assert(first_node_pos >= 0);
+		int pathlength = 0;
+		for (int i : path)
+			pathlength += efg.get_label_length(i);
+		match.push_back(GAFAnchor(
+					pattern_id,
+					pattern.size(),
+					q+1,
+					startq+1,
+					path,
+					pathlength,
+					first_node_pos,
+					first_node_pos + (startq+1-(q+1))));
+		//assert(match.back().check(efg, pattern));
+		return 1;
+	} else {
+		int u_node_pos;
+		if (find_connecting_vertex(efg, pattern, y, f, f_l, f_r, startq, path, u_node_pos) > 0) {
+			assert(u_node_pos == 0);
+			assert(first_node_pos >= 0);
+			int pathlength = 0;
+			for (int i : path)
+				pathlength += efg.get_label_length(i);
+
+			match.push_back(GAFAnchor(
+						pattern_id,
+						pattern.size(),
+						q+1,
+						startq+1,
+						path,
+						pathlength,
+						first_node_pos,
+						first_node_pos + (startq+1-(q+1))));
+			//assert(match.back().check(efg, pattern));
+			return 1;
+		}
+	}
+
+	if (path.size() > 0) {
+		// lucky full node match in simple_search
+		path.push_back(u_k);
+		int pathlength = 0;
+		for (int i : path)
+			pathlength += efg.get_label_length(i);
+		match.push_back(GAFAnchor(
+					pattern_id,
+					pattern.size(),
+					q+1,
+					f,
+					path,
+					pathlength,
+					first_node_pos,
+					first_node_pos + (f-(q+1))));
+		//assert(match.back().check(efg, pattern));
+		return 1;
+	}
+
+	// no semi-repeat-free match was found
+	if (qq == -1) { // not a semi-repeat-free (probably) or edge-count match
+		// policy 1: do nothing
+		// policy 2: f
+		//q = std::max(q, f - 1);
+		if (edgelongestcount > 0)
+			update_longest_match(longest, first_search_q+1, startq, lastq_l, lastq_r);
+		return 0;
+	} else {
+		output_edge_count_matches(efg, pattern, pattern_id, qq, startq, qq_l, qq_r, match);
+		// fake updating the longest match to avoid overlaps/duplicates
+		if (edgelongestcount > 0)
+			update_longest_match(longest, q+1, startq, 0, 0);
+		// policy 1: we consumed pattern[qq..]
+		q = std::min(q, qq);
+		// policy 2: f
+		//q = std::max(q, f - 1);
+		return 1;
+	}
+}
+
+// one call of efg_backward_search_greedy from startq, with its results
+struct greedystep {
+	int startq;
+	int endq; // q after the call
+	int res;
+	vector<GAFAnchor> match;
+	exactedgematch longest; // candidate for the longest edge matches, if any
+};
+
+greedystep greedy_step(const Elasticfoundergraph &efg, const string &pattern_id, const string &pattern, const Params &params, int q)
+{
+	greedystep step;
+	step.startq = q;
+	// starting from empty longest matches, the (at most one) candidate of
+	// the call ends up in the first one
+	vector<exactedgematch> longest(params.edgelongestcount, exactedgematch({0, 0, 0, 0}));
+	step.res = efg_backward_search_greedy(efg, pattern_id, pattern, params.edgemincount, params.edgelongestcount, q, step.match, longest, params.ignorechars);
+	step.endq = q;
+	step.longest = (longest.size() > 0) ? longest[0] : exactedgematch({0, 0, 0, 0});
+	return step;
+}
+
+/*
+ * helper threads of windowed_greedy_search, started once and shared by all
+ * the compute threads: a compute thread seeding a long pattern posts the
+ * shares of its windows as a batch and seeds shares itself until none is
+ * left, while idle helpers take the others. Without helpers (or when they
+ * are all busy) the compute thread seeds all its windows, so the number of
+ * seeding threads never exceeds the compute threads plus the helpers.
+ */
+class WindowPool {
+	private:
+		struct Batch {
+			std::function<void(int)> seed; // seeds share i
+			int shares;
+			std::atomic<int> next = 0; // first share not taken yet
+			int helpers = 0; // helpers working on the batch
+		};
+		std::mutex mut;
+		std::condition_variable posted, finished;
+		std::deque<Batch*> batches;
+		vector<std::thread> helpers;
+		bool stopping = false;
+
+		static void take_shares(Batch &b)
+		{
+			for (int i = b.next++; i < b.shares; i = b.next++)
+				b.seed(i);
+		}
+
+		void help()
+		{
+			std::unique_lock lck {mut};
+			while (true) {
+				posted.wait(lck, [this]() { return stopping or batches.size() > 0; });
+				if (stopping)
+					return;
+				Batch *b = batches.front();
+				b->helpers += 1;
+				lck.unlock();
+				take_shares(*b);
+				lck.lock();
+				// all the shares are taken, no other helper starts on it
+				if (batches.size() > 0 and batches.front() == b)
+					batches.pop_front();
+				b->helpers -= 1;
+				finished.notify_all();
+			}
+		}
+
+	public:
+		~WindowPool() { stop(); }
+
+		void start(int n)
+		{
+			stop();
+			stopping = false;
+			for (int i = 0; i < n; i++)
+				helpers.push_back(std::thread(&WindowPool::help, this));
+		}
+
+		void stop()
+		{
+			{
+				std::scoped_lock lck {mut};
+				stopping = true;
+			}
+			posted.notify_all();
+			for (std::thread &t : helpers)
+				t.join();
+			helpers.clear();
+		}
+
+		int size() const { return helpers.size(); }
+
+		// calls seed(0), ..., seed(shares - 1) and returns when all are done
+		void run(int shares, const std::function<void(int)> &seed)
+		{
+			Batch b;
+			b.seed = seed;
+			b.shares = shares;
+			if (helpers.size() > 0 and shares > 1) {
+				std::scoped_lock lck {mut};
+				batches.push_back(&b);
+			}
+			posted.notify_all();
+			take_shares(b);
+			std::unique_lock lck {mut};
+			auto it = std::find(batches.begin(), batches.end(), &b);
+			if (it != batches.end())
+				batches.erase(it);
+			finished.wait(lck, [&b]() { return b.helpers == 0; });
+		}
+};
+
+WindowPool windowpool;
+
+/*
+ * intra-read parallel version of the greedy loop of approx_efg_backward_search
+ * for long patterns: the pattern is split into windows of
+ * params.windowlength bases, and each window [a..b) is seeded on its own
+ * (on the calling thread or on a helper of windowpool) starting from
+ * b + params.windowoverlap - 1, so that its greedy
+ * restarts synchronize with the sequential ones in the overlap. The windows
+ * are then stitched from the end of the pattern by following the sequential
+ * restarts: a step of a window is adopted only if it starts where the
+ * sequential loop would restart, and the steps before synchronization are
+ * recomputed, so the anchors in the overlaps are deduplicated and the result
+ * is the same as the sequential loop. Returns the coverage.
+ */
+long windowed_greedy_search(const Elasticfoundergraph &efg, const string &pattern_id, const string &pattern, const Params &params, vector<GAFAnchor> &matches, vector<exactedgematch> &longest_matches)
+{
+	const int n = pattern.size();
+	const int windows = (n + params.windowlength - 1) / params.windowlength;
+	vector<vector<greedystep>> steps(windows);
+
+	auto seed_window = [&](int k) {
+		const int a = k * params.windowlength;
+		const int b = std::min(n, (k + 1) * params.windowlength);
+		int q = std::min(n, b + params.windowoverlap) - 1;
+		while (q >= a and !budget_exhausted()) {
+			steps[k].push_back(greedy_step(efg, pattern_id, pattern, params, q));
+			q = steps[k].back().endq;
+		}
+	};
+	// the windows are split into shares, which share the remaining budget of
+	// the read whichever thread seeds them
+	const int shares = std::min(windows, params.windowthreads);
+	const ReadBudget parentbudget = readbudget;
+	vector<ReadBudget> sharebudgets(shares);
+	windowpool.run(shares, [&seed_window, &parentbudget, &sharebudgets, shares, windows](int t) {
+		budget_read_share(parentbudget, shares);
+		for (int k = t; k < windows; k += shares)
+			seed_window(k);
+		sharebudgets[t] = readbudget;
+	});
+	readbudget = parentbudget;
+	for (const ReadBudget &b : sharebudgets)
+		budget_read_join(b);
+
+	long coverage = 0;
+	int q = n - 1;
+	for (int k = windows - 1; k >= 0; k--) {
+		const int a = k * params.windowlength;
+		int i = 0;
+		while (q >= a) {
+			while (i < steps[k].size() and steps[k][i].startq > q)
+				i++;
+			if (budget_exhausted() and (i == steps[k].size() or steps[k][i].startq != q)) {
+				// out of budget, skip to the next step of the window instead of recomputing
+				q = (i < steps[k].size()) ? steps[k][i].startq : a - 1;
+				continue;
+			}
+			greedystep recomputed;
+			const greedystep &step = (i < steps[k].size() and steps[k][i].startq == q) ?
+				steps[k][i] : (recomputed = greedy_step(efg, pattern_id, pattern, params, q));
+			if (step.res > 0) {
+				coverage += step.startq - step.endq;
+				for (auto &m : step.match)
+					matches.push_back(m);
+			}
+			if (params.edgelongestcount > 0 and step.longest.qend - step.longest.qstart > 0)
+				update_longest_match(longest_matches, step.longest.qstart, step.longest.qend, step.longest.l, step.longest.r);
+			q = step.endq;
+		}
+	}
+	return coverage;
+}
+
+// patterns seeded with windowed_greedy_search
+bool inline windowed_seeding(const Params &params, const string &pattern)
+{
+	return params.windowlength > 0 and params.windowthreads > 1 and params.ignorechars == "" and
+		pattern.size() >= 2 * (long)params.windowlength;
+}
+
+int approx_efg_backward_search(const Elasticfoundergraph &efg, const string &pattern_id, const string &pattern, Params &params, vector<GAFAnchor> &matches)
+{
+	//TODO: skip coverage computation if not needed?
+	long coverage = 0, rev_coverage = 0, full_node_matches = 0, rev_full_node_matches = 0;
+
+#ifdef ALGO_DEBUG
+	cerr << "Searching pattern " << pattern << endl;
+#endif
+	vector<exactedgematch> longest_matches;
+	longest_matches.reserve(params.edgelongestcount+1);
+	for (int i = 0; i < params.edgelongestcount; i++)
+		longest_matches.push_back(exactedgematch({0, 0, 0, 0}));
+
+	matches.clear();
+	int q = pattern.size() - 1;
+	TraceSpan seedingspan("seeding forward");
+	if (windowed_seeding(params, pattern)) {
+		coverage += windowed_greedy_search(efg, pattern_id, pattern, params, matches, longest_matches);
+	} else {
+		while (q >= 0) {
+			while (params.ignorechars.find(pattern[q]) != std::string::npos)
+				q--;
+			if (q < 0 or budget_exhausted())
+				break;
+
+			int startq = q;
+			vector<GAFAnchor> match;
+	#ifdef ALGO_DEBUG
+			cerr << "q before greedy search is " << q << endl;
+	#endif
+			int res = efg_backward_search_greedy(efg, pattern_id, pattern, params.edgemincount, params.edgelongestcount, q, match, longest_matches, params.ignorechars);
+	#ifdef ALGO_DEBUG
+			cerr << "q after greedy search is " << q << endl;
+	#endif
+			if (res > 0) {
+				coverage += startq - q;
+				for (auto &m : match)
+					matches.push_back(m);
+			}
+		}
+	}
+	seedingspan.end();
+	if (params.edgelongestcount > 0) {
+		TraceSpan edgecountspan("edge-count output");
+		for (exactedgematch &m : longest_matches) {
+			if ((m.l != 0 or m.r != 0) and (m.r - m.l <= params.edgelongestcountmax)) {
+				coverage += m.qend - m.qstart + 1;
+				output_edge_count_matches(efg, pattern, pattern_id, m.qstart, m.qend, m.l, m.r, matches);
+			}
+		}
+	}
+
+	vector<GAFAnchor> reversecompl_matches;
+	assert(longest_matches.size() == params.edgelongestcount);
+	for (int i = 0; i < params.edgelongestcount; i++)
+		longest_matches[i] = exactedgematch({0, 0, 0, 0});
+	if (params.reversecompl) {
+		string reverse_pattern(pattern.size(),0);
+		const string pattern_id_rev = ((params.renamereversecomplement) ? "rev_" + pattern_id : pattern_id);
+#ifdef ALGO_DEBUG
+		cerr << "Searching reverse complement pattern " << reverse_pattern << endl;
+#endif
+		for (int i = 0; i < pattern.size(); i++)
+			reverse_pattern[i] = complement(pattern[pattern.size()-1-i]);
+		q = pattern.size() - 1;
+		TraceSpan revseedingspan("seeding reverse");
+		if (windowed_seeding(params, pattern)) {
+			vector<GAFAnchor> match;
+			rev_coverage += windowed_greedy_search(efg, pattern_id_rev, reverse_pattern, params, match, longest_matches);
+			for (auto &m : match) {
+				if (!params.renamereversecomplement)
+					m.reverse();
+				reversecompl_matches.push_back(m);
+			}
+		} else {
+			while (q >= 0) {
+				while (params.ignorechars.find(pattern[q]) != std::string::npos)
+					q--;
+				if (q < 0 or budget_exhausted())
+					break;
+				int startq = q;
+				vector<GAFAnchor> match;
+				int res = efg_backward_search_greedy(efg, pattern_id_rev, reverse_pattern, params.edgemincount, params.edgelongestcount, q, match, longest_matches, params.ignorechars);
+				if (res > 0) {
+					rev_coverage += startq - q;
+					for (auto &m : match) {
+						if (!params.renamereversecomplement)
+							m.reverse();
+						reversecompl_matches.push_back(m);
+					}
+				}
+			}
+		}
+		revseedingspan.end();
+		if (params.edgelongestcount > 0) {
+			TraceSpan edgecountspan("edge-count output reverse");
+			for (exactedgematch &m : longest_matches) {
+				if ((m.l != 0 or m.r != 0) and (m.r - m.l <= params.edgelongestcountmax)) {
+					vector<GAFAnchor> match;
+					output_edge_count_matches(efg, reverse_pattern, pattern_id_rev, m.qstart, m.qend, m.l, m.r, match);
+					rev_coverage += m.qend - m.qstart + 1;
+					for (auto &m : match) {
+						if (!params.renamereversecomplement)
+							m.reverse();
+						reversecompl_matches.push_back(m);
+					}
+				}
+			}
+		}
+	}
+
+	for (auto m : matches) {
+		full_node_matches += std::max(0, m.get_path_length() - 2); // probably correct
+	}
+	for (auto m : reversecompl_matches) {
+		rev_full_node_matches += std::max(0, m.get_path_length() - 2); // probably correct
+	}
+	if (params.reportstats) {
+		std::osyncstream oss(std::cout);
+		oss << pattern_id << "\t"; // pattern name
+		oss << pattern.size() << "\t"; // length
+		oss << matches.size() << "\t"; // number of matches
+		oss << ((long)coverage*100)/pattern.size() << "\t"; // coverage %
+		oss << ((long)rev_coverage*100)/pattern.size() << "\t"; // reverse coverage %
+		oss << full_node_matches << "\t"; // lower bound on full node matches
+		oss << rev_full_node_matches << "\t"; // lower bound on full reverse node matches
+		oss << "\n";
+	}
+
+	if ((matches.size() == 0 and reversecompl_matches.size() == 0) or 
+			(((long)coverage*100)/pattern.size() < params.mincoverage) && (((long)rev_coverage*100)/pattern.size() < params.mincoverage))
+		return 0;
+	// DO NOT TRUST EXACT MATCHES THAT MUCH
+	/*if (((long)coverage*100)/pattern.size() < mincoverage)
+		matches.clear();
+	if (((long)rev_coverage*100)/pattern.size() >= mincoverage)*/
+	std::reverse(matches.begin(), matches.end()); // to have forward (and reverse) matches sorted
+	if (params.renamereversecomplement)
+		std::reverse(reversecompl_matches.begin(), reversecompl_matches.end());
+	matches.insert(matches.end(), reversecompl_matches.begin(), reversecompl_matches.end());
+
+	reversecompl_matches.clear();
+
+	return 1;
+}
+
+int approx_efg_backward_search_ignorechars(const Elasticfoundergraph &efg, const string &ignorechars, const string &pattern_id, Params &params, const string &pattern, vector<GAFAnchor> &matches)
+{
+	matches.clear();
+	vector<string> maximal_substrings;
+	int startq = 0;
+	for (int q = 0; q < pattern.size(); q++) {
+		if (ignorechars.find(pattern[q]) != std::string::npos) {
+			// search for current pattern without special characters, if any
+			if (startq < q - 1) {
+				maximal_substrings.push_back(pattern.substr(startq, q - startq));
+			}
+			startq = q + 1;
+		}
+	}
+	if (startq < pattern.size()) {
+		maximal_substrings.push_back(pattern.substr(startq));
+	}
+
+	for (int s = 0; s < maximal_substrings.size(); s++) {
+		vector<GAFAnchor> substring_matches;
+		int res = approx_efg_backward_search(efg, pattern_id + "-" + std::to_string(s), maximal_substrings[s], params, substring_matches);
+		//TODO: more efficient move?
+		if (res > 0)
+			matches.insert(matches.end(), substring_matches.begin(), substring_matches.end());
+	}
+
+	if (matches.size() > 0)
+		return 1;
+	else
+		return 0;
+}
+
+// output matches in the format selected by the split options
+// TODO check reverse compl policy of the split output
+void format_matches(std::ostream *out, const Elasticfoundergraph &graph, vector<GAFAnchor> &matches, const Params &params)
+{
+	TraceSpan span("format");
+	if (params.splitoutputmatches)
+		anchors_to_stream_split_single(out, graph, matches, params.splitkeepedgematches);
+	else if (params.splitoutputmatchesgraphaligner)
+		anchors_to_stream_split_single_graphaligner(out, graph, matches, params.splitkeepedgematches);
+	else
+		anchors_to_stream(out, graph, matches);
+}
+
+} // Namespace efg_locate
+
+#endif
@@ -53,3 +53,85 @@ do
 		exit 1
 	fi
 done
+
+# windowed seeding of the approximate patterns, the same as sequential seeding,
+# also with an overlap shorter than the seeds
+graph=$thisfolder/inputs/tcs_fig_5.gfa
+patterns=$thisfolder/inputs/tcs_fig_5_approximate.fasta
+correct=$thisfolder/outputs/tcs_fig_5_approximate.fasta
+for window in "--approximate-window-length 5 --approximate-window-overlap 1" \
+	"--approximate-window-length 10 --approximate-window-overlap 2" \
+	"--approximate-window-length 20"
+do
+	for threads in "" "--threads 2"
+	do
+		output=$outputfolder/tcs_fig_5_approximate-windows.gaf
+		rm -f $output
+		echo "$efglocate --approximate $window $threads $graph $patterns $output" >> $logfile
+		$efglocate --approximate $window $threads $graph $patterns $output >> $logfile 2>> $logfile
+		diff $output $correct > /dev/null 2>/dev/null
+
+		exitcode=$? ; if [ $exitcode -ne 0 ] ; then
+			echo "Test failed for files $graph $patterns $correct with $window $threads!" | tee -a $logfile
+			exit 1
+		fi
+	done
+done
+
+# patterns of several lengths cut from tcs_fig_5_approximate.fasta, which the
+# compute threads schedule longest first
+pattern=$(sed -n 2p $thisfolder/inputs/tcs_fig_5_approximate.fasta)
+manypatterns=$outputfolder/tcs_fig_5_approximate_many.fasta
+for i in $(seq 1 40)
+do
+	echo ">seq$i"
+	echo ${pattern:$((i % 7)):$((42 - i % 7 - (i * 5) % 13))}
+done > $manypatterns
+sequential=$outputfolder/tcs_fig_5_approximate_many.gaf
+echo "$efglocate --approximate $graph $manypatterns $sequential" >> $logfile
+$efglocate --approximate $graph $manypatterns $sequential >> $logfile 2>> $logfile
+
+# ordered output of the compute threads, byte-identical to the sequential one
+output=$outputfolder/tcs_fig_5_approximate_many-ordered.gaf
+echo "$efglocate --approximate --threads 3 --schedule-window 8 --ordered-output --ordered-output-window 4 $graph $manypatterns $output" >> $logfile
+$efglocate --approximate --threads 3 --schedule-window 8 --ordered-output --ordered-output-window 4 $graph $manypatterns $output >> $logfile 2>> $logfile
+cmp $output $sequential > /dev/null 2>/dev/null
+
+exitcode=$? ; if [ $exitcode -ne 0 ] || [ ! -s $output ] ; then
+	echo "Test failed for files $graph $manypatterns with --ordered-output!" | tee -a $logfile
+	exit 1
+fi
+
+# sharded output, the shards listed in the manifest having together the seeds of the unsharded output
+output=$outputfolder/tcs_fig_5_approximate_many-sharded.gaf
+echo "$efglocate --approximate --threads 3 --schedule-window 8 --task-bases 1 --sharded-output $graph $manypatterns $output" >> $logfile
+$efglocate --approximate --threads 3 --schedule-window 8 --task-bases 1 --sharded-output $graph $manypatterns $output >> $logfile 2>> $logfile
+shards=$(tail -n +2 $output | sed "s|^|$outputfolder/|")
+diff <(cat $shards | sort) <(sort $sequential) > /dev/null 2>/dev/null
+
+exitcode=$? ; if [ $exitcode -ne 0 ] || [ $(echo $shards | wc -w) -ne 3 ] ; then
+	echo "Test failed for files $graph $manypatterns with --sharded-output!" | tee -a $logfile
+	exit 1
+fi
+
+# work budget: with few LF steps, some of the seeds and the pattern in the
+# deferred file; with enough of them, all the seeds and no deferred pattern
+for budget in "10" "100000"
+do
+	output=$outputfolder/tcs_fig_5_approximate-budget.gaf
+	deferred=$outputfolder/tcs_fig_5_approximate-deferred.fasta
+	rm -f $output $deferred
+	echo "$efglocate --approximate --max-lf-steps $budget --deferred $deferred $graph $patterns $output" >> $logfile
+	$efglocate --approximate --max-lf-steps $budget --deferred $deferred $graph $patterns $output >> $logfile 2>> $logfile
+	if [ $budget -eq 10 ] ; then
+		[ -s $output ] && [ -z "$(comm -23 <(sort $output) <(sort $correct))" ] && ! diff $output $correct > /dev/null 2>/dev/null \
+			&& diff $deferred $patterns > /dev/null 2>/dev/null
+	else
+		diff $output $correct > /dev/null 2>/dev/null && [ ! -s $deferred ]
+	fi
+
+	exitcode=$? ; if [ $exitcode -ne 0 ] ; then
+		echo "Test failed for files $graph $patterns $correct with --max-lf-steps $budget!" | tee -a $logfile
+		exit 1
+	fi
+done